@@ -0,0 +1,78 @@
+#!/bin/bash
+
+# Builds the bridge throughput benchmark (zynq7_bench) with g++ and the
+# Accellera SystemC library, no HDL simulator nor QEMU is needed.
+#
+# The data width is a template parameter of the bridges, one binary is built
+# per width : bench/build/zynq7_bench_<width> (M_AXI_GP0 and S_AXI_HP0 both
+# use this width).
+#
+# usage : bench/build.sh [width ...]   (default : 32 64)
+#
+# SYSTEMC_HOME must point to the SystemC installation (SYSTEMC_LIBDIR defaults
+# to $SYSTEMC_HOME/lib-linux64), libsystemctlm-soc is the one of setup.sh
+
+cd "$(dirname "$0")/.."
+
+if [ -z ${SYSTEMC_HOME+x} ]
+then
+    echo 'could not find SystemC path $SYSTEMC_HOME'
+    exit 1
+fi
+
+if [ ! -d libsystemctlm-soc ]
+then
+    echo "[BENCH] libsystemctlm-soc not found, run setup.sh first"
+    exit 1
+fi
+
+SYSTEMC_LIBDIR=${SYSTEMC_LIBDIR:-$SYSTEMC_HOME/lib-linux64}
+WIDTHS=${@:-32 64}
+BUILD=bench/build
+SOC=libsystemctlm-soc
+SOC_COMMIT=$(git -C $SOC rev-parse --short HEAD)
+
+CXX=${CXX:-g++}
+CC=${CC:-gcc}
+CXXFLAGS="-std=c++11 -O2 -g -I$SYSTEMC_HOME/include -I$SOC/libremote-port -I$SOC -I$SOC/soc/xilinx/zynq -I$SOC/tlm-bridges"
+# The generics of zynq7_ps are provided by the benchmark (see zynq7_bench_generics.h)
+ZYNQ7_FLAGS="$CXXFLAGS -include bench/zynq7_bench_generics.h -Isrc_sc -Ibench -DZYNQ7_BENCH_SOC_COMMIT=\"$SOC_COMMIT\""
+
+set -e
+mkdir -p $BUILD/soc
+
+# The units are compiled in parallel, a failure of any of them stops the build
+PIDS=""
+spawn() { "$@" & PIDS="$PIDS $!"; }
+wait_all() { for pid in $PIDS; do wait $pid; done; PIDS=""; }
+
+# libsystemctlm-soc (same files as the simulation, see generate_sim_files.py)
+echo "[BENCH] Compiling libsystemctlm-soc ($SOC_COMMIT)"
+for src in libremote-port/safeio.c libremote-port/remote-port-proto.c libremote-port/remote-port-sk.c
+do
+    spawn $CC -O2 -g -c $SOC/$src -o $BUILD/soc/$(basename $src).o
+done
+for src in soc/xilinx/zynq/xilinx-zynq.cc libremote-port/remote-port-tlm.cc \
+           libremote-port/remote-port-tlm-memory-master.cc libremote-port/remote-port-tlm-memory-slave.cc \
+           libremote-port/remote-port-tlm-wires.cc
+do
+    spawn $CXX $CXXFLAGS -c $SOC/$src -o $BUILD/soc/$(basename $src).o
+done
+wait_all
+
+# zynq7_ps and the benchmark, for every data width
+for width in $WIDTHS
+do
+    echo "[BENCH] Compiling zynq7_bench_$width"
+    mkdir -p $BUILD/$width
+    WIDTH_FLAGS="-D__M_AXI_GP0_DATA_WIDTH__=$width -D__S_AXI_HP0_DATA_WIDTH__=$width"
+    for src in src_sc/zynq7_*.cc bench/zynq7_bench*.cc
+    do
+        spawn $CXX $ZYNQ7_FLAGS $WIDTH_FLAGS -c $src -o $BUILD/$width/$(basename $src).o
+    done
+    wait_all
+    $CXX -o $BUILD/zynq7_bench_$width $BUILD/$width/*.o $BUILD/soc/*.o \
+         -L$SYSTEMC_LIBDIR -Wl,-rpath,$SYSTEMC_LIBDIR -lsystemc -lpthread
+done
+
+echo "[BENCH] Done, see bench/run.sh and bench/timeline.sh"
@@ -0,0 +1,51 @@
+#!/bin/bash
+
+# Runs the bridge throughput benchmark over data widths, burst lengths,
+# outstanding depths and ports (M_AXI_GP0 : gp, S_AXI_HP0 : hp).
+#
+# Every run appends one JSON object (one line) to the output file with the
+# transactions per wall-clock second and the simulated time per wall-clock
+# second, along with the libsystemctlm-soc commit the benchmark was built
+# against. Keep the file of a run as the baseline before updating the commit
+# in setup.sh and compare the new results against it.
+#
+# usage : bench/run.sh [output file]   (default : bench/results.jsonl)
+#
+# The sweep can be narrowed with the environment variables below, extra
+# generics of zynq7_ps are given with BENCH_GENERICS (e.g., "-g QEMU_SYNC_QUANTUM_G=1000")
+
+cd "$(dirname "$0")/.."
+
+OUTPUT=${1:-bench/results.jsonl}
+WIDTHS=${WIDTHS:-32 64}
+PORTS=${PORTS:-gp hp}
+BURSTS=${BURSTS:-1 4 16}
+DEPTHS=${DEPTHS:-1 2 4 8}
+TRANSACTIONS=${TRANSACTIONS:-10000}
+
+for width in $WIDTHS
+do
+    if [ ! -x bench/build/zynq7_bench_$width ]
+    then
+        echo "[BENCH] bench/build/zynq7_bench_$width not found, run bench/build.sh first"
+        exit 1
+    fi
+done
+
+for width in $WIDTHS
+do
+    for port in $PORTS
+    do
+        for burst in $BURSTS
+        do
+            for depth in $DEPTHS
+            do
+                echo "[BENCH] width $width port $port burst $burst depth $depth"
+                bench/build/zynq7_bench_$width --port $port --burst $burst --depth $depth \
+                    --transactions $TRANSACTIONS --output $OUTPUT $BENCH_GENERICS > /dev/null || exit 1
+            done
+        done
+    done
+done
+
+echo "[BENCH] Results in $OUTPUT"
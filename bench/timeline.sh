@@ -0,0 +1,44 @@
+#!/bin/bash
+
+# Runs the bridge benchmark once with a timeline (see src_sc/zynq7_timeline.h)
+# and checks the syncs of the peer (the QEMU stand-in) show in it, with the
+# host time the model waited for the peer.
+#
+# usage : bench/timeline.sh [timeline file]   (default : bench/timeline.json)
+#
+# The run can be changed with the environment variables below, extra
+# generics of zynq7_ps are given with BENCH_GENERICS (e.g., "-g QEMU_SYNC_QUANTUM_G=1000")
+
+cd "$(dirname "$0")/.."
+
+TIMELINE=${1:-bench/timeline.json}
+WIDTH=${WIDTH:-32}
+PORT=${PORT:-gp}
+TRANSACTIONS=${TRANSACTIONS:-1000}
+
+if [ ! -x bench/build/zynq7_bench_$WIDTH ]
+then
+    echo "[BENCH] bench/build/zynq7_bench_$WIDTH not found, run bench/build.sh first"
+    exit 1
+fi
+
+rm -f $TIMELINE
+echo "[BENCH] width $WIDTH port $PORT timeline $TIMELINE"
+bench/build/zynq7_bench_$WIDTH --port $PORT --transactions $TRANSACTIONS --output /dev/null \
+    -g TIMELINE_FILE_G=$TIMELINE $BENCH_GENERICS > /dev/null || exit 1
+
+# A timeline cut short lacks the closing bracket
+python3 - $TIMELINE <<'PYTHON' || exit 1
+import sys
+import json
+
+contents = open(sys.argv[1]).read().rstrip()
+if not contents.endswith("]"):
+    contents = contents.rstrip(",") + "]"
+syncs = [e for e in json.loads(contents) if (e["ph"] == "i") and (e["name"] == "sync")]
+if not syncs:
+    print("[BENCH] No sync in the timeline")
+    sys.exit(1)
+wait = sum(e["args"].get("wait_us", 0) for e in syncs)
+print("[BENCH] %d syncs, waited %.3f ms for the peer" % (len(syncs), wait / 1e3))
+PYTHON
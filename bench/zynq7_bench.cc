@@ -0,0 +1,342 @@
+/*
+ * Bridge throughput benchmark for Zynq Cosim
+ *
+ * zynq7_ps is simulated without QEMU nor HDL simulator : a remote port peer
+ * (zynq7_bench_peer) stands in for QEMU and synthetic AXI traffic is
+ * generated on one port, either by the PS (M_AXI_GP0, answered by a memory
+ * behind an AXI to TLM bridge) or by the PL (S_AXI_HP0, a TLM to AXI bridge
+ * driven by initiator threads).
+ *
+ * The result of a run is a JSON object (one line), see run.sh for a sweep.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_ps.h"
+#include "zynq7_bench_axi.h"
+#include "zynq7_bench_peer.h"
+#include "zynq7_bench_traffic.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace sc_core;
+using namespace sc_dt;
+using namespace std;
+
+// Version of libsystemctlm-soc the benchmark is built against (see build.sh)
+#ifndef ZYNQ7_BENCH_SOC_COMMIT
+#define ZYNQ7_BENCH_SOC_COMMIT "unknown"
+#endif
+
+//////////////
+// Generics //
+//////////////
+
+static map<string, string> generics;
+
+bool zynq7_bench_set_generic(const string &assignment)
+{
+    size_t pos = assignment.find('=');
+    if ((pos == string::npos) || (pos == 0)) {
+        return false;
+    }
+    generics[assignment.substr(0, pos)] = assignment.substr(pos + 1);
+    return true;
+}
+
+int zynq7_bench_generic_int(const char *name, int default_value)
+{
+    map<string, string>::const_iterator it = generics.find(name);
+    return (it == generics.end()) ? default_value : strtol(it->second.c_str(), NULL, 0);
+}
+
+string zynq7_bench_generic_string(const char *name, const char *default_value)
+{
+    map<string, string>::const_iterator it = generics.find(name);
+    return (it == generics.end()) ? string(default_value) : it->second;
+}
+
+///////////
+// Bench //
+///////////
+
+struct zynq7_bench_config {
+    bool ps_is_master;         // M_AXI_GP0 (true) or S_AXI_HP0 (false)
+    unsigned int burst_len;    // Beats per transaction
+    unsigned int depth;        // Transactions in flight
+    uint64_t transactions;
+    int dev;                   // Remote port device of M_AXI_GP0 in the Zynq model
+    string socket_path;
+    string output;             // Results are appended to this file (stdout if empty)
+};
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+SC_MODULE(zynq7_bench)
+{
+    typedef zynq7_ps::m_axi_gp0_port_t gp_port_t;
+    typedef zynq7_ps::s_axi_hp0_port_t hp_port_t;
+
+    zynq7_bench_config cfg;
+    zynq7_bench_peer *peer;
+    zynq7_ps *ps;
+
+    // PS signals
+    sc_signal<bool> fclk_clk[4];
+    sc_signal<bool> fclk_reset_n[4];
+    sc_signal<bool> rst_o;
+    sc_signal<sc_bv<16> > irq_f2p;
+
+#define ZYNQ7_BENCH_DECLARE_PORT_SIGNALS(PORT, port, member, bridge, KIND, INDEX) \
+    zynq7_bench_axi_signals<zynq7_ps::port##_port_t> port##_signals;
+    ZYNQ7_PS_AXI_PORTS(ZYNQ7_BENCH_DECLARE_PORT_SIGNALS)
+#undef ZYNQ7_BENCH_DECLARE_PORT_SIGNALS
+
+    // Traffic (only one side is used)
+    zynq7_bench_bridge<gp_port_t>::type *gp_bridge;
+    zynq7_bench_memory *gp_memory;
+    zynq7_bench_bridge<hp_port_t>::type *hp_bridge;
+    zynq7_bench_initiator *hp_initiator;
+
+    // Results
+    zynq7_port_monitor *monitor;
+    uint64_t transactions;
+    uint64_t bytes;
+    uint64_t errors;
+    double wall_time;
+    sc_time sim_time;
+
+    SC_HAS_PROCESS(zynq7_bench);
+    zynq7_bench(sc_module_name name, const zynq7_bench_config &config) :
+        sc_module(name),
+        cfg(config),
+        gp_bridge(NULL),
+        gp_memory(NULL),
+        hp_bridge(NULL),
+        hp_initiator(NULL),
+        monitor(NULL),
+        transactions(0),
+        bytes(0),
+        errors(0),
+        wall_time(0)
+    {
+        const int width_bytes = (cfg.ps_is_master ? gp_port_t::data_width : hp_port_t::data_width) / 8;
+
+        // Stand-in for QEMU, listening before the Zynq model connects
+        zynq7_bench_peer::config peer_cfg;
+        peer_cfg.quantum_ns = zynq7_bench_generic_int("QEMU_SYNC_QUANTUM_G", 10000);
+        peer_cfg.dev = cfg.dev;
+        peer_cfg.addr = 0;
+        peer_cfg.burst_bytes = cfg.burst_len * width_bytes;
+        peer_cfg.width_bytes = width_bytes;
+        peer_cfg.depth = cfg.depth;
+        peer_cfg.transactions = cfg.ps_is_master ? cfg.transactions : 0;
+        peer = new zynq7_bench_peer(cfg.socket_path, peer_cfg);
+
+        zynq7_bench_set_generic(string("QEMU_PATH_TO_SOCKET_G=") + peer->descr());
+        zynq7_bench_set_generic(cfg.ps_is_master ? "M_AXI_GP0_ENABLE_G=1" : "S_AXI_HP0_ENABLE_G=1");
+        ps = new zynq7_ps("zynq7_ps");
+
+        ps->fclk_clk0(fclk_clk[0]);
+        ps->fclk_clk1(fclk_clk[1]);
+        ps->fclk_clk2(fclk_clk[2]);
+        ps->fclk_clk3(fclk_clk[3]);
+        ps->fclk_reset0_n(fclk_reset_n[0]);
+        ps->fclk_reset1_n(fclk_reset_n[1]);
+        ps->fclk_reset2_n(fclk_reset_n[2]);
+        ps->fclk_reset3_n(fclk_reset_n[3]);
+        ps->rst_o(rst_o);
+        ps->irq_f2p(irq_f2p);
+
+        // Every port is bound, the traffic runs on FCLK0
+#define ZYNQ7_BENCH_BIND_PORT(PORT, port, member, bridge, KIND, INDEX) \
+        ZYNQ7_BENCH_BIND_PS_AXI(ps, port, port##_signals, fclk_clk[0], fclk_reset_n[0]);
+        ZYNQ7_PS_AXI_PORTS(ZYNQ7_BENCH_BIND_PORT)
+#undef ZYNQ7_BENCH_BIND_PORT
+
+        if (cfg.ps_is_master) {
+            gp_bridge = new zynq7_bench_bridge<gp_port_t>::type("gp_bridge");
+            m_axi_gp0_signals.connect(gp_bridge, fclk_clk[0], fclk_reset_n[0]);
+            gp_memory = new zynq7_bench_memory("gp_memory", 0x10000);
+            gp_bridge->socket.bind(gp_memory->socket);
+        } else {
+            hp_bridge = new zynq7_bench_bridge<hp_port_t>::type("hp_bridge");
+            s_axi_hp0_signals.connect(hp_bridge, fclk_clk[0], fclk_reset_n[0]);
+            hp_initiator = new zynq7_bench_initiator("hp_initiator", 0,
+                                                     cfg.burst_len * width_bytes, cfg.depth);
+            hp_initiator->socket.bind(hp_bridge->tgt_socket);
+        }
+
+        SC_THREAD(control);
+    }
+
+    uint64_t monitor_transactions(void) const
+    {
+        return monitor->reads() + monitor->writes();
+    }
+
+    void control(void)
+    {
+        const string port_name = cfg.ps_is_master ? gp_port_t::name() : hp_port_t::name();
+
+        for (size_t i = 0; i < ps->port_monitors.size(); ++i) {
+            if (ps->port_monitors[i]->port_name() == port_name) {
+                monitor = ps->port_monitors[i];
+            }
+        }
+        assert(monitor);
+
+        // The measure starts out of reset
+        if (!fclk_reset_n[0].read()) {
+            wait(fclk_reset_n[0].posedge_event());
+        }
+
+        const uint64_t base = monitor_transactions();
+        const uint64_t base_bytes = monitor->read_bytes() + monitor->write_bytes();
+        const uint64_t base_errors = monitor->errors();
+        const sc_time sim_start = sc_time_stamp();
+        const double wall_start = wall_seconds();
+
+        if (cfg.ps_is_master) {
+            peer->start();
+        } else {
+            hp_initiator->start(cfg.transactions);
+        }
+
+        while (monitor_transactions() - base < cfg.transactions) {
+            wait(64 * ps->fclk_gen->period(0));
+        }
+
+        wall_time = wall_seconds() - wall_start;
+        sim_time = sc_time_stamp() - sim_start;
+        transactions = monitor_transactions() - base;
+        bytes = monitor->read_bytes() + monitor->write_bytes() - base_bytes;
+        errors = monitor->errors() - base_errors;
+        sc_stop();
+    }
+
+    void report(ostream &os) const
+    {
+        const double sim_s = sim_time.to_seconds();
+
+        os << "{\"soc_commit\": \"" << ZYNQ7_BENCH_SOC_COMMIT << "\""
+           << ", \"port\": \"" << (cfg.ps_is_master ? gp_port_t::name() : hp_port_t::name()) << "\""
+           << ", \"data_width\": " << (cfg.ps_is_master ? gp_port_t::data_width : hp_port_t::data_width)
+           << ", \"burst_len\": " << cfg.burst_len
+           << ", \"depth\": " << cfg.depth
+           << ", \"transactions\": " << transactions
+           << ", \"bytes\": " << bytes
+           << ", \"errors\": " << errors
+           << ", \"syncs\": " << peer->syncs()
+           << ", \"wall_s\": " << wall_time
+           << ", \"sim_s\": " << sim_s
+           << ", \"transactions_per_s\": " << (wall_time > 0 ? transactions / wall_time : 0)
+           << ", \"sim_per_wall\": " << (wall_time > 0 ? sim_s / wall_time : 0)
+           << "}" << endl;
+    }
+};
+
+static void usage(const char *prog)
+{
+    cerr << "usage : " << prog << " [options]" << endl
+         << "  --port gp|hp        M_AXI_GP0 (PS is the master) or S_AXI_HP0 (default gp)" << endl
+         << "  --burst N           beats per transaction (default 1)" << endl
+         << "  --depth N           transactions in flight (default 1)" << endl
+         << "  --transactions N    transactions measured (default 10000)" << endl
+         << "  --dev N             remote port device of M_AXI_GP0 in the Zynq model (default 9)" << endl
+         << "  --socket PATH       socket of the stand-in peer (default /tmp/zynq7_bench.<pid>)" << endl
+         << "  --output FILE       append the result to FILE (default stdout)" << endl
+         << "  -g NAME=VALUE       overrides a generic of zynq7_ps" << endl;
+}
+
+int sc_main(int argc, char *argv[])
+{
+    zynq7_bench_config cfg;
+    ostringstream oss;
+
+    oss << "/tmp/zynq7_bench." << getpid();
+    cfg.ps_is_master = true;
+    cfg.burst_len = 1;
+    cfg.depth = 1;
+    cfg.transactions = 10000;
+    cfg.dev = 9;
+    cfg.socket_path = oss.str();
+
+    // Realistic clock by default (the generic defaults favor a slow clock)
+    zynq7_bench_set_generic("FCLK_CLK0_PERIOD_IN_NS_G=10");
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (arg == "--port" && has_value) {
+            cfg.ps_is_master = (string(argv[++i]) != "hp");
+        } else if (arg == "--burst" && has_value) {
+            cfg.burst_len = strtoul(argv[++i], NULL, 0);
+        } else if (arg == "--depth" && has_value) {
+            cfg.depth = strtoul(argv[++i], NULL, 0);
+        } else if (arg == "--transactions" && has_value) {
+            cfg.transactions = strtoull(argv[++i], NULL, 0);
+        } else if (arg == "--dev" && has_value) {
+            cfg.dev = strtol(argv[++i], NULL, 0);
+        } else if (arg == "--socket" && has_value) {
+            cfg.socket_path = argv[++i];
+        } else if (arg == "--output" && has_value) {
+            cfg.output = argv[++i];
+        } else if (arg == "-g" && has_value && zynq7_bench_set_generic(argv[i + 1])) {
+            ++i;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if ((cfg.burst_len == 0) || (cfg.depth == 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    zynq7_bench bench("bench", cfg);
+    sc_start();
+
+    if (cfg.output.empty()) {
+        bench.report(cout);
+    } else {
+        ofstream ofs(cfg.output.c_str(), ios::app);
+        bench.report(ofs);
+    }
+
+    // The peer and the model are still connected, the process just exits
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * AXI signals for the Zynq Cosim benchmark
+ *
+ * Every AXI port of zynq7_ps has to be bound outside of the HDL simulator,
+ * a set of signals is declared for each port of the table (see
+ * zynq7_ps_ports.h) and connects the PS to the bridges of the benchmark.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_BENCH_AXI_H__
+#define __ZYNQ7_BENCH_AXI_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_ps_ports.h"
+
+// Signals of a port, the clock and reset are common and bound separately
+// X(ARG, signal, type), PORT is the descriptor of the port (zynq7_axi_port)
+#define ZYNQ7_BENCH_AXI_SIGNALS(X, ARG, PORT)                                 \
+    /* Write address channel */                                                \
+    X(ARG, awvalid,  bool)                                                     \
+    X(ARG, awready,  bool)                                                     \
+    X(ARG, awaddr,   sc_dt::sc_bv<PORT::addr_width>)                           \
+    X(ARG, awprot,   sc_dt::sc_bv<3>)                                          \
+    X(ARG, awregion, sc_dt::sc_bv<4>)                                          \
+    X(ARG, awqos,    sc_dt::sc_bv<4>)                                          \
+    X(ARG, awcache,  sc_dt::sc_bv<4>)                                          \
+    X(ARG, awburst,  sc_dt::sc_bv<2>)                                          \
+    X(ARG, awsize,   sc_dt::sc_bv<3>)                                          \
+    X(ARG, awlen,    sc_dt::sc_bv<PORT::axlen_width>)                          \
+    X(ARG, awid,     sc_dt::sc_bv<PORT::id_width>)                             \
+    X(ARG, awlock,   sc_dt::sc_bv<PORT::axlock_width>)                         \
+    /* Write data channel */                                                   \
+    X(ARG, wvalid,   bool)                                                     \
+    X(ARG, wready,   bool)                                                     \
+    X(ARG, wdata,    sc_dt::sc_bv<PORT::data_width>)                           \
+    X(ARG, wstrb,    sc_dt::sc_bv<PORT::data_width / 8>)                       \
+    X(ARG, wlast,    bool)                                                     \
+    /* Write response channel */                                               \
+    X(ARG, bvalid,   bool)                                                     \
+    X(ARG, bready,   bool)                                                     \
+    X(ARG, bresp,    sc_dt::sc_bv<2>)                                          \
+    X(ARG, bid,      sc_dt::sc_bv<PORT::id_width>)                             \
+    /* Read address channel */                                                 \
+    X(ARG, arvalid,  bool)                                                     \
+    X(ARG, arready,  bool)                                                     \
+    X(ARG, araddr,   sc_dt::sc_bv<PORT::addr_width>)                           \
+    X(ARG, arprot,   sc_dt::sc_bv<3>)                                          \
+    X(ARG, arregion, sc_dt::sc_bv<4>)                                          \
+    X(ARG, arqos,    sc_dt::sc_bv<4>)                                          \
+    X(ARG, arcache,  sc_dt::sc_bv<4>)                                          \
+    X(ARG, arburst,  sc_dt::sc_bv<2>)                                          \
+    X(ARG, arsize,   sc_dt::sc_bv<3>)                                          \
+    X(ARG, arlen,    sc_dt::sc_bv<PORT::axlen_width>)                          \
+    X(ARG, arid,     sc_dt::sc_bv<PORT::id_width>)                             \
+    X(ARG, arlock,   sc_dt::sc_bv<PORT::axlock_width>)                         \
+    /* Read data channel */                                                    \
+    X(ARG, rvalid,   bool)                                                     \
+    X(ARG, rready,   bool)                                                     \
+    X(ARG, rdata,    sc_dt::sc_bv<PORT::data_width>)                           \
+    X(ARG, rresp,    sc_dt::sc_bv<2>)                                          \
+    X(ARG, rid,      sc_dt::sc_bv<PORT::id_width>)                             \
+    X(ARG, rlast,    bool)
+
+template <class PORT>
+struct zynq7_bench_axi_signals
+{
+#define ZYNQ7_BENCH_DECLARE_SIGNAL(ARG, signal, type) \
+    sc_core::sc_signal<type> signal;
+    ZYNQ7_BENCH_AXI_SIGNALS(ZYNQ7_BENCH_DECLARE_SIGNAL, unused, PORT)
+#undef ZYNQ7_BENCH_DECLARE_SIGNAL
+
+    // Binds a bridge (tlm2axi or axi2tlm) of the benchmark to the signals
+    template <class BRIDGE>
+    void connect(BRIDGE *bridge, sc_core::sc_signal<bool> &clk,
+                 sc_core::sc_signal<bool> &resetn)
+    {
+        bridge->clk(clk);
+        bridge->resetn(resetn);
+#define ZYNQ7_BENCH_BIND_SIGNAL(ARG, signal, type) \
+        ARG->signal(signal);
+        ZYNQ7_BENCH_AXI_SIGNALS(ZYNQ7_BENCH_BIND_SIGNAL, bridge, PORT)
+#undef ZYNQ7_BENCH_BIND_SIGNAL
+    }
+};
+
+// Bridge of the benchmark facing a port of the PS, the opposite of the bridge
+// of the PS : an AXI to TLM bridge answers an M_AXI_GP port and a TLM to AXI
+// bridge drives an S_AXI port
+template <class PORT>
+struct zynq7_bench_bridge {
+    typedef typename zynq7_axi_bridge_select<!PORT::ps_is_master, PORT::addr_width,
+                                             PORT::data_width, PORT::id_width,
+                                             PORT::axlen_width, PORT::axlock_width,
+                                             PORT::awuser_width, PORT::aruser_width>::type type;
+};
+
+// Binds the ports of zynq7_ps named port_* (e.g., s_axi_hp0_awvalid) to a
+// set of signals (zynq7_bench_axi_signals of the same port)
+#define ZYNQ7_BENCH_BIND_PS_SIGNAL(port, signal, type) \
+        bench_ps->port##_##signal(bench_signals.signal);
+#define ZYNQ7_BENCH_BIND_PS_AXI(PS, port, SIGNALS, CLK, RESETN)               \
+    do {                                                                       \
+        zynq7_ps *bench_ps = PS;                                               \
+        zynq7_bench_axi_signals<zynq7_ps::port##_port_t> &bench_signals =      \
+            SIGNALS;                                                           \
+        bench_ps->port##_aclk(CLK);                                            \
+        bench_ps->port##_aresetn(RESETN);                                      \
+        ZYNQ7_BENCH_AXI_SIGNALS(ZYNQ7_BENCH_BIND_PS_SIGNAL, port,              \
+                                zynq7_ps::port##_port_t)                       \
+    } while (0)
+
+#endif /* __ZYNQ7_BENCH_AXI_H__ */
@@ -0,0 +1,64 @@
+/*
+ * SystemC generics for the Zynq Cosim benchmark
+ *
+ * The generics of zynq7_ps (SC_GENERIC_INT, SC_GENERIC_STRING) are provided
+ * by the Questa SystemC compiler. The benchmark is built with g++ and the
+ * Accellera SystemC library, this header is force-included (-include) in
+ * every unit and implements the generics as plain members initialized with
+ * their default value unless overridden on the command line (-g NAME=VALUE,
+ * as with vsim).
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_BENCH_GENERICS_H__
+#define __ZYNQ7_BENCH_GENERICS_H__
+
+#include <string>
+
+#ifndef SC_GENERIC_INT
+
+// Value of a generic, the default is returned when it is not overridden
+int zynq7_bench_generic_int(const char *name, int default_value);
+std::string zynq7_bench_generic_string(const char *name, const char *default_value);
+
+// Overrides a generic (NAME=VALUE), returns false if the argument is malformed
+bool zynq7_bench_set_generic(const std::string &assignment);
+
+#define SC_GENERIC_INT(name, default_value)                                    \
+    static int name##_default(void) { return default_value; }                  \
+    int name
+#define SC_INIT_GENERIC_INT(name)                                              \
+    name(zynq7_bench_generic_int(#name, name##_default()))
+
+#define SC_GENERIC_STRING(name, default_value)                                 \
+    static const char *name##_default(void) { return default_value; }          \
+    std::string name
+#define SC_INIT_GENERIC_STRING(name)                                           \
+    name(zynq7_bench_generic_string(#name, name##_default()))
+
+// The module is not exported to an HDL simulator
+#define SC_MODULE_EXPORT(name)
+
+#endif /* SC_GENERIC_INT */
+
+#endif /* __ZYNQ7_BENCH_GENERICS_H__ */
@@ -0,0 +1,294 @@
+/*
+ * Remote port peer for the Zynq Cosim benchmark
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_bench_peer.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <endian.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <iostream>
+
+using namespace std;
+
+// Remote port packets (see libremote-port/remote-port-proto.h), all fields
+// are big endian. The peer does not announce any capability so the model
+// uses the basic bus access layout (data right after the bus access fields)
+#define RP_HDR_SIZE             20
+#define RP_CMD_HELLO            1
+#define RP_CMD_READ             3
+#define RP_CMD_WRITE            4
+#define RP_CMD_INTERRUPT        5
+#define RP_CMD_SYNC             6
+#define RP_PKT_FLAGS_RESPONSE   (1 << 1)
+#define RP_PKT_FLAGS_POSTED     (1 << 2)
+#define RP_VERSION_MAJOR        4
+#define RP_VERSION_MINOR        3
+
+// Bus access : timestamp, attributes, addr (64-bit), len, width,
+// stream_width (32-bit) and master_id (16-bit)
+#define RP_BUSACCESS_SIZE       38
+#define RP_BUSACCESS_LEN        24
+#define RP_SYNC_SIZE            8
+
+// Accesses of the peer wrap in a window of this size
+#define PEER_WINDOW_SIZE        0x10000
+
+static bool read_full(int fd, void *buf, size_t len)
+{
+    uint8_t *p = (uint8_t *) buf;
+    while (len) {
+        ssize_t r = read(fd, p, len);
+        if (r <= 0) {
+            return false;
+        }
+        p += r;
+        len -= r;
+    }
+    return true;
+}
+
+static bool write_full(int fd, const void *buf, size_t len)
+{
+    const uint8_t *p = (const uint8_t *) buf;
+    while (len) {
+        ssize_t r = write(fd, p, len);
+        if (r <= 0) {
+            return false;
+        }
+        p += r;
+        len -= r;
+    }
+    return true;
+}
+
+static void put_be16(uint8_t *p, uint16_t v) { v = htobe16(v); memcpy(p, &v, sizeof(v)); }
+static void put_be32(uint8_t *p, uint32_t v) { v = htobe32(v); memcpy(p, &v, sizeof(v)); }
+static void put_be64(uint8_t *p, uint64_t v) { v = htobe64(v); memcpy(p, &v, sizeof(v)); }
+static uint32_t get_be32(const uint8_t *p) { uint32_t v; memcpy(&v, p, sizeof(v)); return be32toh(v); }
+static uint64_t get_be64(const uint8_t *p) { uint64_t v; memcpy(&v, p, sizeof(v)); return be64toh(v); }
+
+zynq7_bench_peer::zynq7_bench_peer(const string &path, const config &cfg) :
+    m_cfg(cfg),
+    m_path(path),
+    m_descr("unix:" + path),
+    m_listen_fd(-1),
+    m_fd(-1),
+    m_time_ns(0),
+    m_next_id(0),
+    m_data(cfg.burst_bytes),
+    m_started(false),
+    m_syncs(0),
+    m_served(0),
+    m_issued(0)
+{
+    struct sockaddr_un addr;
+
+    for (size_t i = 0; i < m_data.size(); ++i) {
+        m_data[i] = (uint8_t) i;
+    }
+
+    // Listen before the model is created so it can connect right away
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, m_path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(m_path.c_str());
+    m_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ((m_listen_fd < 0) ||
+        (bind(m_listen_fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) ||
+        (listen(m_listen_fd, 1) < 0)) {
+        perror(m_path.c_str());
+        for(;;);
+    }
+
+    pthread_create(&m_thread, NULL, peer_main, this);
+}
+
+zynq7_bench_peer::~zynq7_bench_peer()
+{
+    unlink(m_path.c_str());
+}
+
+void *zynq7_bench_peer::peer_main(void *arg)
+{
+    zynq7_bench_peer *peer = (zynq7_bench_peer *) arg;
+
+    peer->m_fd = accept(peer->m_listen_fd, NULL, NULL);
+    if (peer->m_fd < 0) {
+        perror("Benchmark peer : accept()");
+        return NULL;
+    }
+    close(peer->m_listen_fd);
+    unlink(peer->m_path.c_str());
+
+    peer->run();
+
+    cerr << "Benchmark peer : connection closed" << endl;
+    return NULL;
+}
+
+void zynq7_bench_peer::send(uint32_t cmd, uint32_t id, uint32_t flags, uint32_t dev,
+                            const vector<uint8_t> &payload)
+{
+    vector<uint8_t> pkt(RP_HDR_SIZE + payload.size());
+
+    put_be32(&pkt[0], cmd);
+    put_be32(&pkt[4], payload.size());
+    put_be32(&pkt[8], id);
+    put_be32(&pkt[12], flags);
+    put_be32(&pkt[16], dev);
+    if (payload.size()) {
+        memcpy(&pkt[RP_HDR_SIZE], &payload[0], payload.size());
+    }
+    write_full(m_fd, &pkt[0], pkt.size());
+}
+
+bool zynq7_bench_peer::receive(vector<uint8_t> &pkt)
+{
+    pkt.resize(RP_HDR_SIZE);
+    if (!read_full(m_fd, &pkt[0], RP_HDR_SIZE)) {
+        return false;
+    }
+    uint32_t len = get_be32(&pkt[4]);
+    pkt.resize(RP_HDR_SIZE + len);
+    return (len == 0) || read_full(m_fd, &pkt[RP_HDR_SIZE], len);
+}
+
+void zynq7_bench_peer::hello(void)
+{
+    // Version and an empty list of capabilities
+    vector<uint8_t> payload(12, 0);
+
+    put_be16(&payload[0], RP_VERSION_MAJOR);
+    put_be16(&payload[2], RP_VERSION_MINOR);
+    put_be32(&payload[4], RP_HDR_SIZE + payload.size());
+    send(RP_CMD_HELLO, m_next_id++, 0, 0, payload);
+}
+
+void zynq7_bench_peer::issue_access(bool write, uint64_t addr)
+{
+    vector<uint8_t> payload(RP_BUSACCESS_SIZE + (write ? m_cfg.burst_bytes : 0), 0);
+
+    put_be64(&payload[0], m_time_ns);
+    put_be64(&payload[16], addr);
+    put_be32(&payload[RP_BUSACCESS_LEN], m_cfg.burst_bytes);
+    put_be32(&payload[RP_BUSACCESS_LEN + 4], m_cfg.width_bytes);
+    put_be32(&payload[RP_BUSACCESS_LEN + 8], m_cfg.burst_bytes);
+    if (write) {
+        memcpy(&payload[RP_BUSACCESS_SIZE], &m_data[0], m_cfg.burst_bytes);
+    }
+    send(write ? RP_CMD_WRITE : RP_CMD_READ, m_next_id++, 0, m_cfg.dev, payload);
+    __atomic_add_fetch(&m_issued, 1, __ATOMIC_RELAXED);
+}
+
+bool zynq7_bench_peer::handle(vector<uint8_t> &pkt)
+{
+    uint32_t cmd = get_be32(&pkt[0]);
+    uint32_t id = get_be32(&pkt[8]);
+    uint32_t flags = get_be32(&pkt[12]);
+    uint32_t dev = get_be32(&pkt[16]);
+    vector<uint8_t> payload(pkt.begin() + RP_HDR_SIZE, pkt.end());
+
+    if (flags & RP_PKT_FLAGS_RESPONSE) {
+        // The time of the model may be ahead (e.g., the burst took cycles)
+        if ((cmd == RP_CMD_SYNC || cmd == RP_CMD_READ || cmd == RP_CMD_WRITE) &&
+            payload.size() >= sizeof(uint64_t)) {
+            uint64_t ts = get_be64(&payload[0]);
+            if (ts > m_time_ns) {
+                m_time_ns = ts;
+            }
+        }
+        return true;
+    }
+
+    switch (cmd) {
+    case RP_CMD_READ:
+        // Ideal memory, the response has the timestamp of the request
+        if (payload.size() >= RP_BUSACCESS_SIZE) {
+            uint32_t len = get_be32(&payload[RP_BUSACCESS_LEN]);
+            payload.resize(RP_BUSACCESS_SIZE);
+            payload.resize(RP_BUSACCESS_SIZE + len, 0);
+        }
+        break;
+    case RP_CMD_WRITE:
+        payload.resize(RP_BUSACCESS_SIZE);
+        break;
+    case RP_CMD_INTERRUPT:
+    case RP_CMD_SYNC:
+        break;
+    default:
+        // Hello (no capabilities expected) and others need no response
+        return false;
+    }
+
+    if (!(flags & RP_PKT_FLAGS_POSTED)) {
+        send(cmd, id, RP_PKT_FLAGS_RESPONSE, dev, payload);
+    }
+    __atomic_add_fetch(&m_served, 1, __ATOMIC_RELAXED);
+    return false;
+}
+
+void zynq7_bench_peer::run(void)
+{
+    vector<uint8_t> pkt;
+    vector<uint8_t> sync(RP_SYNC_SIZE);
+    uint64_t issued = 0;
+
+    hello();
+
+    for (;;) {
+        unsigned int pending = 0;
+
+        // A batch of accesses (PS is the master)
+        if (__atomic_load_n(&m_started, __ATOMIC_ACQUIRE)) {
+            for (unsigned int i = 0; i < m_cfg.depth && issued < m_cfg.transactions; ++i) {
+                uint64_t offset = (issued * m_cfg.burst_bytes) % PEER_WINDOW_SIZE;
+                issue_access((issued & 1) == 0, m_cfg.addr + offset);
+                issued++;
+                pending++;
+            }
+        }
+
+        // Let the simulation run for a quantum, as QEMU does
+        m_time_ns += m_cfg.quantum_ns;
+        put_be64(&sync[0], m_time_ns);
+        send(RP_CMD_SYNC, m_next_id++, 0, 0, sync);
+        __atomic_add_fetch(&m_syncs, 1, __ATOMIC_RELAXED);
+        pending++;
+
+        // Serve the model until everything is answered
+        while (pending) {
+            if (!receive(pkt)) {
+                return;
+            }
+            if (handle(pkt)) {
+                pending--;
+            }
+        }
+    }
+}
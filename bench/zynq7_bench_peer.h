@@ -0,0 +1,96 @@
+/*
+ * Remote port peer for the Zynq Cosim benchmark
+ *
+ * Stands in for QEMU : the Zynq model connects to the peer as it would to
+ * QEMU. The peer advances the time of the simulation with sync packets,
+ * answers the accesses of the PL (S_AXI ports) and may issue accesses to
+ * a remote port device of the model (M_AXI_GP ports).
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_BENCH_PEER_H__
+#define __ZYNQ7_BENCH_PEER_H__
+
+#include <stdint.h>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+class zynq7_bench_peer
+{
+public:
+    struct config {
+        uint64_t quantum_ns;   // Time advanced by each sync
+        // Accesses issued by the peer (M_AXI_GP), none when transactions is 0
+        int dev;               // Remote port device of the port in the model
+        uint64_t addr;         // Base address of the accesses
+        uint32_t burst_bytes;  // Bytes per access
+        uint32_t width_bytes;  // Data width of the port
+        unsigned int depth;    // Accesses sent before waiting for the responses
+        uint64_t transactions; // Total number of accesses (writes and reads alternate)
+    };
+
+    zynq7_bench_peer(const std::string &path, const config &cfg);
+    ~zynq7_bench_peer();
+
+    // Descriptor the Zynq model should connect to
+    const char *descr(void) const { return m_descr.c_str(); }
+
+    // The accesses are issued once started (e.g., after the reset)
+    void start(void) { __atomic_store_n(&m_started, true, __ATOMIC_RELEASE); }
+
+    // Statistics
+    uint64_t syncs(void) const { return __atomic_load_n(&m_syncs, __ATOMIC_RELAXED); }
+    uint64_t requests_served(void) const { return __atomic_load_n(&m_served, __ATOMIC_RELAXED); }
+    uint64_t requests_issued(void) const { return __atomic_load_n(&m_issued, __ATOMIC_RELAXED); }
+
+private:
+    static void *peer_main(void *arg);
+    void run(void);
+
+    void hello(void);
+    void send(uint32_t cmd, uint32_t id, uint32_t flags, uint32_t dev,
+              const std::vector<uint8_t> &payload);
+    bool receive(std::vector<uint8_t> &pkt);
+    // Handles a packet from the model, returns true if it is a response
+    bool handle(std::vector<uint8_t> &pkt);
+    void issue_access(bool write, uint64_t addr);
+
+    config m_cfg;
+    std::string m_path;
+    std::string m_descr;
+    int m_listen_fd;
+    int m_fd;
+    pthread_t m_thread;
+
+    uint64_t m_time_ns;
+    uint32_t m_next_id;
+    std::vector<uint8_t> m_data;
+
+    bool m_started;
+    uint64_t m_syncs;
+    uint64_t m_served;
+    uint64_t m_issued;
+};
+
+#endif /* __ZYNQ7_BENCH_PEER_H__ */
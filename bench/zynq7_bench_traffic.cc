@@ -0,0 +1,115 @@
+/*
+ * Synthetic AXI traffic for the Zynq Cosim benchmark
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_bench_traffic.h"
+
+#include <string.h>
+
+using namespace sc_core;
+using namespace std;
+
+// Accesses of the initiator wrap in a window of this size
+#define INITIATOR_WINDOW_SIZE 0x10000
+
+zynq7_bench_memory::zynq7_bench_memory(sc_module_name name, size_t size,
+                                       const sc_time &latency) :
+    sc_module(name),
+    socket("socket"),
+    m_mem(size, 0),
+    m_latency(latency)
+{
+    socket.register_b_transport(this, &zynq7_bench_memory::b_transport);
+}
+
+void zynq7_bench_memory::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    uint64_t offset = trans.get_address() % m_mem.size();
+    unsigned int len = trans.get_data_length();
+
+    if (offset + len > m_mem.size()) {
+        trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+        return;
+    }
+
+    if (trans.is_read()) {
+        memcpy(trans.get_data_ptr(), &m_mem[offset], len);
+    } else if (trans.is_write()) {
+        memcpy(&m_mem[offset], trans.get_data_ptr(), len);
+    }
+    delay += m_latency;
+    trans.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+zynq7_bench_initiator::zynq7_bench_initiator(sc_module_name name, uint64_t addr,
+                                             unsigned int burst_bytes, unsigned int depth) :
+    sc_module(name),
+    socket("socket"),
+    m_addr(addr),
+    m_burst_bytes(burst_bytes),
+    m_transactions(0),
+    m_issued(0),
+    m_completed(0),
+    m_errors(0)
+{
+    for (unsigned int i = 0; i < depth; ++i) {
+        sc_spawn(sc_bind(&zynq7_bench_initiator::worker, this));
+    }
+}
+
+void zynq7_bench_initiator::start(uint64_t transactions)
+{
+    m_transactions = transactions;
+    m_start_event.notify();
+}
+
+void zynq7_bench_initiator::worker(void)
+{
+    tlm::tlm_generic_payload trans;
+    vector<uint8_t> data(m_burst_bytes);
+
+    wait(m_start_event);
+
+    while (m_issued < m_transactions) {
+        uint64_t n = m_issued++;
+        sc_time delay = SC_ZERO_TIME;
+
+        trans.set_command((n & 1) ? tlm::TLM_READ_COMMAND : tlm::TLM_WRITE_COMMAND);
+        trans.set_address(m_addr + (n * m_burst_bytes) % INITIATOR_WINDOW_SIZE);
+        trans.set_data_ptr(&data[0]);
+        trans.set_data_length(m_burst_bytes);
+        trans.set_streaming_width(m_burst_bytes);
+        trans.set_byte_enable_ptr(NULL);
+        trans.set_dmi_allowed(false);
+        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+
+        socket->b_transport(trans, delay);
+        wait(delay);
+
+        if (trans.get_response_status() != tlm::TLM_OK_RESPONSE) {
+            m_errors++;
+        }
+        m_completed++;
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Synthetic AXI traffic for the Zynq Cosim benchmark
+ *
+ * zynq7_bench_memory answers the accesses of the PS (behind an AXI to TLM
+ * bridge on an M_AXI_GP port) and zynq7_bench_initiator issues accesses to
+ * the PS (through a TLM to AXI bridge on an S_AXI port).
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_BENCH_TRAFFIC_H__
+#define __ZYNQ7_BENCH_TRAFFIC_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <vector>
+
+class zynq7_bench_memory : public sc_core::sc_module
+{
+public:
+    tlm_utils::simple_target_socket<zynq7_bench_memory> socket;
+
+    // Accesses wrap in the memory, latency is annotated on every access
+    zynq7_bench_memory(sc_core::sc_module_name name, size_t size,
+                       const sc_core::sc_time &latency = sc_core::SC_ZERO_TIME);
+
+private:
+    void b_transport(tlm::tlm_generic_payload &trans, sc_core::sc_time &delay);
+
+    std::vector<uint8_t> m_mem;
+    sc_core::sc_time m_latency;
+};
+
+class zynq7_bench_initiator : public sc_core::sc_module
+{
+public:
+    tlm_utils::simple_initiator_socket<zynq7_bench_initiator> socket;
+
+    zynq7_bench_initiator(sc_core::sc_module_name name, uint64_t addr,
+                          unsigned int burst_bytes, unsigned int depth);
+
+    // Issues transactions accesses (writes and reads alternate), depth
+    // threads keep as many transactions in flight
+    void start(uint64_t transactions);
+
+    uint64_t completed(void) const { return m_completed; }
+    uint64_t errors(void) const { return m_errors; }
+
+private:
+    void worker(void);
+
+    uint64_t m_addr;
+    unsigned int m_burst_bytes;
+    uint64_t m_transactions;
+    uint64_t m_issued;
+    uint64_t m_completed;
+    uint64_t m_errors;
+
+    sc_core::sc_event m_start_event;
+};
+
+#endif /* __ZYNQ7_BENCH_TRAFFIC_H__ */
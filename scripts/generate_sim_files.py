@@ -44,11 +44,44 @@ entity __BD_PROCESSING_SYSTEM7_0_0_NAME__ is
     generic(
         QEMU_PATH_TO_SOCKET_G    : string  := "unix:/path";
         QEMU_SYNC_QUANTUM_G      : integer := 10000;
+        QEMU_CONNECT_TIMEOUT_IN_MS_G : integer := 0;
+        QEMU_COMMAND_G           : string  := "";
+        QEMU_LINK_BATCH_IN_BYTES_G : integer := 0;
+        TIME_SCALE_G             : integer := 1;
+        FAST_FORWARD_G           : integer := 0;
+        FAST_FORWARD_BUDGET_IN_NS_G : integer := 10000000;
+        FAST_FORWARD_IDLE_QUANTA_G : integer := 10;
         --
         FCLK_CLK0_PERIOD_IN_NS_G : integer := __FCLK_CLK0_PERIOD_IN_NS__;
         FCLK_CLK1_PERIOD_IN_NS_G : integer := __FCLK_CLK1_PERIOD_IN_NS__;
         FCLK_CLK2_PERIOD_IN_NS_G : integer := __FCLK_CLK2_PERIOD_IN_NS__;
         FCLK_CLK3_PERIOD_IN_NS_G : integer := __FCLK_CLK3_PERIOD_IN_NS__;
+        SLCR_SHADOW_DEV_ID_G     : integer := -1;
+        --
+        AXI_PORT_TRACE_G         : integer := 0;
+        TIMELINE_FILE_G          : string  := "";
+        AXI_CHECKER_G            : integer := 0;
+        AXI_WATCHDOG_IN_CYCLES_G : integer := 1000000;
+        AXI_CAPTURE_DEPTH_G      : integer := 0;
+        AXI_CAPTURE_FILE_G       : string  := "axi_capture";
+        AXI_CAPTURE_TRIGGER_ADDRESS_G : string  := "";
+        AXI_CAPTURE_TRIGGER_IRQ_G : integer := 0;
+        AXI_BRIDGE_IDLE_CYCLES_G : integer := 0;
+        S_AXI_HP0_TRAFFIC_G      : string  := "";
+        S_AXI_HP1_TRAFFIC_G      : string  := "";
+        S_AXI_HP2_TRAFFIC_G      : string  := "";
+        S_AXI_HP3_TRAFFIC_G      : string  := "";
+        DDR_MODEL_G              : integer := 0;
+        DDR_BANDWIDTH_IN_MBPS_G  : integer := 4264;
+        DDR_LATENCY_IN_NS_G      : integer := 80;
+        DDR_GP_LATENCY_IN_NS_G   : integer := 40;
+        M_AXI_GP0_READ_CACHE_G   : string  := "";
+        M_AXI_GP1_READ_CACHE_G   : string  := "";
+        READ_CACHE_LIFETIME_IN_CYCLES_G : integer := 0;
+        M_AXI_GP0_ADDR_MAP_G     : string  := "";
+        M_AXI_GP1_ADDR_MAP_G     : string  := "";
+        M_AXI_GP0_LITE_G         : integer := 0;
+        M_AXI_GP1_LITE_G         : integer := 0;
         --
         M_AXI_GP0_ENABLE_G       : integer := __M_AXI_GP0_ENABLE__;
         M_AXI_GP1_ENABLE_G       : integer := __M_AXI_GP1_ENABLE__;
@@ -59,6 +92,7 @@ entity __BD_PROCESSING_SYSTEM7_0_0_NAME__ is
         S_AXI_HP1_ENABLE_G       : integer := __S_AXI_HP1_ENABLE__;
         S_AXI_HP2_ENABLE_G       : integer := __S_AXI_HP2_ENABLE__;
         S_AXI_HP3_ENABLE_G       : integer := __S_AXI_HP3_ENABLE__;
+        S_AXI_ACP_ENABLE_G       : integer := __S_AXI_ACP_ENABLE__;
         --
         M_AXI_GP0_ADDR_WIDTH_G   : integer := __M_AXI_GP0_ADDR_WIDTH__;
         M_AXI_GP0_DATA_WIDTH_G   : integer := __M_AXI_GP0_DATA_WIDTH__;
@@ -106,7 +140,13 @@ entity __BD_PROCESSING_SYSTEM7_0_0_NAME__ is
         S_AXI_HP3_DATA_WIDTH_G   : integer := __S_AXI_HP3_DATA_WIDTH__;
         S_AXI_HP3_ID_WIDTH_G     : integer := __S_AXI_HP3_ID_WIDTH__;
         S_AXI_HP3_AXLEN_WIDTH_G  : integer := __S_AXI_HP3_AXLEN_WIDTH__;
-        S_AXI_HP3_AXLOCK_WIDTH_G : integer := __S_AXI_HP3_AXLOCK_WIDTH__
+        S_AXI_HP3_AXLOCK_WIDTH_G : integer := __S_AXI_HP3_AXLOCK_WIDTH__;
+        --
+        S_AXI_ACP_ADDR_WIDTH_G   : integer := __S_AXI_ACP_ADDR_WIDTH__;
+        S_AXI_ACP_DATA_WIDTH_G   : integer := __S_AXI_ACP_DATA_WIDTH__;
+        S_AXI_ACP_ID_WIDTH_G     : integer := __S_AXI_ACP_ID_WIDTH__;
+        S_AXI_ACP_AXLEN_WIDTH_G  : integer := __S_AXI_ACP_AXLEN_WIDTH__;
+        S_AXI_ACP_AXLOCK_WIDTH_G : integer := __S_AXI_ACP_AXLOCK_WIDTH__
         );
 """
 
@@ -124,6 +164,7 @@ architecture struct of __BD_PROCESSING_SYSTEM7_0_0_NAME__ is
     signal s_axi_hp1_aresetn_s : std_logic;
     signal s_axi_hp2_aresetn_s : std_logic;
     signal s_axi_hp3_aresetn_s : std_logic;
+    signal s_axi_acp_aresetn_s : std_logic;
 
 begin
 
@@ -131,11 +172,44 @@ begin
         generic map (
             QEMU_PATH_TO_SOCKET_G    => QEMU_PATH_TO_SOCKET_G,
             QEMU_SYNC_QUANTUM_G      => QEMU_SYNC_QUANTUM_G,
+            QEMU_CONNECT_TIMEOUT_IN_MS_G => QEMU_CONNECT_TIMEOUT_IN_MS_G,
+            QEMU_COMMAND_G           => QEMU_COMMAND_G,
+            QEMU_LINK_BATCH_IN_BYTES_G => QEMU_LINK_BATCH_IN_BYTES_G,
+            TIME_SCALE_G             => TIME_SCALE_G,
+            FAST_FORWARD_G           => FAST_FORWARD_G,
+            FAST_FORWARD_BUDGET_IN_NS_G => FAST_FORWARD_BUDGET_IN_NS_G,
+            FAST_FORWARD_IDLE_QUANTA_G => FAST_FORWARD_IDLE_QUANTA_G,
             --
             FCLK_CLK0_PERIOD_IN_NS_G => FCLK_CLK0_PERIOD_IN_NS_G,
             FCLK_CLK1_PERIOD_IN_NS_G => FCLK_CLK1_PERIOD_IN_NS_G,
             FCLK_CLK2_PERIOD_IN_NS_G => FCLK_CLK2_PERIOD_IN_NS_G,
             FCLK_CLK3_PERIOD_IN_NS_G => FCLK_CLK3_PERIOD_IN_NS_G,
+            SLCR_SHADOW_DEV_ID_G     => SLCR_SHADOW_DEV_ID_G,
+            --
+            AXI_PORT_TRACE_G         => AXI_PORT_TRACE_G,
+            TIMELINE_FILE_G          => TIMELINE_FILE_G,
+            AXI_CHECKER_G            => AXI_CHECKER_G,
+            AXI_WATCHDOG_IN_CYCLES_G => AXI_WATCHDOG_IN_CYCLES_G,
+            AXI_CAPTURE_DEPTH_G      => AXI_CAPTURE_DEPTH_G,
+            AXI_CAPTURE_FILE_G       => AXI_CAPTURE_FILE_G,
+            AXI_CAPTURE_TRIGGER_ADDRESS_G => AXI_CAPTURE_TRIGGER_ADDRESS_G,
+            AXI_CAPTURE_TRIGGER_IRQ_G => AXI_CAPTURE_TRIGGER_IRQ_G,
+            AXI_BRIDGE_IDLE_CYCLES_G => AXI_BRIDGE_IDLE_CYCLES_G,
+            S_AXI_HP0_TRAFFIC_G      => S_AXI_HP0_TRAFFIC_G,
+            S_AXI_HP1_TRAFFIC_G      => S_AXI_HP1_TRAFFIC_G,
+            S_AXI_HP2_TRAFFIC_G      => S_AXI_HP2_TRAFFIC_G,
+            S_AXI_HP3_TRAFFIC_G      => S_AXI_HP3_TRAFFIC_G,
+            DDR_MODEL_G              => DDR_MODEL_G,
+            DDR_BANDWIDTH_IN_MBPS_G  => DDR_BANDWIDTH_IN_MBPS_G,
+            DDR_LATENCY_IN_NS_G      => DDR_LATENCY_IN_NS_G,
+            DDR_GP_LATENCY_IN_NS_G   => DDR_GP_LATENCY_IN_NS_G,
+            M_AXI_GP0_READ_CACHE_G   => M_AXI_GP0_READ_CACHE_G,
+            M_AXI_GP1_READ_CACHE_G   => M_AXI_GP1_READ_CACHE_G,
+            READ_CACHE_LIFETIME_IN_CYCLES_G => READ_CACHE_LIFETIME_IN_CYCLES_G,
+            M_AXI_GP0_ADDR_MAP_G     => M_AXI_GP0_ADDR_MAP_G,
+            M_AXI_GP1_ADDR_MAP_G     => M_AXI_GP1_ADDR_MAP_G,
+            M_AXI_GP0_LITE_G         => M_AXI_GP0_LITE_G,
+            M_AXI_GP1_LITE_G         => M_AXI_GP1_LITE_G,
             --
             M_AXI_GP0_ENABLE_G       => M_AXI_GP0_ENABLE_G,
             M_AXI_GP1_ENABLE_G       => M_AXI_GP1_ENABLE_G,
@@ -148,6 +222,8 @@ begin
             S_AXI_HP2_ENABLE_G       => S_AXI_HP2_ENABLE_G,
             S_AXI_HP3_ENABLE_G       => S_AXI_HP3_ENABLE_G,
             --
+            S_AXI_ACP_ENABLE_G       => S_AXI_ACP_ENABLE_G,
+            --
             M_AXI_GP0_ADDR_WIDTH_G   => M_AXI_GP0_ADDR_WIDTH_G,
             M_AXI_GP0_DATA_WIDTH_G   => M_AXI_GP0_DATA_WIDTH_G,
             M_AXI_GP0_ID_WIDTH_G     => M_AXI_GP0_ID_WIDTH_G,
@@ -194,7 +270,13 @@ begin
             S_AXI_HP3_DATA_WIDTH_G   => S_AXI_HP3_DATA_WIDTH_G,
             S_AXI_HP3_ID_WIDTH_G     => S_AXI_HP3_ID_WIDTH_G,
             S_AXI_HP3_AXLEN_WIDTH_G  => S_AXI_HP3_AXLEN_WIDTH_G,
-            S_AXI_HP3_AXLOCK_WIDTH_G => S_AXI_HP3_AXLOCK_WIDTH_G)"""
+            S_AXI_HP3_AXLOCK_WIDTH_G => S_AXI_HP3_AXLOCK_WIDTH_G,
+            --
+            S_AXI_ACP_ADDR_WIDTH_G   => S_AXI_ACP_ADDR_WIDTH_G,
+            S_AXI_ACP_DATA_WIDTH_G   => S_AXI_ACP_DATA_WIDTH_G,
+            S_AXI_ACP_ID_WIDTH_G     => S_AXI_ACP_ID_WIDTH_G,
+            S_AXI_ACP_AXLEN_WIDTH_G  => S_AXI_ACP_AXLEN_WIDTH_G,
+            S_AXI_ACP_AXLOCK_WIDTH_G => S_AXI_ACP_AXLOCK_WIDTH_G)"""
 
 port_map = """
         port map (
@@ -213,6 +295,8 @@ end_architecture = """
     s_axi_hp2_aresetn_s <= not rst_s;
     s_axi_hp3_aresetn_s <= not rst_s;
     --
+    s_axi_acp_aresetn_s <= not rst_s;
+    --
 
     -- Other inputs and outputs are left unconnected because they are not
     -- needed for this design and will therefore stay in an 'U' or 'X' state in
@@ -224,6 +308,10 @@ end architecture struct;"""
 clock_connection = """            --__CONNECT_FCLK_CLKX__
             fclk_clkX         => FCLK_CLKX,"""
 
+reset_connection = """
+            --__CONNECT_FCLK_RESETX_N__
+            fclk_resetX_n     => FCLK_RESETX_N,"""
+
 axi_connection = """
             --__CONNECT_AXIU__
             AXIL_aclk    => AXIU_ACLK,
@@ -279,7 +367,8 @@ end_port_map = """
 """
 
 clock_port_pattern = re.compile("FCLK_CLK[0-3]")
-axi_port_pattern = re.compile("[MS]_AXI_[GH]P[0-3]")
+reset_port_pattern = re.compile("FCLK_RESET[0-3]_N")
+axi_port_pattern = re.compile("[MS]_AXI_(?:[GH]P[0-3]|ACP)")
 
 class DefaultAXIParameters:
     """Default AXI Parameters"""
@@ -301,6 +390,16 @@ class DefaultHPAXIParameters:
         self.axlen_width  = 4
         self.axlock_width = 2
 
+class DefaultACPAXIParameters:
+    """Default AXI Parameters"""
+    def __init__(self):
+        # Default values
+        self.addr_width   = 32
+        self.data_width   = 64
+        self.id_width     = 3
+        self.axlen_width  = 4
+        self.axlock_width = 2
+
 class AXIParameters:
     """AXI Parameters"""
     
@@ -354,6 +453,10 @@ def axiPortConnection(axi_port):
 def clockConnection(clock):
     clock_con = clock_connection.replace("X", str(clock))
     return clock_con
+
+def resetConnection(reset):
+    reset_con = reset_connection.replace("X", str(reset))
+    return reset_con
             
 def getName(fileStr):
     extract_pattern = "\s*entity\s+(.*7_0_0)\s+is.*"
@@ -394,6 +497,7 @@ class ProcessingSystem7:
                 self.has_clock_3 = False
 
             self.clock_ports = set(re.findall(clock_port_pattern, f))
+            self.reset_ports = set(re.findall(reset_port_pattern, f))
             self.axi_ports = set(re.findall(axi_port_pattern, f))
 
             if ("IRQ_F2P" in f):
@@ -404,6 +508,7 @@ class ProcessingSystem7:
 def replaceUnParameterizedAXIPorts(fileStrToUpdate):
     default_params = DefaultAXIParameters()
     default_hp_params = DefaultHPAXIParameters()
+    default_acp_params = DefaultACPAXIParameters()
 
     output = re.sub("__[MS]_AXI_GP[0-1]_ADDR_WIDTH__", str(default_params.addr_width), fileStrToUpdate)
     output = re.sub("__[MS]_AXI_GP[0-1]_DATA_WIDTH__", str(default_params.data_width), output)
@@ -417,8 +522,14 @@ def replaceUnParameterizedAXIPorts(fileStrToUpdate):
     output = re.sub("__[MS]_AXI_HP[0-3]_ID_WIDTH__", str(default_hp_params.id_width), output)
     output = re.sub("__[MS]_AXI_HP[0-3]_AXLEN_WIDTH__", str(default_hp_params.axlen_width), output)
     output = re.sub("__[MS]_AXI_HP[0-3]_AXLOCK_WIDTH__", str(default_hp_params.axlock_width), output)
+
+    output = re.sub("__S_AXI_ACP_ADDR_WIDTH__", str(default_acp_params.addr_width), output)
+    output = re.sub("__S_AXI_ACP_DATA_WIDTH__", str(default_acp_params.data_width), output)
+    output = re.sub("__S_AXI_ACP_ID_WIDTH__", str(default_acp_params.id_width), output)
+    output = re.sub("__S_AXI_ACP_AXLEN_WIDTH__", str(default_acp_params.axlen_width), output)
+    output = re.sub("__S_AXI_ACP_AXLOCK_WIDTH__", str(default_acp_params.axlock_width), output)
     
-    output = re.sub("__[MS]_AXI_[GH]P[0-3]_ENABLE__", "0", output)
+    output = re.sub("__[MS]_AXI_(?:[GH]P[0-3]|ACP)_ENABLE__", "0", output)
     
     return output
                 
@@ -462,28 +573,28 @@ def generateVHDLFileContents(fileName):
     if processing_system.has_clock_0:
         updated_port_map += clockConnection(0)
         updated_generics = updated_generics.replace("__FCLK_CLK0_PERIOD_IN_NS__", str(10000))
-        updated_end_architecture = "    FCLK_RESET0_N <= not rst_s;\n" + updated_end_architecture
     else:
         updated_generics = updated_generics.replace("__FCLK_CLK0_PERIOD_IN_NS__", str(-1))
     if processing_system.has_clock_1:
         updated_port_map += clockConnection(1)
         updated_generics = updated_generics.replace("__FCLK_CLK1_PERIOD_IN_NS__", str(10000))
-        updated_end_architecture = "    FCLK_RESET1_N <= not rst_s;\n" + updated_end_architecture
     else:
         updated_generics = updated_generics.replace("__FCLK_CLK1_PERIOD_IN_NS__", str(-1))
     if processing_system.has_clock_2:
         updated_port_map += clockConnection(2)
         updated_generics = updated_generics.replace("__FCLK_CLK2_PERIOD_IN_NS__", str(10000))
-        updated_end_architecture = "    FCLK_RESET2_N <= not rst_s;\n" + updated_end_architecture
     else:
         updated_generics = updated_generics.replace("__FCLK_CLK2_PERIOD_IN_NS__", str(-1))
     if processing_system.has_clock_3:
         updated_port_map += clockConnection(3)
         updated_generics = updated_generics.replace("__FCLK_CLK3_PERIOD_IN_NS__", str(10000))
-        updated_end_architecture = "    FCLK_RESET3_N <= not rst_s;\n" + updated_end_architecture
     else:
         updated_generics = updated_generics.replace("__FCLK_CLK3_PERIOD_IN_NS__", str(-1))
         
+    # The PL resets come from FPGA_RST_CTRL (and the global reset)
+    for reset in sorted(processing_system.reset_ports):
+        updated_port_map += resetConnection(reset[len("FCLK_RESET")])
+
     for axi_p in processing_system.axi_ports:
         updated_port_map += axiPortConnection(axi_p)
 
@@ -526,6 +637,21 @@ do [TOP_DESIGN]_elaborate.do
 vsim -lib xil_defaultlib [TOP_DESIGN]_opt
 """
 
+# Batch run (vsim -c -do zynq7_batch.do after all.do compiled the design), the simulator quits with
+# the status of the guest when it ended the simulation (see src_sc/zynq7_exit.h)
+batch_do_script = """# Batch script for QuestaSim (auto-generated)
+vsim -c -lib xil_defaultlib [TOP_DESIGN]_opt
+file delete -force zynq7_exit_status
+run -all
+if {[file exists zynq7_exit_status]} {
+    set status_file [open zynq7_exit_status]
+    set status [string trim [read $status_file]]
+    close $status_file
+    quit -code $status
+}
+quit -f
+"""
+
 compile_do_script = """# Script to compile the CoSimulation files (auto-generated)
 
 vlib questa_lib/work
@@ -554,7 +680,56 @@ sccom -work xil_defaultlib -g -I./libsystemctlm-soc/libremote-port/ -I./libsyste
 sccom -work xil_defaultlib -g -I./libsystemctlm-soc/libremote-port/ -I./libsystemctlm-soc/ ./libsystemctlm-soc/libremote-port/remote-port-tlm-memory-slave.cc
 
 # The main Zynq SystemC-TLM CoSimulation entity
-sccom -work xil_defaultlib [CXX_ARGS_PS7] -g -I./libsystemctlm-soc/libremote-port/ -I./libsystemctlm-soc/ -I./libsystemctlm-soc/soc/xilinx/zynq/ -Isrc_sc -I. -I./libsystemctlm-soc/tlm-bridges/ src_sc/zynq7_ps.cc
+# All the zynq7_ps translation units must be compiled with the same flags (port widths are template parameters)
+set ZYNQ7_PS_ARGS "[CXX_ARGS_PS7] -g -I./libsystemctlm-soc/libremote-port/ -I./libsystemctlm-soc/ -I./libsystemctlm-soc/soc/xilinx/zynq/ -Isrc_sc -I. -I./libsystemctlm-soc/tlm-bridges/"
+
+# A unit (or the precompiled header) is only rebuilt when its source, a header of src_sc or this
+# script (flags) is newer than its last successful compilation, the stamps are kept in questa_lib
+file mkdir questa_lib/zynq7_stamps
+set ZYNQ7_PS_DEPS [concat [glob src_sc/*.h] [list zynq7_compile_cosim.do]]
+proc zynq7_up_to_date {source stamp} {
+    global ZYNQ7_PS_DEPS
+    if {![file exists $stamp]} {
+        return 0
+    }
+    foreach dep [concat [list $source] $ZYNQ7_PS_DEPS] {
+        if {[file mtime $dep] > [file mtime $stamp]} {
+            return 0
+        }
+    }
+    return 1
+}
+proc zynq7_sccom {source} {
+    global ZYNQ7_PS_ARGS
+    set stamp questa_lib/zynq7_stamps/[file tail $source].stamp
+    if {[zynq7_up_to_date $source $stamp]} {
+        echo "$source is up to date"
+        return
+    }
+    eval sccom -work xil_defaultlib $ZYNQ7_PS_ARGS $source
+    close [open $stamp w]
+}
+
+# Precompiled header (SystemC, TLM, remote-port and bridges), used by g++ for every unit below when it exists.
+# This step is optional, if the simulator refuses it the units are compiled without it (a stale one is removed)
+if {![zynq7_up_to_date src_sc/zynq7_ps_pch.h questa_lib/zynq7_stamps/zynq7_ps_pch.h.stamp]} {
+    if {[catch {eval sccom -work xil_defaultlib $ZYNQ7_PS_ARGS -x c++-header src_sc/zynq7_ps_pch.h -o src_sc/zynq7_ps_pch.h.gch} result]} {
+        echo "Warning : precompiled header not generated, compiling without it : $result"
+        file delete -force src_sc/zynq7_ps_pch.h.gch
+    } else {
+        close [open questa_lib/zynq7_stamps/zynq7_ps_pch.h.stamp w]
+    }
+}
+
+# One translation unit per port, each one instantiates its own bridge, the top level does not instantiate any
+foreach port {m_axi_gp0 m_axi_gp1 s_axi_gp0 s_axi_gp1 s_axi_hp0 s_axi_hp1 s_axi_hp2 s_axi_hp3 s_axi_acp} {
+    zynq7_sccom src_sc/zynq7_ps_${port}.cc
+}
+# Services (QEMU link, peer poller, clocks, SLCR shadow, port monitors, AXI checkers, AXI capture, bridge gates, counter device, address decoders, memories, read caches, traffic generators, DDR model, fast-forward, timeline, guest exit, shared memory links and their AXI ends, AXI-Stream source and sink)
+foreach service {rp_link peer_poller fclk_gen slcr_shadow port_monitor axi_checker axi_capture bridge_gate counters addr_decoder memory read_cache traffic_gen ddr_model fast_forward timeline exit shm_link shm_axi axis} {
+    zynq7_sccom src_sc/zynq7_${service}.cc
+}
+zynq7_sccom src_sc/zynq7_ps.cc
 
 # Generation of the VHDL template (as reference only)
 # Xilinx uses .veo and .vho for verilog and vhdl templates respectively (component description)
@@ -562,6 +737,10 @@ sccom -work xil_defaultlib [CXX_ARGS_PS7] -g -I./libsystemctlm-soc/libremote-por
 
 # Compilation of the VHDL wrapper around the SystemC entity (should be consistent with the template above)
 vcom -work xil_defaultlib src_vhdl/zynq7_ps_wrapper.vhd
+# AXI-Stream source and sink, to instantiate next to the PS in the testbench (TDATA width : -D__AXIS_TDATA_WIDTH__)
+vcom -work xil_defaultlib src_vhdl/zynq7_axis_wrapper.vhd
+# AXI ends of the shared memory links, to split the PL between simulator processes (widths : -D__SHM_AXI_*_WIDTH__)
+vcom -work xil_defaultlib src_vhdl/zynq7_shm_axi_wrapper.vhd
 
 # Link (systemc.so)
 sccom -link -work xil_defaultlib 
@@ -578,6 +757,8 @@ vcom -work xil_defaultlib -2008 [BD_WRAPPER_FILE_NAME]
 #
 # Time quantum and machine path should be the same between simulation and QEMU emulation
 # (generic parameters of zynq_top component, can be changed in testbench)
+# The quantum and the FCLK periods can be calibrated on a workload with scripts/tune_sim_speed.py,
+# it writes the fastest settings within accuracy bounds back into the generics of the generated wrapper
   """
 
 from os import listdir
@@ -604,6 +785,9 @@ def generateCompilationScriptContents(inputFile):
 def generateAllDoFileContents(topName):
     return all_do_script.replace("[TOP_DESIGN]", topName)
 
+def generateBatchDoFileContents(topName):
+    return batch_do_script.replace("[TOP_DESIGN]", topName)
+
 def main():
     #print("Argument list: ", str(sys.argv))
     if (len(sys.argv) < 3):
@@ -628,6 +812,7 @@ def main():
     vhdl_file_name = dirPath + "/" + ps.name + ".vhd"
     comp_file_name = dirPath + "/" + "zynq7_compile_cosim.do"
     all_do_file_name = dirPath + "/" + "all.do"
+    batch_do_file_name = dirPath + "/" + "zynq7_batch.do"
     
     # Generate VHDL File
     vhdl_file_contents = generateVHDLFileContents(fileName)
@@ -645,9 +830,15 @@ def main():
     all_do_file.write(generateAllDoFileContents(getTopName(filesInSimDir)))
     all_do_file.close()
 
+    # Generate the batch script
+    batch_do_file = open(batch_do_file_name, "w")
+    batch_do_file.write(generateBatchDoFileContents(getTopName(filesInSimDir)))
+    batch_do_file.close()
+
     print("Genenerated the follwing files : ")
     print(vhdl_file_name)
     print(comp_file_name)
     print(all_do_file_name)
+    print(batch_do_file_name)
     
 main()
@@ -0,0 +1,230 @@
+import sys
+import re
+import json
+import time
+import argparse
+import subprocess
+
+from os import listdir
+from os.path import isfile, join
+
+# Simulation speed tuner (calibration mode)
+#
+# Runs a short representative workload with several candidate values of
+# QEMU_SYNC_QUANTUM_G and of the FCLK periods, and writes the fastest ones
+# that stay within the accuracy bounds back into the generics of the wrapper
+# generated by generate_sim_files.py (recompile it afterwards with
+# zynq7_compile_cosim.do).
+#
+# Each run is a batch vsim of the compiled design in the simulation directory
+# with the candidate generics (-G) and a timeline (TIMELINE_FILE_G, see
+# src_sc/zynq7_timeline.h). From the timeline :
+# - speed : simulated time / host time
+# - access latency : mean duration of the PS accesses (M_AXI_GP ports)
+# - IRQ latency : mean time from an IRQ_F2P rise to the next PS access
+#   (usually the guest handler reading the status of the PL)
+# The latencies are compared with the ones of the reference run (first
+# quantum, clock scale 1), their relative error must stay within bounds.
+#
+# The workload must end by itself (e.g., the guest writes to an exit region,
+# see src_sc/zynq7_addr_decoder.h) or be bounded with --run-time. QEMU is
+# launched by the simulator for each run (QEMU_COMMAND_G), {quantum} in the
+# command is replaced by the quantum of the run so both sides agree.
+#
+# The design must be optimized with floating generics for -G to apply (e.g.,
+# +floatgenerics in the vopt command of [top name]_elaborate.do).
+#
+# Example :
+# python3 tune_sim_speed.py sim --qemu-command "petalinux-boot --qemu ... -sync-quantum {quantum}" \
+#     --quantums 10000,100000,1000000 --fclk-scales 1,2,5,10 --max-access-error 0.1
+
+# Generics set by the tuner in the generated wrapper
+quantum_pattern = re.compile(r"(\bQEMU_SYNC_QUANTUM_G\s*:\s*integer\s*:=\s*)(-?[0-9]+)")
+fclk_pattern = re.compile(r"(\bFCLK_CLK([0-3])_PERIOD_IN_NS_G\s*:\s*integer\s*:=\s*)(-?[0-9]+)")
+
+# This deduces the top name from the [top name]_elaborate.do file generated by Vivado
+def getTopName(filesInSimDir):
+    vivado_elaborate_file = next(x for x in filesInSimDir if re.match(".+_elaborate.do", x))
+    return vivado_elaborate_file.replace("_elaborate.do", "")
+
+# The wrapper generated by generate_sim_files.py (the only VHDL file with the PS generics)
+def getWrapperFileName(dirPath, filesInSimDir):
+    for f in filesInSimDir:
+        if f.endswith(".vhd") and ("system7_0_0" in f):
+            if re.search(quantum_pattern, open(join(dirPath, f)).read()):
+                return join(dirPath, f)
+    return None
+
+def getGenerics(wrapperContents):
+    quantum = int(re.search(quantum_pattern, wrapperContents).group(2))
+    periods = {}
+    for m in re.finditer(fclk_pattern, wrapperContents):
+        periods[int(m.group(2))] = int(m.group(3))
+    return quantum, periods
+
+def setGenerics(wrapperContents, quantum, periods):
+    output = re.sub(quantum_pattern, lambda m: m.group(1) + str(quantum), wrapperContents)
+    return re.sub(fclk_pattern, lambda m: m.group(1) + str(periods[int(m.group(2))]), output)
+
+# Events of a timeline, a file cut short lacks the closing bracket
+def readTimeline(fileName):
+    contents = open(fileName).read().rstrip()
+    if not contents.endswith("]"):
+        contents = contents.rstrip(",") + "]"
+    return json.loads(contents)
+
+def mean(values):
+    return sum(values) / len(values) if values else None
+
+class RunMetrics:
+    """Speed and latencies of a run, from its timeline"""
+
+    def __init__(self, events):
+        SIMULATED, HOST = 1, 2
+        threads = {}
+        for e in events:
+            if (e["ph"] == "M") and (e["name"] == "thread_name") and (e["pid"] == SIMULATED):
+                threads[e["tid"]] = e["args"]["name"]
+
+        sim_end = 0.0
+        host_end = 0.0
+        accesses = []
+        irq_rises = []
+        self.sync_wait = 0.0
+        for e in events:
+            if e["ph"] == "M":
+                continue
+            end = e["ts"] + e.get("dur", 0)
+            if e["pid"] == HOST:
+                host_end = max(host_end, end)
+                continue
+            sim_end = max(sim_end, end)
+            if (e["ph"] == "X") and threads.get(e["tid"], "").startswith("M_AXI_GP"):
+                accesses.append((e["ts"], e["dur"]))
+            elif (e["ph"] == "i") and e["name"].startswith("IRQ_F2P") and e["name"].endswith("rise"):
+                irq_rises.append(e["ts"])
+            elif (e["ph"] == "i") and (e["name"] == "sync"):
+                self.sync_wait += e["args"].get("wait_us", 0)
+
+        accesses.sort()
+        irq_latencies = []
+        for t in irq_rises:
+            next_access = next((a[0] for a in accesses if a[0] >= t), None)
+            if next_access is not None:
+                irq_latencies.append(next_access - t)
+
+        self.sim_us = sim_end
+        self.host_us = host_end
+        self.speed = sim_end / host_end if host_end > 0 else 0.0
+        self.access_latency = mean([a[1] for a in accesses])
+        self.irq_latency = mean(irq_latencies)
+
+# Relative error of a latency against the reference, 0 when there is nothing to compare
+def relativeError(value, reference):
+    if (value is None) or (reference is None) or (reference == 0):
+        return 0.0
+    return abs(value - reference) / reference
+
+def runCandidate(args, dirPath, topName, quantum, periods, index):
+    timelineName = "tune_sim_speed_" + str(index) + ".json"
+    generics = ["-GQEMU_SYNC_QUANTUM_G=" + str(quantum), "-GTIMELINE_FILE_G=" + timelineName]
+    for n in sorted(periods):
+        generics.append("-GFCLK_CLK" + str(n) + "_PERIOD_IN_NS_G=" + str(periods[n]))
+    if args.qemu_command:
+        generics.append("-GQEMU_COMMAND_G=" + args.qemu_command.replace("{quantum}", str(quantum)))
+        generics.append("-GQEMU_CONNECT_TIMEOUT_IN_MS_G=" + str(args.connect_timeout))
+    command = ["vsim", "-c", "-lib", "xil_defaultlib", topName + "_opt"] + generics + \
+              ["-do", "run " + args.run_time + "; quit -f"]
+
+    start = time.time()
+    try:
+        subprocess.run(command, cwd=dirPath, stdout=subprocess.DEVNULL, timeout=args.timeout)
+    except subprocess.TimeoutExpired:
+        print("  run timed out after " + str(args.timeout) + " s")
+    wall = time.time() - start
+
+    timelineFileName = join(dirPath, timelineName)
+    if not isfile(timelineFileName):
+        print("  no timeline written (is the design optimized with floating generics ?)")
+        return None
+    metrics = RunMetrics(readTimeline(timelineFileName))
+    print("  %.3f ms simulated in %.1f s (run %.1f s), speed %.3g, waited %.1f s for QEMU" %
+          (metrics.sim_us / 1e3, metrics.host_us / 1e6, wall, metrics.speed, metrics.sync_wait / 1e6))
+    return metrics
+
+def parseList(text, kind):
+    return [kind(x) for x in text.split(",") if x]
+
+def main():
+    parser = argparse.ArgumentParser(description="Tunes the sync quantum and the FCLK periods of the cosimulation")
+    parser.add_argument("sim_dir", help="simulation directory (with the files of generate_sim_files.py, compiled)")
+    parser.add_argument("--quantums", default="", help="candidate QEMU_SYNC_QUANTUM_G values in ns, the first one is the reference (default : the current one)")
+    parser.add_argument("--fclk-scales", default="1,2,5,10", help="candidate factors applied to the current FCLK periods")
+    parser.add_argument("--max-access-error", type=float, default=0.1, help="maximal relative error of the PS access latency")
+    parser.add_argument("--max-irq-error", type=float, default=0.2, help="maximal relative error of the IRQ latency")
+    parser.add_argument("--qemu-command", default="", help="QEMU command line launched for each run ({quantum} : quantum of the run)")
+    parser.add_argument("--connect-timeout", type=int, default=60000, help="QEMU connection timeout in ms")
+    parser.add_argument("--run-time", default="-all", help="simulated time of a run (vsim run argument)")
+    parser.add_argument("--timeout", type=int, default=3600, help="wall time limit of a run in s")
+    parser.add_argument("--dry-run", action="store_true", help="report the best settings without writing them")
+    args = parser.parse_args()
+
+    dirPath = args.sim_dir
+    filesInSimDir = [f for f in listdir(dirPath) if isfile(join(dirPath, f))]
+    wrapperFileName = getWrapperFileName(dirPath, filesInSimDir)
+    if wrapperFileName is None:
+        print("Could not find the wrapper generated by generate_sim_files.py in " + dirPath)
+        return
+    topName = getTopName(filesInSimDir)
+    wrapperContents = open(wrapperFileName).read()
+    currentQuantum, currentPeriods = getGenerics(wrapperContents)
+
+    quantums = parseList(args.quantums, int) or [currentQuantum]
+    scales = parseList(args.fclk_scales, float)
+    if 1.0 not in scales:
+        scales = [1.0] + scales
+    # The unused clocks stay tied to 0
+    usedPeriods = dict((n, p) for n, p in currentPeriods.items() if p > 0)
+
+    candidates = []
+    for quantum in quantums:
+        for scale in sorted(scales):
+            periods = dict(currentPeriods)
+            for n, p in usedPeriods.items():
+                periods[n] = max(1, int(round(p * scale)))
+            candidates.append((quantum, scale, periods))
+
+    results = []
+    reference = None
+    for index, (quantum, scale, periods) in enumerate(candidates):
+        print("Run " + str(index) + " : quantum " + str(quantum) + " ns, FCLK periods x" + str(scale))
+        metrics = runCandidate(args, dirPath, topName, quantum, periods, index)
+        if metrics is None:
+            continue
+        if reference is None:
+            reference = metrics
+        accessError = relativeError(metrics.access_latency, reference.access_latency)
+        irqError = relativeError(metrics.irq_latency, reference.irq_latency)
+        accepted = (accessError <= args.max_access_error) and (irqError <= args.max_irq_error)
+        print("  access latency error %.1f %%, IRQ latency error %.1f %%%s" %
+              (accessError * 100, irqError * 100, "" if accepted else " (out of bounds)"))
+        if accepted:
+            results.append((metrics.speed, quantum, scale, periods))
+
+    if not results:
+        print("No candidate within the accuracy bounds, the generics are unchanged")
+        return
+
+    speed, quantum, scale, periods = max(results, key=lambda r: r[0])
+    print("Fastest within bounds : quantum " + str(quantum) + " ns, FCLK periods x" + str(scale) +
+          " (speed %.3g)" % speed)
+    if args.dry_run:
+        return
+
+    output_file = open(wrapperFileName, "w")
+    output_file.write(setGenerics(wrapperContents, quantum, periods))
+    output_file.close()
+    print("Updated the generics of " + wrapperFileName + " (recompile with zynq7_compile_cosim.do)")
+    print("QEMU must be launched with the same sync quantum (-sync-quantum " + str(quantum) + ")")
+
+main()
@@ -0,0 +1,250 @@
+/*
+ * Address decoder for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_addr_decoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <iostream>
+#include <sstream>
+
+using namespace sc_core;
+using namespace std;
+
+bool zynq7_addr_decoder::parse(const string &descr, vector<region> &regions, string &error)
+{
+    istringstream iss(descr);
+    string item;
+
+    while (getline(iss, item, ',')) {
+        istringstream fields(item);
+        string kind, base, size;
+        getline(fields, kind, ':');
+        getline(fields, base, ':');
+        getline(fields, size, ':');
+
+        region r;
+        getline(fields, r.file, ':');
+        getline(fields, r.image, ':');
+        if (kind == "mem") {
+            r.kind = MEMORY;
+        } else if (kind == "decerr") {
+            r.kind = DECERR;
+        } else if (kind == "exit") {
+            r.kind = EXIT;
+        } else if (kind == "marker") {
+            r.kind = MARKER;
+        } else if (kind == "counter") {
+            r.kind = COUNTER;
+        } else {
+            error = "unknown kind " + kind;
+            return false;
+        }
+        char *base_end;
+        char *size_end;
+        r.base = strtoull(base.c_str(), &base_end, 0);
+        r.size = strtoull(size.c_str(), &size_end, 0);
+        if (base.empty() || size.empty() || *base_end || *size_end || (r.size == 0) ||
+            ((r.kind != MEMORY) && (!r.file.empty() || !r.image.empty()))) {
+            error = "invalid region " + item;
+            return false;
+        }
+        for (size_t i = 0; i < regions.size(); ++i) {
+            if ((r.base < regions[i].base + regions[i].size) && (regions[i].base < r.base + r.size)) {
+                error = "overlapping region " + item;
+                return false;
+            }
+        }
+        regions.push_back(r);
+    }
+    return true;
+}
+
+zynq7_addr_decoder::zynq7_addr_decoder(sc_module_name name, const string &port_name,
+                                       const vector<region> &regions) :
+    sc_module(name),
+    tgt_socket("tgt_socket"),
+    init_socket("init_socket"),
+    m_port_name(port_name),
+    m_exit_requested(false),
+    m_exit_status(0),
+    m_counters(NULL),
+    m_local(0),
+    m_decerr(0)
+{
+    for (size_t i = 0; i < regions.size(); ++i) {
+        mapping m;
+        m.r = regions[i];
+        m.mem = NULL;
+        if (m.r.kind == MEMORY) {
+            std::ostringstream oss;
+            oss << "mem" << i;
+            m.mem = new zynq7_memory(oss.str().c_str(), m.r.base, m.r.size, m.r.file, m.r.image);
+        }
+        m_map.push_back(m);
+    }
+
+    tgt_socket.register_b_transport(this, &zynq7_addr_decoder::b_transport);
+    tgt_socket.register_transport_dbg(this, &zynq7_addr_decoder::transport_dbg);
+    tgt_socket.register_get_direct_mem_ptr(this, &zynq7_addr_decoder::get_direct_mem_ptr);
+    init_socket.register_invalidate_direct_mem_ptr(this, &zynq7_addr_decoder::invalidate_direct_mem_ptr);
+}
+
+bool zynq7_addr_decoder::take_marker(uint32_t &value)
+{
+    if (m_markers.empty()) {
+        return false;
+    }
+    value = m_markers.front();
+    m_markers.pop_front();
+    return true;
+}
+
+void zynq7_addr_decoder::marker(uint32_t value)
+{
+    m_markers.push_back(value);
+    m_marker_event.notify();
+}
+
+zynq7_addr_decoder::mapping *zynq7_addr_decoder::decode(const tlm::tlm_generic_payload &trans)
+{
+    uint64_t addr = trans.get_address();
+
+    for (size_t i = 0; i < m_map.size(); ++i) {
+        if ((addr >= m_map[i].r.base) && (addr < m_map[i].r.base + m_map[i].r.size)) {
+            return &m_map[i];
+        }
+    }
+    return NULL;
+}
+
+unsigned int zynq7_addr_decoder::access(mapping &m, tlm::tlm_generic_payload &trans)
+{
+    if (m.r.kind == DECERR) {
+        trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+        return 0;
+    }
+    if ((m.r.kind == EXIT) || (m.r.kind == MARKER)) {
+        // Little endian value, reads return 0
+        unsigned int len = trans.get_data_length();
+        unsigned char *data = trans.get_data_ptr();
+        if (trans.is_read()) {
+            memset(data, 0, len);
+        } else if (trans.is_write()) {
+            uint32_t value = 0;
+            for (unsigned int i = 0; (i < len) && (i < sizeof(value)); ++i) {
+                value |= (uint32_t) data[i] << (8 * i);
+            }
+            if (m.r.kind == EXIT) {
+                m_exit_requested = true;
+                m_exit_status = (int) value;
+                m_exit_event.notify();
+            } else {
+                marker(value);
+            }
+        }
+        trans.set_response_status(tlm::TLM_OK_RESPONSE);
+        return len;
+    }
+    return m.mem->access(trans);
+}
+
+void zynq7_addr_decoder::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    mapping *m = decode(trans);
+
+    if (!m) {
+        init_socket->b_transport(trans, delay);
+        return;
+    }
+
+    if (m->r.kind == COUNTER) {
+        // Synchronized, the counters are all sampled at the time of the access
+        assert(m_counters);
+        wait(delay);
+        delay = SC_ZERO_TIME;
+        uint32_t value;
+        if (m_counters->access(trans, trans.get_address() - m->r.base, value)) {
+            marker(value);
+        }
+        m_local++;
+        return;
+    }
+    access(*m, trans);
+    if (m->r.kind == MEMORY) {
+        trans.set_dmi_allowed(true);
+        m_local++;
+    } else if (m->r.kind == DECERR) {
+        m_decerr++;
+    }
+}
+
+unsigned int zynq7_addr_decoder::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+    mapping *m = decode(trans);
+
+    if (!m) {
+        return init_socket->transport_dbg(trans);
+    }
+    if ((m->r.kind == EXIT) || (m->r.kind == MARKER) || (m->r.kind == COUNTER)) {
+        return 0;
+    }
+    return access(*m, trans);
+}
+
+// The memories grant their whole range, the rest is asked to the PL side
+bool zynq7_addr_decoder::get_direct_mem_ptr(tlm::tlm_generic_payload &trans, tlm::tlm_dmi &dmi_data)
+{
+    mapping *m = decode(trans);
+
+    if (!m) {
+        return init_socket->get_direct_mem_ptr(trans, dmi_data);
+    }
+    if (m->r.kind != MEMORY) {
+        return false;
+    }
+    m->mem->fill_dmi(dmi_data);
+    return true;
+}
+
+void zynq7_addr_decoder::invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range)
+{
+    tgt_socket->invalidate_direct_mem_ptr(start_range, end_range);
+}
+
+void zynq7_addr_decoder::print_summary(ostream &os) const
+{
+    os << m_port_name << " address decoder : " << m_local << " local accesses, "
+       << m_decerr << " decode errors" << endl;
+}
+
+void zynq7_addr_decoder::end_of_simulation(void)
+{
+    if (m_local || m_decerr) {
+        print_summary(cout);
+    }
+}
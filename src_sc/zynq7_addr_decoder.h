@@ -0,0 +1,142 @@
+/*
+ * Address decoder for Zynq Cosim
+ *
+ * Placed between the PS and the bridge of a master port (M_AXI_GP), it
+ * serves selected address ranges in SystemC instead of driving them on the
+ * PL : memories (e.g., in place of a BRAM scratchpad) and decode error
+ * responders (windows with nothing behind them, e.g., probed by a driver).
+ * Everything else goes to the PL. The memories grant DMI.
+ *
+ * The address map is given by a string, a comma separated list of
+ * kind:base:size with kind being mem or decerr, the addresses are the ones
+ * of the port, e.g., "mem:0x40000000:0x10000,decerr:0x41000000:0x1000000"
+ * A memory may be backed by a file and preloaded from an image (see
+ * zynq7_memory.h) : mem:base:size:file[:image], e.g.,
+ * "mem:0x40000000:0x800000:fb.bin,mem:0x42000000:0x10000::fw.bin"
+ * An exit region (kind exit) ends the simulation when the guest writes to
+ * it, the written value (up to 32 bits) is the exit status (see zynq7_exit.h)
+ * A marker region (kind marker) timestamps an event of the guest when it
+ * writes to it : the written value is logged with the time, appears in the
+ * timeline (see zynq7_timeline.h) and tags the dump of the AXI capture it
+ * triggers (see zynq7_axi_capture.h). The MARKER register of a counter
+ * region is the same marker
+ * A counter region (kind counter) exposes the simulated time, the FCLK
+ * cycles and the transactions of the ports to the guest (see
+ * zynq7_counters.h)
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_ADDR_DECODER_H__
+#define __ZYNQ7_ADDR_DECODER_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_memory.h"
+#include "zynq7_counters.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+class zynq7_addr_decoder : public sc_core::sc_module
+{
+public:
+    enum region_kind {
+        MEMORY,
+        DECERR,
+        EXIT,
+        MARKER,
+        COUNTER
+    };
+
+    struct region {
+        region_kind kind;
+        uint64_t base;
+        uint64_t size;
+        // MEMORY only (optional)
+        std::string file;
+        std::string image;
+    };
+
+    // Parses an address map (see above), returns false and sets error if it
+    // is malformed or if regions overlap
+    static bool parse(const std::string &descr, std::vector<region> &regions, std::string &error);
+
+    tlm_utils::simple_target_socket<zynq7_addr_decoder>    tgt_socket;
+    // To the PL (bridge)
+    tlm_utils::simple_initiator_socket<zynq7_addr_decoder> init_socket;
+
+    zynq7_addr_decoder(sc_core::sc_module_name name, const std::string &port_name,
+                       const std::vector<region> &regions);
+
+    // Notified when the guest writes to an exit region
+    const sc_core::sc_event &exit_event(void) const { return m_exit_event; }
+    bool exit_requested(void) const { return m_exit_requested; }
+    int exit_status(void) const { return m_exit_status; }
+    // Notified when the guest writes a marker (marker region or counter region)
+    const sc_core::sc_event &marker_event(void) const { return m_marker_event; }
+    // Oldest marker written and not taken yet, false if none
+    bool take_marker(uint32_t &value);
+    // Serves the counter regions
+    void set_counters(zynq7_counters *counters) { m_counters = counters; }
+
+    // Statistics
+    ///////////////
+    uint64_t local_accesses(void) const { return m_local; }
+    uint64_t decode_errors(void) const { return m_decerr; }
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    struct mapping {
+        region r;
+        zynq7_memory *mem; // MEMORY only
+    };
+
+    void b_transport(tlm::tlm_generic_payload &trans, sc_core::sc_time &delay);
+    unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans, tlm::tlm_dmi &dmi_data);
+    void invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range);
+
+    // Mapping of an access, NULL when it goes to the PL
+    mapping *decode(const tlm::tlm_generic_payload &trans);
+    // Serves an access to a local region, returns the number of bytes accessed
+    unsigned int access(mapping &m, tlm::tlm_generic_payload &trans);
+    void marker(uint32_t value);
+
+    std::string m_port_name;
+    std::vector<mapping> m_map;
+    sc_core::sc_event m_exit_event;
+    bool m_exit_requested;
+    int m_exit_status;
+    sc_core::sc_event m_marker_event;
+    std::deque<uint32_t> m_markers;
+    zynq7_counters *m_counters;
+
+    uint64_t m_local;
+    uint64_t m_decerr;
+};
+
+#endif /* __ZYNQ7_ADDR_DECODER_H__ */
@@ -0,0 +1,246 @@
+/*
+ * AXI capture for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_axi_capture.h"
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace sc_core;
+using namespace std;
+
+// Captured signals
+enum field_width { BIT, ADDR, LEN, ID };
+
+struct field {
+    const char *name;
+    field_width width;
+    size_t offset;
+};
+
+#define ZYNQ7_CAPTURE_FIELD(name, width) { #name, width, offsetof(zynq7_axi_sample, name) }
+static const field fields[] = {
+    ZYNQ7_CAPTURE_FIELD(awvalid, BIT),
+    ZYNQ7_CAPTURE_FIELD(awready, BIT),
+    ZYNQ7_CAPTURE_FIELD(awaddr,  ADDR),
+    ZYNQ7_CAPTURE_FIELD(awlen,   LEN),
+    ZYNQ7_CAPTURE_FIELD(awid,    ID),
+    ZYNQ7_CAPTURE_FIELD(wvalid,  BIT),
+    ZYNQ7_CAPTURE_FIELD(wready,  BIT),
+    ZYNQ7_CAPTURE_FIELD(wlast,   BIT),
+    ZYNQ7_CAPTURE_FIELD(bvalid,  BIT),
+    ZYNQ7_CAPTURE_FIELD(bready,  BIT),
+    ZYNQ7_CAPTURE_FIELD(bid,     ID),
+    ZYNQ7_CAPTURE_FIELD(arvalid, BIT),
+    ZYNQ7_CAPTURE_FIELD(arready, BIT),
+    ZYNQ7_CAPTURE_FIELD(araddr,  ADDR),
+    ZYNQ7_CAPTURE_FIELD(arlen,   LEN),
+    ZYNQ7_CAPTURE_FIELD(arid,    ID),
+    ZYNQ7_CAPTURE_FIELD(rvalid,  BIT),
+    ZYNQ7_CAPTURE_FIELD(rready,  BIT),
+    ZYNQ7_CAPTURE_FIELD(rlast,   BIT),
+    ZYNQ7_CAPTURE_FIELD(rid,     ID),
+};
+#undef ZYNQ7_CAPTURE_FIELD
+static const size_t nr_fields = sizeof(fields) / sizeof(fields[0]);
+
+static uint64_t field_value(const zynq7_axi_sample &s, const field &f)
+{
+    const char *p = (const char *) &s + f.offset;
+    return (f.width == BIT) ? *(const bool *) p : *(const uint64_t *) p;
+}
+
+// VCD identifier of a signal (printable characters)
+static string vcd_id(size_t n)
+{
+    string id;
+    do {
+        id += (char) ('!' + n % 94);
+        n /= 94;
+    } while (n);
+    return id;
+}
+
+zynq7_axi_capture::zynq7_axi_capture(sc_module_name name, unsigned int depth, const string &prefix) :
+    sc_module(name),
+    m_depth(depth),
+    m_prefix(prefix),
+    m_has_trigger_address(false),
+    m_trigger_address(0),
+    m_dumped(false),
+    m_dumps(0)
+{
+    assert(m_depth > 0);
+}
+
+int zynq7_axi_capture::add_port(const string &port_name, int addr_width, int len_width, int id_width)
+{
+    port p;
+
+    p.name = port_name;
+    p.addr_width = addr_width;
+    p.len_width = len_width;
+    p.id_width = id_width;
+    p.ring.resize(m_depth);
+    p.head = 0;
+    p.count = 0;
+    p.since_dump = 0;
+    m_ports.push_back(p);
+    return m_ports.size() - 1;
+}
+
+void zynq7_axi_capture::set_trigger_address(uint64_t addr)
+{
+    m_has_trigger_address = true;
+    m_trigger_address = addr;
+}
+
+void zynq7_axi_capture::record(int index, const zynq7_axi_sample &s)
+{
+    port &p = m_ports[index];
+    entry &e = p.ring[p.head];
+
+    e.time = sc_time_stamp().value();
+    e.s = s;
+    p.head = (p.head + 1) % m_depth;
+    if (p.count < m_depth) {
+        p.count++;
+    }
+    p.since_dump++;
+
+    if (m_has_trigger_address &&
+        ((s.awvalid && s.awready && (s.awaddr == m_trigger_address)) ||
+         (s.arvalid && s.arready && (s.araddr == m_trigger_address)))) {
+        ostringstream oss;
+        oss << p.name << " access to 0x" << hex << m_trigger_address;
+        trigger(oss.str());
+    }
+}
+
+void zynq7_axi_capture::trigger(const string &reason)
+{
+    // The window must have been renewed since the previous dump
+    bool renewed = !m_dumped;
+    for (size_t i = 0; i < m_ports.size(); ++i) {
+        renewed = renewed || (m_ports[i].since_dump >= m_depth);
+    }
+    if (!renewed) {
+        return;
+    }
+
+    ostringstream file_name;
+    file_name << m_prefix << "_" << m_dumps << ".vcd";
+    ofstream os(file_name.str().c_str());
+    if (!os) {
+        perror(file_name.str().c_str());
+        return;
+    }
+    write_vcd(os, reason);
+
+    cout << sc_time_stamp() << " AXI capture (" << reason << ") written to " << file_name.str() << endl;
+    m_dumped = true;
+    m_dumps++;
+    for (size_t i = 0; i < m_ports.size(); ++i) {
+        m_ports[i].since_dump = 0;
+    }
+}
+
+struct capture_event {
+    uint64_t time;
+    size_t port;
+    const zynq7_axi_sample *s;
+
+    bool operator<(const capture_event &other) const { return time < other.time; }
+};
+
+void zynq7_axi_capture::write_vcd(ostream &os, const string &reason)
+{
+    vector<capture_event> events;
+
+    // Header, one scope per port
+    os << "$comment " << reason << " at " << sc_time_stamp() << " $end" << endl;
+    os << "$timescale " << sc_get_time_resolution() << " $end" << endl;
+    os << "$scope module " << name() << " $end" << endl;
+    for (size_t i = 0; i < m_ports.size(); ++i) {
+        const port &p = m_ports[i];
+        const int widths[] = {1, p.addr_width, p.len_width, p.id_width};
+        os << "$scope module " << p.name << " $end" << endl;
+        for (size_t f = 0; f < nr_fields; ++f) {
+            os << "$var wire " << widths[fields[f].width] << " " << vcd_id(i * nr_fields + f)
+               << " " << fields[f].name << " $end" << endl;
+        }
+        os << "$upscope $end" << endl;
+
+        // Oldest entry first
+        size_t first = (p.head + m_depth - p.count) % m_depth;
+        for (size_t n = 0; n < p.count; ++n) {
+            const entry &e = p.ring[(first + n) % m_depth];
+            capture_event ev = {e.time, i, &e.s};
+            events.push_back(ev);
+        }
+    }
+    os << "$upscope $end" << endl;
+    os << "$enddefinitions $end" << endl;
+
+    // Value changes in time order
+    stable_sort(events.begin(), events.end());
+    vector<const zynq7_axi_sample *> last(m_ports.size(), (const zynq7_axi_sample *) NULL);
+    bool has_time = false;
+    uint64_t time = 0;
+    for (size_t n = 0; n < events.size(); ++n) {
+        const capture_event &ev = events[n];
+        const port &p = m_ports[ev.port];
+        const int widths[] = {1, p.addr_width, p.len_width, p.id_width};
+
+        if (!has_time || (ev.time != time)) {
+            os << "#" << ev.time << endl;
+            has_time = true;
+            time = ev.time;
+        }
+        for (size_t f = 0; f < nr_fields; ++f) {
+            uint64_t value = field_value(*ev.s, fields[f]);
+            if (last[ev.port] && (value == field_value(*last[ev.port], fields[f]))) {
+                continue;
+            }
+            string id = vcd_id(ev.port * nr_fields + f);
+            if (fields[f].width == BIT) {
+                os << value << id << endl;
+            } else {
+                os << "b";
+                for (int b = widths[fields[f].width] - 1; b >= 0; --b) {
+                    os << ((b < 64) ? ((value >> b) & 1) : 0);
+                }
+                os << " " << id << endl;
+            }
+        }
+        last[ev.port] = ev.s;
+    }
+}
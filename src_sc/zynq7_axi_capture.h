@@ -0,0 +1,104 @@
+/*
+ * AXI capture for Zynq Cosim
+ *
+ * Keeps the last cycles of the AXI channels of the enabled ports in memory
+ * (ring buffers filled by the port checkers, see zynq7_axi_checker.h) and
+ * writes them to a VCD file only when a trigger fires : protocol violation
+ * or watchdog, access to a given address, interrupt edge or marker written
+ * by the guest. The simulation runs without waveform logging and the last
+ * cycles before an event can still be looked at.
+ *
+ * The handshake, address, length, ID and last signals are captured (not the
+ * data). Every trigger writes a new file (prefix_N.vcd), the triggers firing
+ * before the window has been renewed since the previous dump are ignored.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_AXI_CAPTURE_H__
+#define __ZYNQ7_AXI_CAPTURE_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Pins of an AXI port on a rising edge of its clock (payload only valid with VALID)
+struct zynq7_axi_sample {
+    bool awvalid, awready;
+    uint64_t awaddr, awlen, awid;
+    bool wvalid, wready, wlast;
+    bool bvalid, bready;
+    uint64_t bid;
+    bool arvalid, arready;
+    uint64_t araddr, arlen, arid;
+    bool rvalid, rready, rlast;
+    uint64_t rid;
+};
+
+class zynq7_axi_capture : public sc_core::sc_module
+{
+public:
+    // depth in cycles (per port), files are named prefix_N.vcd
+    zynq7_axi_capture(sc_core::sc_module_name name, unsigned int depth, const std::string &prefix);
+
+    // Adds a port, returns its index (for record)
+    int add_port(const std::string &port_name, int addr_width, int len_width, int id_width);
+
+    // Triggers on an address or write handshake with the given address
+    void set_trigger_address(uint64_t addr);
+
+    void record(int port, const zynq7_axi_sample &s);
+
+    // Writes the window to a new file (see above)
+    void trigger(const std::string &reason);
+
+private:
+    struct entry {
+        uint64_t time; // In time resolution units
+        zynq7_axi_sample s;
+    };
+
+    struct port {
+        std::string name;
+        int addr_width;
+        int len_width;
+        int id_width;
+        std::vector<entry> ring;
+        size_t head;  // Next entry
+        size_t count; // Valid entries
+        uint64_t since_dump; // Entries recorded since the last dump
+    };
+
+    void write_vcd(std::ostream &os, const std::string &reason);
+
+    unsigned int m_depth;
+    std::string m_prefix;
+    std::vector<port> m_ports;
+    bool m_has_trigger_address;
+    uint64_t m_trigger_address;
+    bool m_dumped;
+    unsigned int m_dumps;
+};
+
+#endif /* __ZYNQ7_AXI_CAPTURE_H__ */
@@ -0,0 +1,283 @@
+/*
+ * AXI protocol checker for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_axi_checker.h"
+
+#include <string.h>
+
+#include <iostream>
+#include <sstream>
+
+using namespace sc_core;
+using namespace std;
+
+// Channels, index of m_valid_since
+enum { AW, W, B, AR, R };
+static const char *channel_names[] = {"AW", "W", "B", "AR", "R"};
+
+zynq7_axi_checker_base::zynq7_axi_checker_base(sc_module_name name, const string &port_name,
+                                               bool checks, uint64_t watchdog_cycles) :
+    sc_module(name),
+    m_port_name(port_name),
+    m_checks(checks),
+    m_watchdog(watchdog_cycles),
+    m_exit(NULL),
+    m_capture(NULL),
+    m_capture_port(0),
+    m_violations(0)
+{
+    reset();
+}
+
+void zynq7_axi_checker_base::set_capture(zynq7_axi_capture *capture,
+                                         int addr_width, int len_width, int id_width)
+{
+    m_capture = capture;
+    m_capture_port = capture->add_port(m_port_name, addr_width, len_width, id_width);
+}
+
+void zynq7_axi_checker_base::reset(void)
+{
+    m_cycle = 0;
+    memset(&m_prev, 0, sizeof(m_prev));
+    memset(m_valid_since, 0, sizeof(m_valid_since));
+    m_aw_pending.clear();
+    m_w_pending.clear();
+    m_w_beats = 0;
+    m_b_pending.clear();
+    m_r_pending.clear();
+}
+
+void zynq7_axi_checker_base::check(const sample &s)
+{
+    if (m_capture) {
+        m_capture->record(m_capture_port, s);
+    }
+    // Once stopped, nothing more to say
+    if (!m_checks || m_violations) {
+        return;
+    }
+    m_cycle++;
+
+    check_stable(s);
+    check_write(s);
+    check_read(s);
+    if (m_watchdog && ((m_cycle & 1023) == 0)) {
+        check_watchdog();
+    }
+    m_prev = s;
+}
+
+// A channel with VALID and without READY on the previous edge must hold
+void zynq7_axi_checker_base::check_stable(const sample &s)
+{
+    const sample &p = m_prev;
+    const bool waiting[] = {
+        p.awvalid && !p.awready, p.wvalid && !p.wready, p.bvalid && !p.bready,
+        p.arvalid && !p.arready, p.rvalid && !p.rready
+    };
+    const bool valid[] = {s.awvalid, s.wvalid, s.bvalid, s.arvalid, s.rvalid};
+    const bool stable[] = {
+        (s.awaddr == p.awaddr) && (s.awlen == p.awlen) && (s.awid == p.awid),
+        s.wlast == p.wlast,
+        s.bid == p.bid,
+        (s.araddr == p.araddr) && (s.arlen == p.arlen) && (s.arid == p.arid),
+        (s.rid == p.rid) && (s.rlast == p.rlast)
+    };
+
+    for (int c = AW; c <= R; ++c) {
+        if (waiting[c] && !valid[c]) {
+            violation(string(channel_names[c]) + "VALID deasserted before " + channel_names[c] + "READY");
+            return;
+        }
+        if (waiting[c] && !stable[c]) {
+            violation(string(channel_names[c]) + " payload changed before " + channel_names[c] + "READY");
+            return;
+        }
+        if (valid[c] && !waiting[c]) {
+            m_valid_since[c] = m_cycle;
+        }
+    }
+}
+
+void zynq7_axi_checker_base::check_write(const sample &s)
+{
+    ostringstream oss;
+
+    if (s.awvalid && s.awready) {
+        burst b = {s.awid, s.awlen + 1, 0, m_cycle};
+        if (m_w_pending.empty()) {
+            m_aw_pending.push_back(b);
+        } else {
+            // The data came first
+            if (m_w_pending.front() != b.len) {
+                oss << "W burst of " << m_w_pending.front() << " beats for AWLEN " << s.awlen
+                    << " (AWID 0x" << hex << s.awid << ")";
+                violation(oss.str());
+                return;
+            }
+            m_w_pending.pop_front();
+            m_b_pending[b.id].push_back(b);
+        }
+    }
+
+    if (s.wvalid && s.wready) {
+        m_w_beats++;
+        bool has_aw = !m_aw_pending.empty();
+        uint64_t len = has_aw ? m_aw_pending.front().len : 0;
+        if (has_aw && (m_w_beats == len) && !s.wlast) {
+            oss << "missing WLAST on beat " << m_w_beats << " (AWID 0x" << hex
+                << m_aw_pending.front().id << ")";
+            violation(oss.str());
+            return;
+        }
+        if (s.wlast) {
+            if (!has_aw) {
+                m_w_pending.push_back(m_w_beats);
+            } else if (m_w_beats != len) {
+                oss << "WLAST on beat " << m_w_beats << " of " << len << " (AWID 0x" << hex
+                    << m_aw_pending.front().id << ")";
+                violation(oss.str());
+                return;
+            } else {
+                m_b_pending[m_aw_pending.front().id].push_back(m_aw_pending.front());
+                m_aw_pending.pop_front();
+            }
+            m_w_beats = 0;
+        }
+    }
+
+    if (s.bvalid && s.bready) {
+        by_id_t::iterator it = m_b_pending.find(s.bid);
+        if ((it == m_b_pending.end()) || it->second.empty()) {
+            oss << "write response for BID 0x" << hex << s.bid << " without a complete write";
+            violation(oss.str());
+            return;
+        }
+        it->second.pop_front();
+    }
+}
+
+void zynq7_axi_checker_base::check_read(const sample &s)
+{
+    ostringstream oss;
+
+    if (s.arvalid && s.arready) {
+        burst b = {s.arid, s.arlen + 1, 0, m_cycle};
+        m_r_pending[b.id].push_back(b);
+    }
+
+    if (s.rvalid && s.rready) {
+        by_id_t::iterator it = m_r_pending.find(s.rid);
+        if ((it == m_r_pending.end()) || it->second.empty()) {
+            oss << "read data for RID 0x" << hex << s.rid << " without an outstanding read";
+            violation(oss.str());
+            return;
+        }
+        // Oldest read of the ID
+        burst &b = it->second.front();
+        b.beats++;
+        if (s.rlast != (b.beats == b.len)) {
+            oss << (s.rlast ? "RLAST on beat " : "missing RLAST on beat ") << b.beats
+                << " of " << b.len << " (RID 0x" << hex << s.rid << ")";
+            violation(oss.str());
+            return;
+        }
+        if (s.rlast) {
+            it->second.pop_front();
+        }
+    }
+}
+
+void zynq7_axi_checker_base::oldest(const by_id_t &bursts, const char *what,
+                                    uint64_t &cycle, string &descr) const
+{
+    for (by_id_t::const_iterator it = bursts.begin(); it != bursts.end(); ++it) {
+        if (!it->second.empty() && (it->second.front().start < cycle)) {
+            ostringstream oss;
+            cycle = it->second.front().start;
+            oss << what << " ID 0x" << hex << it->first;
+            descr = oss.str();
+        }
+    }
+}
+
+void zynq7_axi_checker_base::check_watchdog(void)
+{
+    const bool waiting[] = {
+        m_prev.awvalid && !m_prev.awready, m_prev.wvalid && !m_prev.wready,
+        m_prev.bvalid && !m_prev.bready, m_prev.arvalid && !m_prev.arready,
+        m_prev.rvalid && !m_prev.rready
+    };
+    uint64_t cycle = m_cycle;
+    string descr;
+
+    for (int c = AW; c <= R; ++c) {
+        if (waiting[c] && (m_valid_since[c] < cycle)) {
+            cycle = m_valid_since[c];
+            descr = string(channel_names[c]) + "VALID waiting for " + channel_names[c] + "READY";
+        }
+    }
+    if (!m_aw_pending.empty() && (m_aw_pending.front().start < cycle)) {
+        cycle = m_aw_pending.front().start;
+        descr = "write waiting for its data";
+    }
+    oldest(m_b_pending, "write response for", cycle, descr);
+    oldest(m_r_pending, "read data for", cycle, descr);
+
+    if (m_cycle - cycle > m_watchdog) {
+        ostringstream oss;
+        oss << "watchdog : " << descr << " for " << (m_cycle - cycle) << " cycles";
+        violation(oss.str());
+    }
+}
+
+void zynq7_axi_checker_base::violation(const string &msg)
+{
+    m_violations++;
+
+    cerr << sc_time_stamp() << " " << m_port_name << " AXI checker (cycle " << m_cycle << ") : "
+         << msg << endl;
+    cerr << "  outstanding : " << m_aw_pending.size() << " writes without data, "
+         << m_w_pending.size() << " data without address";
+    size_t writes = 0, reads = 0;
+    for (by_id_t::const_iterator it = m_b_pending.begin(); it != m_b_pending.end(); ++it) {
+        writes += it->second.size();
+    }
+    for (by_id_t::const_iterator it = m_r_pending.begin(); it != m_r_pending.end(); ++it) {
+        reads += it->second.size();
+    }
+    cerr << ", " << writes << " writes waiting for a response, " << reads << " reads" << endl;
+
+    if (m_capture) {
+        m_capture->trigger(m_port_name + " " + msg);
+    }
+    if (m_exit) {
+        m_exit->request(FAILURE_STATUS, m_port_name + " AXI checker");
+    } else {
+        sc_stop();
+    }
+}
@@ -0,0 +1,193 @@
+/*
+ * AXI protocol checker for Zynq Cosim
+ *
+ * Watches the pins of an AXI port (both directions) on the rising edges of
+ * its clock and stops the simulation with a diagnostic on the first
+ * violation, instead of letting the bridge (and QEMU) hang :
+ * - VALID must stay asserted, and the payload stable, until READY
+ * - the number of W and R beats must match AxLEN, with xLAST on the last one
+ * - a response (B, R) must match an outstanding request with the same ID,
+ *   responses of a same ID come in order
+ * - watchdog : no transaction outstanding (or VALID waiting for READY) for
+ *   longer than a number of cycles
+ * Only the handshake signals are read on every cycle, the payload when VALID
+ * is asserted, the watchdog is evaluated every 1024 cycles.
+ *
+ * The samples of the pins can also be recorded for a post-mortem capture
+ * (see zynq7_axi_capture.h), with or without the checks.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_AXI_CHECKER_H__
+#define __ZYNQ7_AXI_CHECKER_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_exit.h"
+#include "zynq7_axi_capture.h"
+
+#include <deque>
+#include <map>
+#include <string>
+
+// Checks, independent of the widths of the port
+class zynq7_axi_checker_base : public sc_core::sc_module
+{
+public:
+    // Exit status of the simulator on a violation
+    static const int FAILURE_STATUS = 1;
+
+    // Without checks the pins are only recorded (capture), a zero watchdog disables it
+    zynq7_axi_checker_base(sc_core::sc_module_name name, const std::string &port_name,
+                           bool checks, uint64_t watchdog_cycles);
+
+    // The simulation is ended through exit (NULL : sc_stop only)
+    void set_exit(zynq7_exit *exit) { m_exit = exit; }
+    // Records the pins on every cycle, a violation triggers the capture
+    void set_capture(zynq7_axi_capture *capture, int addr_width, int len_width, int id_width);
+
+    uint64_t violations(void) const { return m_violations; }
+
+protected:
+    // Pins of the port on a rising edge of the clock
+    typedef zynq7_axi_sample sample;
+
+    void check(const sample &s);
+    void reset(void);
+
+private:
+    struct burst {
+        uint64_t id;
+        uint64_t len;   // AxLEN + 1
+        uint64_t beats; // R beats received
+        uint64_t start; // Cycle of the address handshake
+    };
+    typedef std::map<uint64_t, std::deque<burst> > by_id_t;
+
+    void check_stable(const sample &s);
+    void check_write(const sample &s);
+    void check_read(const sample &s);
+    void check_watchdog(void);
+    void oldest(const by_id_t &bursts, const char *what, uint64_t &cycle, std::string &descr) const;
+    void violation(const std::string &msg);
+
+    std::string m_port_name;
+    bool m_checks;
+    uint64_t m_watchdog;
+    zynq7_exit *m_exit;
+    zynq7_axi_capture *m_capture;
+    int m_capture_port;
+
+    uint64_t m_cycle;
+    sample m_prev;
+    // Cycle at which VALID was asserted on AW, W, B, AR, R (waiting for READY)
+    uint64_t m_valid_since[5];
+
+    // Writes : address without all the data, data without address, then waiting for B
+    std::deque<burst> m_aw_pending;
+    std::deque<uint64_t> m_w_pending; // Beats of complete W bursts
+    uint64_t m_w_beats;               // Of the current W burst
+    by_id_t m_b_pending;
+    // Reads
+    by_id_t m_r_pending;
+
+    uint64_t m_violations;
+};
+
+template <class PORT>
+class zynq7_axi_checker : public zynq7_axi_checker_base
+{
+public:
+    sc_core::sc_in<bool> clk;
+    sc_core::sc_in<bool> resetn;
+
+    sc_core::sc_in<bool> awvalid;
+    sc_core::sc_in<bool> awready;
+    sc_core::sc_in<sc_dt::sc_bv<PORT::addr_width> > awaddr;
+    sc_core::sc_in<sc_dt::sc_bv<PORT::axlen_width> > awlen;
+    sc_core::sc_in<sc_dt::sc_bv<PORT::id_width> > awid;
+
+    sc_core::sc_in<bool> wvalid;
+    sc_core::sc_in<bool> wready;
+    sc_core::sc_in<bool> wlast;
+
+    sc_core::sc_in<bool> bvalid;
+    sc_core::sc_in<bool> bready;
+    sc_core::sc_in<sc_dt::sc_bv<PORT::id_width> > bid;
+
+    sc_core::sc_in<bool> arvalid;
+    sc_core::sc_in<bool> arready;
+    sc_core::sc_in<sc_dt::sc_bv<PORT::addr_width> > araddr;
+    sc_core::sc_in<sc_dt::sc_bv<PORT::axlen_width> > arlen;
+    sc_core::sc_in<sc_dt::sc_bv<PORT::id_width> > arid;
+
+    sc_core::sc_in<bool> rvalid;
+    sc_core::sc_in<bool> rready;
+    sc_core::sc_in<bool> rlast;
+    sc_core::sc_in<sc_dt::sc_bv<PORT::id_width> > rid;
+
+    SC_HAS_PROCESS(zynq7_axi_checker);
+
+    zynq7_axi_checker(sc_core::sc_module_name name, bool checks, uint64_t watchdog_cycles) :
+        zynq7_axi_checker_base(name, PORT::name(), checks, watchdog_cycles)
+    {
+        SC_METHOD(clock);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+private:
+    void clock(void)
+    {
+        sample s;
+
+        if (!resetn.read()) {
+            reset();
+            return;
+        }
+
+        s.awvalid = awvalid.read();
+        s.awready = awready.read();
+        s.awaddr = s.awvalid ? awaddr.read().to_uint64() : 0;
+        s.awlen = s.awvalid ? awlen.read().to_uint64() : 0;
+        s.awid = s.awvalid ? awid.read().to_uint64() : 0;
+        s.wvalid = wvalid.read();
+        s.wready = wready.read();
+        s.wlast = s.wvalid && wlast.read();
+        s.bvalid = bvalid.read();
+        s.bready = bready.read();
+        s.bid = s.bvalid ? bid.read().to_uint64() : 0;
+        s.arvalid = arvalid.read();
+        s.arready = arready.read();
+        s.araddr = s.arvalid ? araddr.read().to_uint64() : 0;
+        s.arlen = s.arvalid ? arlen.read().to_uint64() : 0;
+        s.arid = s.arvalid ? arid.read().to_uint64() : 0;
+        s.rvalid = rvalid.read();
+        s.rready = rready.read();
+        s.rlast = s.rvalid && rlast.read();
+        s.rid = s.rvalid ? rid.read().to_uint64() : 0;
+
+        check(s);
+    }
+};
+
+#endif /* __ZYNQ7_AXI_CHECKER_H__ */
@@ -0,0 +1,299 @@
+/*
+ * AXI4-Lite bridge for Zynq Cosim
+ *
+ * TLM to AXI bridge for the M_AXI_GP ports when the slaves in the PL are
+ * AXI4-Lite (e.g., register files), in place of the full tlm2axi_bridge.
+ * Only the address, data, strobe and response signals are driven on every
+ * access, the others (ID, burst, length, lock, cache, QoS, region, prot) are
+ * tied off once at the start of the simulation and BREADY, RREADY and WLAST
+ * are held high.
+ *
+ * Every transaction is split in single beats of the width of the bus (no
+ * bursts), one beat at a time. The bridge waits on the clock only during a
+ * transaction. No DMI nor debug transport, streaming transactions are
+ * rejected.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_AXI_LITE_BRIDGE_H__
+#define __ZYNQ7_AXI_LITE_BRIDGE_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <algorithm>
+
+// The ports have the same names and types as the ones of tlm2axi_bridge so
+// they are bound the same way (ZYNQ7_PS_BIND_AXI)
+template <int ADDR_WIDTH, int DATA_WIDTH, int ID_WIDTH, int AXLEN_WIDTH, int AXLOCK_WIDTH>
+class zynq7_axi_lite_bridge : public sc_core::sc_module
+{
+public:
+    static const unsigned int BYTES = DATA_WIDTH / 8;
+
+    tlm_utils::simple_target_socket<zynq7_axi_lite_bridge> tgt_socket;
+
+    sc_core::sc_in<bool> clk;
+    sc_core::sc_in<bool> resetn;
+
+    /* Write address channel */
+    sc_core::sc_out<bool>                              awvalid;
+    sc_core::sc_in<bool>                               awready;
+    sc_core::sc_out<sc_dt::sc_bv<ADDR_WIDTH> >         awaddr;
+    sc_core::sc_out<sc_dt::sc_bv<3> >                  awprot;
+    sc_core::sc_out<sc_dt::sc_bv<4> >                  awregion;
+    sc_core::sc_out<sc_dt::sc_bv<4> >                  awqos;
+    sc_core::sc_out<sc_dt::sc_bv<4> >                  awcache;
+    sc_core::sc_out<sc_dt::sc_bv<2> >                  awburst;
+    sc_core::sc_out<sc_dt::sc_bv<3> >                  awsize;
+    sc_core::sc_out<sc_dt::sc_bv<AXLEN_WIDTH> >        awlen;
+    sc_core::sc_out<sc_dt::sc_bv<ID_WIDTH> >           awid;
+    sc_core::sc_out<sc_dt::sc_bv<AXLOCK_WIDTH> >       awlock;
+
+    /* Write data channel */
+    sc_core::sc_out<bool>                              wvalid;
+    sc_core::sc_in<bool>                               wready;
+    sc_core::sc_out<sc_dt::sc_bv<DATA_WIDTH> >         wdata;
+    sc_core::sc_out<sc_dt::sc_bv<DATA_WIDTH / 8> >     wstrb;
+    sc_core::sc_out<bool>                              wlast;
+
+    /* Write response channel */
+    sc_core::sc_in<bool>                               bvalid;
+    sc_core::sc_out<bool>                              bready;
+    sc_core::sc_in<sc_dt::sc_bv<2> >                   bresp;
+    sc_core::sc_in<sc_dt::sc_bv<ID_WIDTH> >            bid;
+
+    /* Read address channel */
+    sc_core::sc_out<bool>                              arvalid;
+    sc_core::sc_in<bool>                               arready;
+    sc_core::sc_out<sc_dt::sc_bv<ADDR_WIDTH> >         araddr;
+    sc_core::sc_out<sc_dt::sc_bv<3> >                  arprot;
+    sc_core::sc_out<sc_dt::sc_bv<4> >                  arregion;
+    sc_core::sc_out<sc_dt::sc_bv<4> >                  arqos;
+    sc_core::sc_out<sc_dt::sc_bv<4> >                  arcache;
+    sc_core::sc_out<sc_dt::sc_bv<2> >                  arburst;
+    sc_core::sc_out<sc_dt::sc_bv<3> >                  arsize;
+    sc_core::sc_out<sc_dt::sc_bv<AXLEN_WIDTH> >        arlen;
+    sc_core::sc_out<sc_dt::sc_bv<ID_WIDTH> >           arid;
+    sc_core::sc_out<sc_dt::sc_bv<AXLOCK_WIDTH> >       arlock;
+
+    /* Read data channel */
+    sc_core::sc_in<bool>                               rvalid;
+    sc_core::sc_out<bool>                              rready;
+    sc_core::sc_in<sc_dt::sc_bv<DATA_WIDTH> >          rdata;
+    sc_core::sc_in<sc_dt::sc_bv<2> >                   rresp;
+    sc_core::sc_in<sc_dt::sc_bv<ID_WIDTH> >            rid;
+    sc_core::sc_in<bool>                               rlast;
+
+    SC_HAS_PROCESS(zynq7_axi_lite_bridge);
+
+    zynq7_axi_lite_bridge(sc_core::sc_module_name name) :
+        sc_module(name),
+        tgt_socket("tgt_socket"),
+        clk("clk"), resetn("resetn"),
+        awvalid("awvalid"), awready("awready"), awaddr("awaddr"), awprot("awprot"),
+        awregion("awregion"), awqos("awqos"), awcache("awcache"), awburst("awburst"),
+        awsize("awsize"), awlen("awlen"), awid("awid"), awlock("awlock"),
+        wvalid("wvalid"), wready("wready"), wdata("wdata"), wstrb("wstrb"), wlast("wlast"),
+        bvalid("bvalid"), bready("bready"), bresp("bresp"), bid("bid"),
+        arvalid("arvalid"), arready("arready"), araddr("araddr"), arprot("arprot"),
+        arregion("arregion"), arqos("arqos"), arcache("arcache"), arburst("arburst"),
+        arsize("arsize"), arlen("arlen"), arid("arid"), arlock("arlock"),
+        rvalid("rvalid"), rready("rready"), rdata("rdata"), rresp("rresp"), rid("rid"),
+        rlast("rlast"),
+        m_busy(false)
+    {
+        tgt_socket.register_b_transport(this, &zynq7_axi_lite_bridge::b_transport);
+
+        // Runs once (no sensitivity)
+        SC_METHOD(tie_off);
+    }
+
+private:
+    void tie_off(void)
+    {
+        int size = 0;
+        while ((1u << size) < BYTES) {
+            size++;
+        }
+
+        // Single beat, normal non-cacheable bufferable, unprivileged secure data access
+        awvalid.write(false);
+        awprot.write(0);
+        awregion.write(0);
+        awqos.write(0);
+        awcache.write(3);
+        awburst.write(1); // INCR
+        awsize.write(size);
+        awlen.write(0);
+        awid.write(0);
+        awlock.write(0);
+        wvalid.write(false);
+        wlast.write(true);
+        bready.write(true);
+        arvalid.write(false);
+        arprot.write(0);
+        arregion.write(0);
+        arqos.write(0);
+        arcache.write(3);
+        arburst.write(1);
+        arsize.write(size);
+        arlen.write(0);
+        arid.write(0);
+        arlock.write(0);
+        rready.write(true);
+    }
+
+    // OKAY and EXOKAY, SLVERR, DECERR
+    static tlm::tlm_response_status response(unsigned int resp)
+    {
+        switch (resp) {
+        case 2:
+            return tlm::TLM_GENERIC_ERROR_RESPONSE;
+        case 3:
+            return tlm::TLM_ADDRESS_ERROR_RESPONSE;
+        default:
+            return tlm::TLM_OK_RESPONSE;
+        }
+    }
+
+    // The pins are sampled on the rising edges, as the slave sees them
+    void edge(void)
+    {
+        wait(clk.posedge_event());
+    }
+
+    tlm::tlm_response_status write_beat(sc_dt::uint64 addr, unsigned int offset,
+                                        const unsigned char *data, const bool *enabled,
+                                        unsigned int len)
+    {
+        sc_dt::sc_bv<DATA_WIDTH> d(0);
+        sc_dt::sc_bv<DATA_WIDTH / 8> strb(0);
+        bool aw_done = false;
+        bool w_done = false;
+
+        for (unsigned int i = 0; i < len; ++i) {
+            if (enabled[i]) {
+                d.range((offset + i) * 8 + 7, (offset + i) * 8) = data[i];
+                strb[offset + i] = 1;
+            }
+        }
+
+        awaddr.write(addr);
+        awvalid.write(true);
+        wdata.write(d);
+        wstrb.write(strb);
+        wvalid.write(true);
+        while (!aw_done || !w_done) {
+            edge();
+            if (!aw_done && awready.read()) {
+                awvalid.write(false);
+                aw_done = true;
+            }
+            if (!w_done && wready.read()) {
+                wvalid.write(false);
+                w_done = true;
+            }
+        }
+
+        do {
+            edge();
+        } while (!bvalid.read());
+        return response(bresp.read().to_uint());
+    }
+
+    tlm::tlm_response_status read_beat(sc_dt::uint64 addr, unsigned int offset,
+                                       unsigned char *data, unsigned int len)
+    {
+        araddr.write(addr);
+        arvalid.write(true);
+        do {
+            edge();
+        } while (!arready.read());
+        arvalid.write(false);
+
+        do {
+            edge();
+        } while (!rvalid.read());
+
+        sc_dt::sc_bv<DATA_WIDTH> d = rdata.read();
+        for (unsigned int i = 0; i < len; ++i) {
+            data[i] = d.range((offset + i) * 8 + 7, (offset + i) * 8).to_uint();
+        }
+        return response(rresp.read().to_uint());
+    }
+
+    void b_transport(tlm::tlm_generic_payload &trans, sc_core::sc_time &delay)
+    {
+        unsigned int len = trans.get_data_length();
+        unsigned char *data = trans.get_data_ptr();
+        unsigned char *be = trans.get_byte_enable_ptr();
+        unsigned int be_len = trans.get_byte_enable_length();
+        sc_dt::uint64 addr = trans.get_address();
+        tlm::tlm_response_status status = tlm::TLM_OK_RESPONSE;
+
+        if (trans.get_streaming_width() < len) {
+            trans.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+            return;
+        }
+
+        // The annotated time is spent before the access
+        wait(delay);
+        delay = sc_core::SC_ZERO_TIME;
+
+        while (m_busy) {
+            wait(m_free_event);
+        }
+        m_busy = true;
+
+        while (!resetn.read()) {
+            wait(resetn.posedge_event());
+        }
+        // Driven just after an edge, as clocked logic would
+        edge();
+
+        for (unsigned int pos = 0; (pos < len) && (status == tlm::TLM_OK_RESPONSE); ) {
+            unsigned int offset = (addr + pos) % BYTES;
+            unsigned int n = std::min(BYTES - offset, len - pos);
+
+            if (trans.is_write()) {
+                bool enabled[BYTES];
+                for (unsigned int i = 0; i < n; ++i) {
+                    enabled[i] = !be || (be[(pos + i) % be_len] == TLM_BYTE_ENABLED);
+                }
+                status = write_beat(addr + pos, offset, data + pos, enabled, n);
+            } else {
+                status = read_beat(addr + pos, offset, data + pos, n);
+            }
+            pos += n;
+        }
+        trans.set_response_status(status);
+
+        m_busy = false;
+        m_free_event.notify();
+    }
+
+    bool m_busy;
+    sc_core::sc_event m_free_event;
+};
+
+#endif /* __ZYNQ7_AXI_LITE_BRIDGE_H__ */
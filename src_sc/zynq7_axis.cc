@@ -0,0 +1,270 @@
+/*
+ * AXI-Stream source and sink for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_axis.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace sc_core;
+using namespace sc_dt;
+using namespace std;
+
+SC_MODULE_EXPORT(zynq7_axis_source);
+SC_MODULE_EXPORT(zynq7_axis_sink);
+
+// Statistics
+///////////////
+
+zynq7_axis_stats::zynq7_axis_stats() :
+    m_beats(0),
+    m_bytes(0),
+    m_packets(0),
+    m_stalls(0)
+{
+}
+
+void zynq7_axis_stats::beat(unsigned int bytes, bool last)
+{
+    if (!m_beats) {
+        m_first = sc_time_stamp();
+    }
+    m_last = sc_time_stamp();
+    m_beats++;
+    m_bytes += bytes;
+    if (last) {
+        m_packets++;
+    }
+}
+
+void zynq7_axis_stats::print(ostream &os, const string &name) const
+{
+    os << name << " : " << m_beats << " beats, " << m_bytes << " bytes, " << m_packets
+       << " packets, " << m_stalls << " stalls";
+    // From the first to the last beat
+    if (m_last > m_first) {
+        os << ", " << (m_bytes / (m_last - m_first).to_seconds() / 1e6) << " MB/s over "
+           << (m_last - m_first);
+    }
+    os << endl;
+}
+
+// Source
+///////////
+
+zynq7_axis_source::zynq7_axis_source(sc_module_name name) :
+    SC_INIT_GENERIC_STRING(FILE_G),
+    SC_INIT_GENERIC_INT(PACKET_IN_BEATS_G),
+    aclk("aclk"),
+    aresetn("aresetn"),
+    m_axis_tvalid("m_axis_tvalid"),
+    m_axis_tready("m_axis_tready"),
+    m_axis_tdata("m_axis_tdata"),
+    m_axis_tkeep("m_axis_tkeep"),
+    m_axis_tlast("m_axis_tlast"),
+    m_data(NULL),
+    m_size(0),
+    m_pos(0),
+    m_beat(0),
+    m_valid(false),
+    m_last(false)
+{
+    if (!FILE_G.empty()) {
+        int fd = open(FILE_G.c_str(), O_RDONLY);
+        struct stat st;
+        if ((fd < 0) || (fstat(fd, &st) < 0)) {
+            perror(FILE_G.c_str());
+            for(;;);
+        }
+        m_size = st.st_size;
+        if (m_size) {
+            void *data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                perror("mmap");
+                for(;;);
+            }
+            madvise(data, m_size, MADV_SEQUENTIAL);
+            m_data = (const unsigned char *) data;
+        }
+        close(fd);
+    }
+
+    SC_METHOD(clock);
+    sensitive << aclk.pos();
+    dont_initialize();
+}
+
+zynq7_axis_source::~zynq7_axis_source()
+{
+    if (m_data) {
+        munmap((void *) m_data, m_size);
+    }
+}
+
+// Next beat on the pins, once the file is sent only a reset wakes the source
+void zynq7_axis_source::drive(void)
+{
+    if (m_pos >= m_size) {
+        if (m_valid) {
+            m_axis_tvalid.write(false);
+            m_valid = false;
+        }
+        next_trigger(aresetn.negedge_event());
+        return;
+    }
+
+    unsigned int n = min((size_t) BYTES, m_size - m_pos);
+    sc_bv<ZYNQ7_AXIS_TDATA_WIDTH> data(0);
+    sc_bv<ZYNQ7_AXIS_TDATA_WIDTH / 8> keep(0);
+    for (unsigned int i = 0; i < n; ++i) {
+        data.range(i * 8 + 7, i * 8) = m_data[m_pos + i];
+        keep[i] = 1;
+    }
+    m_last = (m_pos + n >= m_size) ||
+             ((PACKET_IN_BEATS_G > 0) && ((m_beat + 1) % PACKET_IN_BEATS_G == 0));
+
+    m_axis_tdata.write(data);
+    m_axis_tkeep.write(keep);
+    m_axis_tlast.write(m_last);
+    if (!m_valid) {
+        m_axis_tvalid.write(true);
+        m_valid = true;
+    }
+}
+
+void zynq7_axis_source::clock(void)
+{
+    if (!aresetn.read()) {
+        if (m_valid) {
+            m_axis_tvalid.write(false);
+        }
+        m_valid = false;
+        m_pos = 0;
+        m_beat = 0;
+        return;
+    }
+
+    if (m_valid) {
+        if (!m_axis_tready.read()) {
+            m_stats.stall();
+            return;
+        }
+        unsigned int n = min((size_t) BYTES, m_size - m_pos);
+        m_stats.beat(n, m_last);
+        m_pos += n;
+        m_beat++;
+    }
+    drive();
+}
+
+void zynq7_axis_source::end_of_simulation(void)
+{
+    if (m_data) {
+        m_stats.print(cout, name());
+    }
+}
+
+// Sink
+/////////
+
+zynq7_axis_sink::zynq7_axis_sink(sc_module_name name) :
+    SC_INIT_GENERIC_STRING(FILE_G),
+    aclk("aclk"),
+    aresetn("aresetn"),
+    s_axis_tvalid("s_axis_tvalid"),
+    s_axis_tready("s_axis_tready"),
+    s_axis_tdata("s_axis_tdata"),
+    s_axis_tkeep("s_axis_tkeep"),
+    s_axis_tlast("s_axis_tlast"),
+    m_file(NULL),
+    m_ready(false)
+{
+    if (!FILE_G.empty()) {
+        m_file = fopen(FILE_G.c_str(), "wb");
+        if (!m_file) {
+            perror(FILE_G.c_str());
+            for(;;);
+        }
+        setvbuf(m_file, NULL, _IOFBF, 1 << 20);
+    }
+
+    SC_METHOD(clock);
+    sensitive << aclk.pos();
+    dont_initialize();
+}
+
+zynq7_axis_sink::~zynq7_axis_sink()
+{
+    if (m_file) {
+        fclose(m_file);
+    }
+}
+
+void zynq7_axis_sink::clock(void)
+{
+    if (!aresetn.read()) {
+        if (m_ready) {
+            s_axis_tready.write(false);
+            m_ready = false;
+        }
+        return;
+    }
+
+    if (m_ready && s_axis_tvalid.read()) {
+        sc_bv<ZYNQ7_AXIS_TDATA_WIDTH> data = s_axis_tdata.read();
+        sc_bv<ZYNQ7_AXIS_TDATA_WIDTH / 8> keep = s_axis_tkeep.read();
+        unsigned char bytes[BYTES];
+        unsigned int n = 0;
+        for (unsigned int i = 0; i < BYTES; ++i) {
+            if (keep.get_bit(i)) {
+                bytes[n++] = data.range(i * 8 + 7, i * 8).to_uint();
+            }
+        }
+        if (m_file && n) {
+            fwrite(bytes, 1, n, m_file);
+        }
+        m_stats.beat(n, s_axis_tlast.read());
+    }
+
+    if (!m_ready) {
+        s_axis_tready.write(true);
+        m_ready = true;
+    }
+}
+
+void zynq7_axis_sink::end_of_simulation(void)
+{
+    if (m_file) {
+        fflush(m_file);
+    }
+    if (m_file || m_stats.beats()) {
+        m_stats.print(cout, name());
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * AXI-Stream source and sink for Zynq Cosim
+ *
+ * Feed and drain the AXI-Stream pipelines of the PL from host files,
+ * without a guest driver and a DMA on an S_AXI_HP port. Both modules are
+ * exported to the HDL simulator next to zynq7_ps (see
+ * src_vhdl/zynq7_axis_wrapper.vhd) and are clocked by the stream clock :
+ * - the source maps its input file (mmap) and offers one beat per cycle,
+ *   the bytes of the file in order (byte 0 in TDATA[7:0]), TKEEP clears
+ *   the missing bytes of the last beat. TLAST is set every PACKET_IN_BEATS_G
+ *   beats and on the last beat of the file. The stream restarts from the
+ *   beginning of the file on a reset
+ * - the sink accepts one beat per cycle (TREADY high out of reset) and
+ *   writes the kept bytes to its output file
+ * Both print their throughput at the end of the simulation. Without a file
+ * the source sends nothing and the sink drops the data (statistics only).
+ *
+ * The width of TDATA is a compilation constant, as the widths of the AXI
+ * ports of zynq7_ps (__AXIS_TDATA_WIDTH__, 64 bits by default).
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_AXIS_H__
+#define __ZYNQ7_AXIS_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <stdio.h>
+
+#include <ostream>
+#include <string>
+
+#ifdef __AXIS_TDATA_WIDTH__
+static const int ZYNQ7_AXIS_TDATA_WIDTH = __AXIS_TDATA_WIDTH__;
+#else
+static const int ZYNQ7_AXIS_TDATA_WIDTH = 64;
+#endif
+
+// Throughput of a stream, common to the source and the sink
+class zynq7_axis_stats
+{
+public:
+    zynq7_axis_stats();
+
+    // A beat of the given number of bytes went through on the current edge
+    void beat(unsigned int bytes, bool last);
+    // VALID without READY on the current edge
+    void stall(void) { m_stalls++; }
+
+    uint64_t beats(void) const { return m_beats; }
+
+    void print(std::ostream &os, const std::string &name) const;
+
+private:
+    uint64_t m_beats;
+    uint64_t m_bytes;
+    uint64_t m_packets;
+    uint64_t m_stalls;
+    sc_core::sc_time m_first;
+    sc_core::sc_time m_last;
+};
+
+SC_MODULE(zynq7_axis_source)
+{
+public:
+    // Input file, empty : nothing to send
+    SC_GENERIC_STRING(FILE_G, "");
+    // TLAST every this number of beats, 0 : only on the last beat of the file
+    SC_GENERIC_INT(PACKET_IN_BEATS_G, 0);
+
+    sc_in<bool> aclk;
+    sc_in<bool> aresetn;
+
+    sc_out<bool>                                    m_axis_tvalid;
+    sc_in<bool>                                     m_axis_tready;
+    sc_out<sc_bv<ZYNQ7_AXIS_TDATA_WIDTH> >          m_axis_tdata;
+    sc_out<sc_bv<ZYNQ7_AXIS_TDATA_WIDTH / 8> >      m_axis_tkeep;
+    sc_out<bool>                                    m_axis_tlast;
+
+    SC_HAS_PROCESS(zynq7_axis_source);
+
+    zynq7_axis_source(sc_module_name name);
+    ~zynq7_axis_source();
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    static const unsigned int BYTES = ZYNQ7_AXIS_TDATA_WIDTH / 8;
+
+    void clock(void);
+    void drive(void);
+
+    const unsigned char *m_data;
+    size_t m_size;
+    size_t m_pos;    // Offset of the beat on the pins
+    uint64_t m_beat; // Index of the beat on the pins
+    bool m_valid;
+    bool m_last;
+    zynq7_axis_stats m_stats;
+};
+
+SC_MODULE(zynq7_axis_sink)
+{
+public:
+    // Output file, empty : the data is dropped
+    SC_GENERIC_STRING(FILE_G, "");
+
+    sc_in<bool> aclk;
+    sc_in<bool> aresetn;
+
+    sc_in<bool>                                     s_axis_tvalid;
+    sc_out<bool>                                    s_axis_tready;
+    sc_in<sc_bv<ZYNQ7_AXIS_TDATA_WIDTH> >           s_axis_tdata;
+    sc_in<sc_bv<ZYNQ7_AXIS_TDATA_WIDTH / 8> >       s_axis_tkeep;
+    sc_in<bool>                                     s_axis_tlast;
+
+    SC_HAS_PROCESS(zynq7_axis_sink);
+
+    zynq7_axis_sink(sc_module_name name);
+    ~zynq7_axis_sink();
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    static const unsigned int BYTES = ZYNQ7_AXIS_TDATA_WIDTH / 8;
+
+    void clock(void);
+
+    FILE *m_file;
+    bool m_ready;
+    zynq7_axis_stats m_stats;
+};
+
+#endif /* __ZYNQ7_AXIS_H__ */
@@ -0,0 +1,195 @@
+/*
+ * AXI bridge gate for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_bridge_gate.h"
+
+#include <iostream>
+
+using namespace sc_core;
+using namespace std;
+
+zynq7_bridge_gate::zynq7_bridge_gate(sc_module_name name, sc_object *bridge,
+                                     zynq7_port_monitor *monitor, unsigned int idle_cycles) :
+    sc_module(name),
+    clk("clk"),
+    resetn("resetn"),
+    awvalid("awvalid"),
+    awready("awready"),
+    wvalid("wvalid"),
+    bvalid("bvalid"),
+    bready("bready"),
+    arvalid("arvalid"),
+    arready("arready"),
+    rvalid("rvalid"),
+    rready("rready"),
+    rlast("rlast"),
+    m_bridge(bridge),
+    m_monitor(monitor),
+    m_idle_cycles(idle_cycles),
+    m_suspended(false),
+    m_idle_count(0),
+    m_outstanding(0),
+    m_writes(0),
+    m_reads(0),
+    m_suspensions(0)
+{
+    assert(m_bridge && m_monitor && (m_idle_cycles >= MIN_IDLE_CYCLES));
+    m_monitor->add_observer(this);
+
+    // Sensitivity given by next_trigger, the first run arms the clock
+    SC_METHOD(update);
+}
+
+// The processes of the bridge and of its submodules (the sockets)
+void zynq7_bridge_gate::collect(sc_object *obj)
+{
+    const vector<sc_object *> &children = obj->get_child_objects();
+
+    for (size_t i = 0; i < children.size(); ++i) {
+        sc_process_handle h(children[i]);
+        if (h.valid()) {
+            m_processes.push_back(h);
+        } else {
+            collect(children[i]);
+        }
+    }
+}
+
+void zynq7_bridge_gate::start_of_simulation(void)
+{
+    collect(m_bridge);
+}
+
+bool zynq7_bridge_gate::idle(void) const
+{
+    return !m_outstanding && !m_writes && !m_reads && resetn.read() &&
+           !awvalid.read() && !wvalid.read() && !bvalid.read() && !arvalid.read() &&
+           !rvalid.read();
+}
+
+// Handshakes of the clock edge, the pins cannot change while the bridge is
+// suspended (the VALID of the PL resume it first)
+void zynq7_bridge_gate::count_handshakes(void)
+{
+    if (!resetn.read()) {
+        m_writes = 0;
+        m_reads = 0;
+        return;
+    }
+    if (awvalid.read() && awready.read()) {
+        m_writes++;
+    }
+    if (bvalid.read() && bready.read() && m_writes) {
+        m_writes--;
+    }
+    if (arvalid.read() && arready.read()) {
+        m_reads++;
+    }
+    if (rvalid.read() && rready.read() && rlast.read() && m_reads) {
+        m_reads--;
+    }
+}
+
+void zynq7_bridge_gate::suspend(void)
+{
+    for (size_t i = 0; i < m_processes.size(); ++i) {
+        m_processes[i].disable();
+    }
+    m_suspended = true;
+    m_suspensions++;
+    m_suspended_since = sc_time_stamp();
+}
+
+void zynq7_bridge_gate::resume(void)
+{
+    for (size_t i = 0; i < m_processes.size(); ++i) {
+        m_processes[i].enable();
+    }
+    m_suspended = false;
+    m_idle_count = 0;
+    m_suspended_time += sc_time_stamp() - m_suspended_since;
+}
+
+// Counts the idle edges while the bridge runs, any change of the watched
+// signals while it is suspended resumes it
+void zynq7_bridge_gate::update(void)
+{
+    if (m_suspended) {
+        resume();
+    } else if (clk.posedge()) {
+        count_handshakes();
+        m_idle_count = idle() ? m_idle_count + 1 : 0;
+        if (m_idle_count >= m_idle_cycles) {
+            suspend();
+        }
+    }
+
+    if (m_suspended) {
+        next_trigger(awvalid.value_changed_event() | wvalid.value_changed_event() |
+                     bvalid.value_changed_event() | arvalid.value_changed_event() |
+                     rvalid.value_changed_event() | resetn.value_changed_event() |
+                     m_wake_event);
+    } else {
+        next_trigger(clk.posedge_event());
+    }
+}
+
+// The bridge is resumed before the monitor forwards the transaction to it
+void zynq7_bridge_gate::transaction_begin(zynq7_port_monitor &port,
+                                          tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    m_outstanding++;
+    if (m_suspended) {
+        resume();
+        // Back to the clock
+        m_wake_event.notify();
+    }
+}
+
+void zynq7_bridge_gate::transaction_end(zynq7_port_monitor &port,
+                                        tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    m_outstanding--;
+}
+
+void zynq7_bridge_gate::print_summary(ostream &os) const
+{
+    sc_time suspended = m_suspended_time;
+    if (m_suspended) {
+        suspended += sc_time_stamp() - m_suspended_since;
+    }
+    double ratio = (sc_time_stamp() > SC_ZERO_TIME) ? suspended / sc_time_stamp() : 0;
+
+    os << m_monitor->port_name() << " bridge : suspended " << m_suspensions << " times, "
+       << (100.0 * ratio) << " % of the time" << endl;
+}
+
+void zynq7_bridge_gate::end_of_simulation(void)
+{
+    if (m_suspensions) {
+        print_summary(cout);
+    }
+}
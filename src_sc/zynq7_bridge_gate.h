@@ -0,0 +1,124 @@
+/*
+ * AXI bridge gate for Zynq Cosim
+ *
+ * The processes of the AXI bridges are clocked by the port clock and wake on
+ * every edge, even when nothing happens on the port for millions of cycles.
+ * The gate suspends them (IEEE 1666 process control, disable / enable) once
+ * the port has been idle for a number of cycles and resumes them before they
+ * have something to do :
+ * - a transaction enters the port on the TLM side (seen through the monitor,
+ *   before it reaches the bridge)
+ * - a VALID of the port rises (the bridge samples it on the next edge)
+ * - the reset of the port changes (it must last more than one cycle)
+ * The port is idle when no transaction is in the monitor nor on the pins
+ * (counted from the address handshake to the write response or the last
+ * read beat handshake, so the gaps of a transaction, e.g., between the
+ * address and the data or between the TLM side and the response, are never
+ * idle), all the VALID are low and the reset is released. While the bridge
+ * is suspended the gate is only sensitive to the VALID and the reset, not to
+ * the clock.
+ *
+ * The bridge must not be waiting on a time-out when it is suspended (an idle
+ * bridge waits on the clock), the threshold (at least MIN_IDLE_CYCLES) leaves
+ * it the time to return to its idle state after the last handshake.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_BRIDGE_GATE_H__
+#define __ZYNQ7_BRIDGE_GATE_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_port_monitor.h"
+
+#include <ostream>
+#include <vector>
+
+class zynq7_bridge_gate : public sc_core::sc_module, public zynq7_port_observer
+{
+public:
+    sc_core::sc_in<bool> clk;
+    sc_core::sc_in<bool> resetn;
+
+    sc_core::sc_in<bool> awvalid;
+    sc_core::sc_in<bool> awready;
+    sc_core::sc_in<bool> wvalid;
+    sc_core::sc_in<bool> bvalid;
+    sc_core::sc_in<bool> bready;
+    sc_core::sc_in<bool> arvalid;
+    sc_core::sc_in<bool> arready;
+    sc_core::sc_in<bool> rvalid;
+    sc_core::sc_in<bool> rready;
+    sc_core::sc_in<bool> rlast;
+
+    // Smallest threshold, the bridge returns to its idle state within it
+    static const unsigned int MIN_IDLE_CYCLES = 4;
+
+    SC_HAS_PROCESS(zynq7_bridge_gate);
+
+    // Suspends the processes of the bridge after idle_cycles idle edges of the
+    // clock (at least MIN_IDLE_CYCLES)
+    zynq7_bridge_gate(sc_core::sc_module_name name, sc_core::sc_object *bridge,
+                      zynq7_port_monitor *monitor, unsigned int idle_cycles);
+
+    void transaction_begin(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                           sc_core::sc_time &delay);
+    void transaction_end(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                         sc_core::sc_time &delay);
+
+    // Statistics
+    ///////////////
+    uint64_t suspensions(void) const { return m_suspensions; }
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    void start_of_simulation(void);
+    void end_of_simulation(void);
+
+private:
+    void collect(sc_core::sc_object *obj);
+    void count_handshakes(void);
+    void update(void);
+    void suspend(void);
+    void resume(void);
+    bool idle(void) const;
+
+    sc_core::sc_object *m_bridge;
+    zynq7_port_monitor *m_monitor;
+    unsigned int m_idle_cycles;
+    std::vector<sc_core::sc_process_handle> m_processes;
+
+    bool m_suspended;
+    unsigned int m_idle_count;
+    unsigned int m_outstanding;
+    // Transactions on the pins, from the address to the response handshake
+    unsigned int m_writes;
+    unsigned int m_reads;
+    sc_core::sc_event m_wake_event;
+
+    uint64_t m_suspensions;
+    sc_core::sc_time m_suspended_since;
+    sc_core::sc_time m_suspended_time;
+};
+
+#endif /* __ZYNQ7_BRIDGE_GATE_H__ */
@@ -0,0 +1,118 @@
+/*
+ * Profiling counters for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_counters.h"
+
+#include <string.h>
+
+#include <iostream>
+
+using namespace sc_core;
+using namespace std;
+
+zynq7_counters::zynq7_counters(sc_module_name name) :
+    sc_module(name),
+    m_fclk_gen(NULL),
+    m_latched_hi(0),
+    m_markers(0)
+{
+    for (int p = 0; p < MAX_PORTS; ++p) {
+        m_ports[p] = NULL;
+    }
+}
+
+void zynq7_counters::set_port(int p, const zynq7_port_monitor *monitor)
+{
+    assert((p >= 0) && (p < MAX_PORTS));
+    m_ports[p] = monitor;
+}
+
+uint64_t zynq7_counters::read64(uint64_t offset) const
+{
+    if (offset == TIME_NS) {
+        return (uint64_t) (sc_time_stamp() / sc_time(1, SC_NS));
+    }
+    if (offset == MARKER) {
+        return m_markers;
+    }
+    if ((offset >= FCLK_CYCLES) && (offset < FCLK_CYCLES + 8 * zynq7_fclk_gen::NR_FCLKS)) {
+        return m_fclk_gen ? m_fclk_gen->cycles((offset - FCLK_CYCLES) / 8) : 0;
+    }
+    if ((offset >= PORT_TRANSACTIONS) && (offset < PORT_TRANSACTIONS + 8 * MAX_PORTS)) {
+        const zynq7_port_monitor *monitor = m_ports[(offset - PORT_TRANSACTIONS) / 8];
+        return monitor ? monitor->reads() + monitor->writes() : 0;
+    }
+    return 0;
+}
+
+// 32 bit accesses (LO, HI, MARKER) or 64 bit accesses (LO and HI), little endian
+bool zynq7_counters::access(tlm::tlm_generic_payload &trans, uint64_t offset, uint32_t &marker)
+{
+    unsigned int len = trans.get_data_length();
+    unsigned char *data = trans.get_data_ptr();
+    bool written = false;
+
+    if (((len != 4) && (len != 8)) || (offset % len) || trans.get_byte_enable_ptr()) {
+        trans.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+        return false;
+    }
+
+    if (trans.is_write()) {
+        if (offset == MARKER) {
+            marker = 0;
+            for (unsigned int i = 0; i < sizeof(marker); ++i) {
+                marker |= (uint32_t) data[i] << (8 * i);
+            }
+            m_markers++;
+            written = true;
+        }
+    } else if (trans.is_read()) {
+        uint64_t value;
+        if (offset % 8) {
+            value = m_latched_hi;
+        } else {
+            value = read64(offset);
+            m_latched_hi = value >> 32;
+        }
+        for (unsigned int i = 0; i < len; ++i) {
+            data[i] = value >> (8 * i);
+        }
+    }
+    trans.set_response_status(tlm::TLM_OK_RESPONSE);
+    return written;
+}
+
+void zynq7_counters::print_summary(ostream &os) const
+{
+    os << name() << " : " << m_markers << " markers" << endl;
+}
+
+void zynq7_counters::end_of_simulation(void)
+{
+    if (m_markers) {
+        print_summary(cout);
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Profiling counters for Zynq Cosim
+ *
+ * Register file served in SystemC through a counter region of the address
+ * map of an M_AXI_GP port (see zynq7_addr_decoder.h), so the software in
+ * QEMU can read the simulated time and the activity of the PL without RTL
+ * and measure its drivers against them, e.g., "counter:0x43c00000:0x1000".
+ *
+ * Registers are 32 bits, the 64 bit counters are LO then HI : reading LO
+ * latches HI (the pair is consistent), a 64 bit read returns both.
+ *   0x00 TIME_NS     simulated time (HDL side) in ns
+ *   0x08 MARKER      write : guest marker, as a write to a marker region of
+ *                    the address map (logged with the time and the FCLK0
+ *                    cycle, timeline event, AXI capture trigger), read :
+ *                    number of markers written
+ *   0x10 FCLK_CYCLES rising edges of FCLK_CLKn, at 0x10 + 8 * n
+ *   0x40 PORT_TRANSACTIONS transactions of the AXI ports at 0x40 + 8 * p,
+ *                    p in the order of the port table (M_AXI_GP0, M_AXI_GP1,
+ *                    S_AXI_GP0, S_AXI_GP1, S_AXI_HP0-3, S_AXI_ACP), 0 for
+ *                    the disabled ports
+ * The other offsets read 0 and ignore writes. The address decoder
+ * synchronizes on the access (its delay is waited), all the registers are
+ * then sampled at the same simulated time, the one of the access.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_COUNTERS_H__
+#define __ZYNQ7_COUNTERS_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_fclk_gen.h"
+#include "zynq7_port_monitor.h"
+
+#include <ostream>
+
+class zynq7_counters : public sc_core::sc_module
+{
+public:
+    enum reg {
+        TIME_NS           = 0x00,
+        MARKER            = 0x08,
+        FCLK_CYCLES       = 0x10,
+        PORT_TRANSACTIONS = 0x40
+    };
+    static const int MAX_PORTS = 16;
+
+    zynq7_counters(sc_core::sc_module_name name);
+
+    void set_fclk_gen(const zynq7_fclk_gen *fclk_gen) { m_fclk_gen = fclk_gen; }
+    // Monitor of the port at index p of the port table (NULL : disabled)
+    void set_port(int p, const zynq7_port_monitor *monitor);
+
+    // Serves an access at an offset of the region at the current time, true
+    // when a marker was written (its value in marker)
+    bool access(tlm::tlm_generic_payload &trans, uint64_t offset, uint32_t &marker);
+
+    uint64_t markers(void) const { return m_markers; }
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    // Value of the 64 bit register at an 8 byte aligned offset
+    uint64_t read64(uint64_t offset) const;
+
+    const zynq7_fclk_gen *m_fclk_gen;
+    const zynq7_port_monitor *m_ports[MAX_PORTS];
+    uint32_t m_latched_hi;
+    uint64_t m_markers;
+};
+
+#endif /* __ZYNQ7_COUNTERS_H__ */
@@ -0,0 +1,210 @@
+/*
+ * DDR timing model for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_ddr_model.h"
+
+#include <iostream>
+
+using namespace sc_core;
+using namespace std;
+
+zynq7_ddr_model::zynq7_ddr_model(sc_module_name name, double bandwidth,
+                                 const sc_time &latency, const sc_time &gp_latency) :
+    sc_module(name),
+    m_bandwidth(bandwidth),
+    m_latency(latency),
+    m_gp_latency(gp_latency),
+    m_last_granted(0),
+    m_busy_time(SC_ZERO_TIME),
+    m_bytes(0)
+{
+    assert(m_bandwidth > 0);
+
+    SC_THREAD(arbiter_thread);
+}
+
+void zynq7_ddr_model::add_port(zynq7_port_monitor *port, zynq7_axi_port_kind kind,
+                               const qos_signals *qos)
+{
+    port_state &p = m_ports[port];
+
+    p.monitor = port;
+    p.index = m_ports.size() - 1;
+    p.latency = m_latency;
+    if (kind == ZYNQ7_S_AXI_GP) {
+        p.latency += m_gp_latency;
+    }
+    p.has_qos = (qos != NULL);
+    if (qos) {
+        p.qos = *qos;
+    }
+    p.transactions = 0;
+    p.wait_time = SC_ZERO_TIME;
+
+    port->add_observer(this);
+
+    if (p.has_qos) {
+        sc_spawn_options opts;
+        opts.spawn_method();
+        std::string name = "qos_" + port->port_name();
+        sc_spawn(sc_bind(&zynq7_ddr_model::latch_qos, this, &p), name.c_str(), &opts);
+    }
+}
+
+// The pins are only stable while AxVALID is high, the QoS is latched at the
+// handshakes and the clock is only followed while an address is pending
+void zynq7_ddr_model::latch_qos(port_state *p)
+{
+    const qos_signals &s = p->qos;
+    bool aw = s.awvalid->read();
+    bool ar = s.arvalid->read();
+
+    if (s.clk->posedge()) {
+        if (aw && s.awready->read()) {
+            p->aw_qos.push_back(s.awqos->read().to_uint());
+        }
+        if (ar && s.arready->read()) {
+            p->ar_qos.push_back(s.arqos->read().to_uint());
+        }
+    }
+
+    if (aw || ar) {
+        next_trigger(s.clk->posedge_event());
+    } else {
+        next_trigger(s.awvalid->value_changed_event() | s.arvalid->value_changed_event());
+    }
+}
+
+void zynq7_ddr_model::transaction_begin(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                                        sc_time &delay)
+{
+    port_state &p = m_ports[&port];
+    deque<unsigned int> &latched = trans.is_write() ? p.aw_qos : p.ar_qos;
+    request req;
+
+    // The requests are arbitrated in simulated time order
+    if (delay > SC_ZERO_TIME) {
+        wait(delay);
+        delay = SC_ZERO_TIME;
+    }
+
+    // The bridge may start the transaction in the delta cycle of the
+    // handshake, before it is latched
+    if (p.has_qos && latched.empty()) {
+        wait(SC_ZERO_TIME);
+    }
+
+    req.port = &p;
+    req.qos = 0;
+    if (!latched.empty()) {
+        req.qos = latched.front();
+        latched.pop_front();
+    }
+    req.bytes = trans.get_data_length();
+    req.granted = false;
+
+    sc_time start = sc_time_stamp();
+    m_pending.push_back(&req);
+    m_request_event.notify(SC_ZERO_TIME);
+    while (!req.granted) {
+        wait(req.grant_event);
+    }
+
+    // Waiting for the controller, then access and transfer
+    p.wait_time += sc_time_stamp() - start;
+    p.transactions++;
+    delay += req.latency;
+}
+
+// Highest QoS, then round-robin from the port after the last granted one
+list<zynq7_ddr_model::request *>::iterator zynq7_ddr_model::select(void)
+{
+    const unsigned int nr_ports = m_ports.size();
+    list<request *>::iterator best = m_pending.end();
+    unsigned int best_distance = 0;
+
+    for (list<request *>::iterator it = m_pending.begin(); it != m_pending.end(); ++it) {
+        unsigned int distance = (((*it)->port->index + nr_ports) - m_last_granted - 1) % nr_ports;
+        if ((best == m_pending.end()) || ((*it)->qos > (*best)->qos) ||
+            (((*it)->qos == (*best)->qos) && (distance < best_distance))) {
+            best = it;
+            best_distance = distance;
+        }
+    }
+    return best;
+}
+
+void zynq7_ddr_model::arbiter_thread(void)
+{
+    for (;;) {
+        while (m_pending.empty()) {
+            wait(m_request_event);
+        }
+        // The requests of the same time compete
+        wait(SC_ZERO_TIME);
+
+        list<request *>::iterator it = select();
+        request *req = *it;
+        m_pending.erase(it);
+
+        sc_time transfer = sc_time(req->bytes / m_bandwidth, SC_SEC);
+        req->latency = req->port->latency + transfer;
+        req->granted = true;
+        req->grant_event.notify();
+        m_last_granted = req->port->index;
+
+        // The data bus is busy during the transfer
+        m_busy_time += transfer;
+        m_bytes += req->bytes;
+        wait(transfer);
+    }
+}
+
+void zynq7_ddr_model::print_summary(ostream &os) const
+{
+    double elapsed = sc_time_stamp().to_seconds();
+
+    os << "DDR model : " << m_bytes << " bytes, busy for " << m_busy_time;
+    if (elapsed > 0) {
+        os << " (" << 100.0 * m_busy_time.to_seconds() / elapsed << " %)";
+    }
+    os << endl;
+    for (map<zynq7_port_monitor *, port_state>::const_iterator it = m_ports.begin();
+         it != m_ports.end(); ++it) {
+        const port_state &p = it->second;
+        if (p.transactions) {
+            os << "  " << p.monitor->port_name() << " : " << p.transactions
+               << " transactions, waited " << p.wait_time << endl;
+        }
+    }
+}
+
+void zynq7_ddr_model::end_of_simulation(void)
+{
+    if (m_bytes) {
+        print_summary(cout);
+    }
+}
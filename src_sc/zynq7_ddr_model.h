@@ -0,0 +1,132 @@
+/*
+ * DDR timing model for Zynq Cosim
+ *
+ * The accesses of the PL to the PS (S_AXI_HP, S_AXI_GP and S_AXI_ACP ports)
+ * otherwise complete as fast as QEMU answers them. This model arbitrates
+ * the ports for a single DDR controller and annotates each transaction with
+ * the time it would take on the chip : waiting for the controller, a fixed
+ * access latency (plus the central interconnect for the GP ports) and the
+ * transfer at the DDR bandwidth. The data transfers of the ports do not
+ * overlap, the latencies do (the controller is pipelined).
+ *
+ * The arbitration honors the AXI QoS of the ports (AxQOS, the highest value
+ * wins), ports with the same QoS are served in round-robin. The QoS of a
+ * burst is latched at its address handshake (AxVALID and AxREADY on the
+ * rising edge of the clock of the port), the pins are only stable then.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_DDR_MODEL_H__
+#define __ZYNQ7_DDR_MODEL_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_ps_ports.h"
+#include "zynq7_port_monitor.h"
+
+#include <deque>
+#include <list>
+#include <map>
+#include <vector>
+
+class zynq7_ddr_model : public sc_core::sc_module, public zynq7_port_observer
+{
+public:
+    typedef sc_core::sc_in<sc_dt::sc_bv<4> > qos_port_t;
+
+    // Address channels of a port where the PL is the master
+    struct qos_signals {
+        sc_core::sc_in<bool> *clk;
+        sc_core::sc_in<bool> *awvalid;
+        sc_core::sc_out<bool> *awready;
+        qos_port_t *awqos;
+        sc_core::sc_in<bool> *arvalid;
+        sc_core::sc_out<bool> *arready;
+        qos_port_t *arqos;
+    };
+
+    SC_HAS_PROCESS(zynq7_ddr_model);
+
+    // bandwidth in bytes per second of simulated time, latency of an access and
+    // extra latency of the GP ports (central interconnect)
+    zynq7_ddr_model(sc_core::sc_module_name name, double bandwidth,
+                    const sc_core::sc_time &latency, const sc_core::sc_time &gp_latency);
+
+    // Arbitrates the transactions of a port, the QoS is latched on the given
+    // signals at the address handshakes (NULL : QoS 0)
+    void add_port(zynq7_port_monitor *port, zynq7_axi_port_kind kind,
+                  const qos_signals *qos);
+
+    // zynq7_port_observer
+    void transaction_begin(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                           sc_core::sc_time &delay);
+    void transaction_end(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                         sc_core::sc_time &delay) {}
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    struct port_state {
+        zynq7_port_monitor *monitor;
+        unsigned int index; // Round-robin order
+        sc_core::sc_time latency;
+        bool has_qos;
+        qos_signals qos;
+        // QoS of the bursts handshaken and not started yet, in order
+        std::deque<unsigned int> aw_qos;
+        std::deque<unsigned int> ar_qos;
+        // Statistics
+        uint64_t transactions;
+        sc_core::sc_time wait_time;
+    };
+
+    struct request {
+        port_state *port;
+        unsigned int qos;
+        unsigned int bytes;
+        bool granted;
+        sc_core::sc_time latency; // Annotated when granted
+        sc_core::sc_event grant_event;
+    };
+
+    void latch_qos(port_state *p);
+    void arbiter_thread(void);
+    std::list<request *>::iterator select(void);
+
+    double m_bandwidth;
+    sc_core::sc_time m_latency;
+    sc_core::sc_time m_gp_latency;
+
+    std::map<zynq7_port_monitor *, port_state> m_ports;
+    std::list<request *> m_pending;
+    unsigned int m_last_granted;
+    sc_core::sc_event m_request_event;
+
+    // Statistics
+    sc_core::sc_time m_busy_time;
+    uint64_t m_bytes;
+};
+
+#endif /* __ZYNQ7_DDR_MODEL_H__ */
@@ -0,0 +1,87 @@
+/*
+ * Guest exit for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_exit.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#include <iostream>
+
+using namespace sc_core;
+using namespace std;
+
+const char *zynq7_exit::STATUS_FILE = "zynq7_exit_status";
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+zynq7_exit::zynq7_exit(sc_module_name name) :
+    sc_module(name),
+    m_requested(false),
+    m_status(0),
+    m_wall_start(wall_seconds())
+{
+}
+
+void zynq7_exit::request(int status, const string &origin)
+{
+    // The first request wins
+    if (m_requested) {
+        return;
+    }
+    m_requested = true;
+    m_status = status;
+    cout << sc_time_stamp() << " " << origin << " ended the simulation with status " << status << endl;
+    sc_stop();
+}
+
+void zynq7_exit::end_of_simulation(void)
+{
+    double wall = wall_seconds() - m_wall_start;
+    double simulated = sc_time_stamp().to_seconds();
+
+    cout << "Simulated " << sc_time_stamp() << " in " << wall << " s wall-clock";
+    if (wall > 0) {
+        cout << " (" << simulated / wall << " simulated s per s)";
+    }
+    cout << endl;
+
+    if (m_requested) {
+        cout << "Exit status " << m_status << " written to " << STATUS_FILE << endl;
+        FILE *f = fopen(STATUS_FILE, "w");
+        if (!f) {
+            perror(STATUS_FILE);
+            return;
+        }
+        fprintf(f, "%d\n", m_status);
+        fclose(f);
+    }
+}
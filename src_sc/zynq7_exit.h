@@ -0,0 +1,69 @@
+/*
+ * Guest exit for Zynq Cosim
+ *
+ * Ends the simulation when the guest asks for it (e.g., a test program
+ * writing its exit status to an exit region of the address map, see
+ * zynq7_addr_decoder.h) or on a fatal error of a service (e.g., an AXI
+ * protocol violation, see zynq7_axi_checker.h). The simulation is stopped
+ * with sc_stop() (every module sees the end of the simulation and prints its
+ * summary), a summary of the run (wall-clock and simulated time) is printed
+ * and the status is written to STATUS_FILE. The simulator process is never
+ * exited from SystemC : the batch script generated with the simulation files
+ * (zynq7_batch.do) reads the file and quits with the status, so batch
+ * regressions end as soon as the test finishes.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_EXIT_H__
+#define __ZYNQ7_EXIT_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <string>
+
+class zynq7_exit : public sc_core::sc_module
+{
+public:
+    // Written at the end of the simulation when an exit was requested (in the
+    // working directory of the simulator)
+    static const char *STATUS_FILE;
+
+    zynq7_exit(sc_core::sc_module_name name);
+
+    // Stops the simulation, status is written to STATUS_FILE at the end,
+    // origin is only reported (e.g., a protocol checker)
+    void request(int status, const std::string &origin = "the guest");
+
+    bool requested(void) const { return m_requested; }
+    int status(void) const { return m_status; }
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    bool m_requested;
+    int m_status;
+    double m_wall_start;
+};
+
+#endif /* __ZYNQ7_EXIT_H__ */
@@ -0,0 +1,152 @@
+/*
+ * Fast-forward for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_fast_forward.h"
+
+using namespace sc_core;
+using namespace std;
+
+zynq7_fast_forward::zynq7_fast_forward(sc_module_name name,
+                                       const sc_time &quantum,
+                                       const sc_time &budget,
+                                       unsigned int idle_quanta) :
+    sc_module(name),
+    m_quantum(quantum),
+    m_budget(budget),
+    m_idle_quanta_needed(idle_quanta),
+    m_active(false),
+    m_idle_quanta(0),
+    m_activity(0),
+    m_last_activity(0),
+    m_outstanding(0),
+    m_enter_time(SC_ZERO_TIME),
+    m_frozen_time(SC_ZERO_TIME),
+    m_longest(SC_ZERO_TIME),
+    m_episodes(0)
+{
+    SC_THREAD(control_thread);
+}
+
+// Checks the activity once per (normal) quantum, this is cheap compared to
+// the clocks of the PL and keeps running while fast-forwarding
+void zynq7_fast_forward::control_thread(void)
+{
+    for (;;) {
+        wait(m_quantum);
+
+        if (m_active) {
+            // Left on activity or after one budget, so a PL busy without
+            // bus traffic gets its clocks back before the idle check
+            if (sc_time_stamp() - m_enter_time >= m_budget) {
+                leave();
+            }
+            continue;
+        }
+
+        if ((m_activity == m_last_activity) && (m_outstanding == 0)) {
+            m_idle_quanta++;
+        } else {
+            m_idle_quanta = 0;
+            m_last_activity = m_activity;
+        }
+
+        if (m_idle_quanta >= m_idle_quanta_needed) {
+            enter();
+        }
+    }
+}
+
+void zynq7_fast_forward::enter(void)
+{
+    m_active = true;
+    m_enter_time = sc_time_stamp();
+    m_episodes++;
+    m_state_event.notify(SC_ZERO_TIME);
+    // The remote port syncs (waits) only when its local time exceeds the
+    // global quantum, QEMU can now run up to the budget ahead
+    tlm::tlm_global_quantum::instance().set(m_budget);
+}
+
+void zynq7_fast_forward::leave(void)
+{
+    sc_time frozen = sc_time_stamp() - m_enter_time;
+
+    m_active = false;
+    m_state_event.notify(SC_ZERO_TIME);
+    m_idle_quanta = 0;
+    m_frozen_time += frozen;
+    if (frozen > m_longest) {
+        m_longest = frozen;
+    }
+    tlm::tlm_global_quantum::instance().set(m_quantum);
+}
+
+void zynq7_fast_forward::notify_activity(void)
+{
+    m_activity++;
+    if (m_active) {
+        leave();
+    }
+}
+
+void zynq7_fast_forward::transaction_begin(zynq7_port_monitor &port,
+                                           tlm::tlm_generic_payload &trans,
+                                           sc_time &delay)
+{
+    m_activity++;
+    m_outstanding++;
+    if (m_active) {
+        // Catch the simulated time up in one jump while the clocks are
+        // still held, the transaction then starts without local offset
+        if (delay > SC_ZERO_TIME) {
+            wait(delay);
+            delay = SC_ZERO_TIME;
+        }
+        leave();
+    }
+}
+
+void zynq7_fast_forward::transaction_end(zynq7_port_monitor &port,
+                                         tlm::tlm_generic_payload &trans,
+                                         sc_time &delay)
+{
+    m_outstanding--;
+}
+
+void zynq7_fast_forward::print_summary(ostream &os) const
+{
+    os << "Fast-forward : " << m_episodes << " episodes, PL frozen for "
+       << m_frozen_time << " (longest " << m_longest << "), QEMU ahead by at most "
+       << m_budget << endl;
+}
+
+void zynq7_fast_forward::end_of_simulation(void)
+{
+    if (m_active) {
+        leave();
+    }
+    print_summary(cout);
+}
@@ -0,0 +1,108 @@
+/*
+ * Fast-forward for Zynq Cosim
+ *
+ * When the PL has been idle for a number of quanta (no AXI transaction and
+ * no IRQ change) the global quantum is enlarged to a time budget so QEMU can
+ * run ahead of the simulation without waiting on every sync, and the FCLKs
+ * are held so the simulator has nothing to evaluate while time advances.
+ * The next PL access catches the simulated time up in one jump and restores
+ * the normal quantum, an IRQ change from the PL also ends the fast-forward.
+ * An episode lasts at most one budget, the FCLKs then run again and the PL
+ * must stay idle for the same number of quanta before the next one.
+ *
+ * The budget bounds how far QEMU can be ahead of the PL (e.g., the maximal
+ * extra latency of an IRQ) and how long the PL is frozen in a row. The PL is
+ * only seen from its ports and IRQs, a PL busy on its own (e.g., an
+ * accelerator working on a BRAM while the guest waits for its IRQ) is still
+ * frozen for one budget out of every budget plus idle quanta, which slows
+ * its work down accordingly. Disable the fast-forward or shorten the budget
+ * for such designs, the time during which the PL was frozen is reported at
+ * the end of the simulation.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_FAST_FORWARD_H__
+#define __ZYNQ7_FAST_FORWARD_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_port_monitor.h"
+
+class zynq7_fast_forward : public sc_core::sc_module, public zynq7_port_observer
+{
+public:
+    SC_HAS_PROCESS(zynq7_fast_forward);
+
+    // quantum : normal sync quantum, budget : maximal quantum when fast-forwarding
+    // idle_quanta : number of idle quanta before fast-forwarding
+    zynq7_fast_forward(sc_core::sc_module_name name,
+                       const sc_core::sc_time &quantum,
+                       const sc_core::sc_time &budget,
+                       unsigned int idle_quanta);
+
+    // Observe the transactions of a port
+    void watch(zynq7_port_monitor *port) { port->add_observer(this); }
+
+    // Activity that does not go through a port (e.g., IRQ from the PL)
+    void notify_activity(void);
+
+    // The FCLKs are held while fast-forwarding (one budget at most)
+    bool active(void) const { return m_active; }
+    // Notified when entering and leaving fast-forward
+    const sc_core::sc_event &state_event(void) const { return m_state_event; }
+
+    // zynq7_port_observer
+    void transaction_begin(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                           sc_core::sc_time &delay);
+    void transaction_end(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                         sc_core::sc_time &delay);
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    void control_thread(void);
+    void enter(void);
+    void leave(void);
+
+    sc_core::sc_time m_quantum;
+    sc_core::sc_time m_budget;
+    unsigned int m_idle_quanta_needed;
+
+    bool m_active;
+    unsigned int m_idle_quanta;
+    uint64_t m_activity;
+    uint64_t m_last_activity;
+    unsigned int m_outstanding;
+
+    // Statistics
+    sc_core::sc_time m_enter_time;
+    sc_core::sc_time m_frozen_time;
+    sc_core::sc_time m_longest;
+    uint64_t m_episodes;
+
+    sc_core::sc_event m_state_event;
+};
+
+#endif /* __ZYNQ7_FAST_FORWARD_H__ */
@@ -0,0 +1,115 @@
+/*
+ * FCLK generator for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_fclk_gen.h"
+
+using namespace sc_core;
+
+zynq7_fclk_gen::zynq7_fclk_gen(sc_module_name name) :
+    sc_module(name),
+    m_held(false),
+    m_activations(0)
+{
+    for (int i = 0; i < NR_FCLKS; ++i) {
+        m_period[i] = SC_ZERO_TIME;
+        m_next_edge[i] = SC_ZERO_TIME;
+        m_value[i] = false;
+        m_cycles[i] = 0;
+    }
+
+    // Initialized, the enabled clocks start with a rising edge at time 0 (as sc_clock)
+    SC_METHOD(generate);
+}
+
+void zynq7_fclk_gen::set_period(int n, const sc_time &period)
+{
+    assert((n >= 0) && (n < NR_FCLKS));
+
+    if ((m_period[n] == SC_ZERO_TIME) && (period != SC_ZERO_TIME)) {
+        // Clock (re)started, first edge now
+        m_next_edge[n] = sc_time_stamp();
+    }
+    m_period[n] = period;
+    // Before the simulation starts, the generator is run at initialization anyway
+    if (sc_is_running()) {
+        m_reconfig_event.notify(SC_ZERO_TIME);
+    }
+}
+
+void zynq7_fclk_gen::hold(bool held)
+{
+    m_held = held;
+    if (sc_is_running()) {
+        m_reconfig_event.notify(SC_ZERO_TIME);
+    }
+}
+
+void zynq7_fclk_gen::generate(void)
+{
+    sc_time now = sc_time_stamp();
+    sc_time next = SC_ZERO_TIME;
+    bool scheduled = false;
+
+    m_activations++;
+
+    for (int i = 0; i < NR_FCLKS; ++i) {
+        if (m_period[i] == SC_ZERO_TIME) {
+            // Stopped clock
+            if (m_value[i]) {
+                m_value[i] = false;
+                fclk[i].write(false);
+            }
+            continue;
+        }
+
+        if (m_held) {
+            // Restart from the current time once released
+            if (m_next_edge[i] < now) {
+                m_next_edge[i] = now;
+            }
+            continue;
+        }
+
+        if (m_next_edge[i] <= now) {
+            m_value[i] = !m_value[i];
+            fclk[i].write(m_value[i]);
+            m_cycles[i] += m_value[i];
+            // 50% duty cycle
+            m_next_edge[i] = now + m_period[i] / 2;
+        }
+
+        if (!scheduled || (m_next_edge[i] < next)) {
+            next = m_next_edge[i];
+            scheduled = true;
+        }
+    }
+
+    if (scheduled) {
+        next_trigger(next - now, m_reconfig_event);
+    } else {
+        next_trigger(m_reconfig_event);
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * FCLK generator for Zynq Cosim
+ *
+ * Generates the four PL clocks (FCLK_CLK0..3) from a single method. At each
+ * activation the method toggles every clock that has an edge at the current
+ * time (coincident edges are handled in one activation) and schedules itself
+ * at the next edge of all the clocks. The periods can be changed at run time
+ * (as Linux does through the SLCR FPGAn_CLK_CTRL dividers), the new period is
+ * used from the next edge on. The clocks can also be held (e.g., during
+ * fast-forward), in that case the generator is not activated at all.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_FCLK_GEN_H__
+#define __ZYNQ7_FCLK_GEN_H__
+
+#include "zynq7_ps_pch.h"
+
+class zynq7_fclk_gen : public sc_core::sc_module
+{
+public:
+    static const int NR_FCLKS = 4;
+
+    sc_core::sc_out<bool> fclk[NR_FCLKS];
+
+    SC_HAS_PROCESS(zynq7_fclk_gen);
+    zynq7_fclk_gen(sc_core::sc_module_name name);
+
+    // A zero period stops the clock (tied to 0)
+    void set_period(int n, const sc_core::sc_time &period);
+    const sc_core::sc_time &period(int n) const { return m_period[n]; }
+
+    // Rising edges of a clock since the start of the simulation
+    uint64_t cycles(int n) const { return m_cycles[n]; }
+
+    // Held clocks keep their current value
+    void hold(bool held);
+
+    // Number of activations of the generator (for profiling)
+    uint64_t activations(void) const { return m_activations; }
+
+private:
+    void generate(void);
+
+    sc_core::sc_time m_period[NR_FCLKS];
+    sc_core::sc_time m_next_edge[NR_FCLKS];
+    bool m_value[NR_FCLKS];
+    uint64_t m_cycles[NR_FCLKS];
+    bool m_held;
+    uint64_t m_activations;
+
+    sc_core::sc_event m_reconfig_event;
+};
+
+#endif /* __ZYNQ7_FCLK_GEN_H__ */
@@ -0,0 +1,174 @@
+/*
+ * Memory for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_memory.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <iostream>
+
+using namespace sc_core;
+using namespace std;
+
+zynq7_memory::zynq7_memory(sc_module_name name, uint64_t base, uint64_t size,
+                           const string &file, const string &image) :
+    sc_module(name),
+    tgt_socket("tgt_socket"),
+    m_base(base),
+    m_size(size),
+    m_data(NULL),
+    m_file_backed(!file.empty())
+{
+    void *data;
+
+    assert(m_size > 0);
+
+    if (m_file_backed) {
+        int fd = open(file.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            perror(file.c_str());
+            for(;;);
+        }
+        // Zero-filled up to the size of the memory (a larger file is kept as is)
+        struct stat st;
+        if ((fstat(fd, &st) < 0) ||
+            (((uint64_t) st.st_size < m_size) && (ftruncate(fd, m_size) < 0))) {
+            perror(file.c_str());
+            for(;;);
+        }
+        data = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+    } else {
+        data = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (data == MAP_FAILED) {
+        perror("mmap");
+        for(;;);
+    }
+    m_data = (unsigned char *) data;
+
+    if (!image.empty()) {
+        load_image(image);
+    }
+
+    tgt_socket.register_b_transport(this, &zynq7_memory::b_transport);
+    tgt_socket.register_transport_dbg(this, &zynq7_memory::transport_dbg);
+    tgt_socket.register_get_direct_mem_ptr(this, &zynq7_memory::get_direct_mem_ptr);
+}
+
+zynq7_memory::~zynq7_memory()
+{
+    munmap(m_data, m_size);
+}
+
+void zynq7_memory::load_image(const string &image)
+{
+    FILE *f = fopen(image.c_str(), "rb");
+    if (!f) {
+        perror(image.c_str());
+        for(;;);
+    }
+    size_t len = fread(m_data, 1, m_size, f);
+    if (fgetc(f) != EOF) {
+        cerr << name() << " : " << image << " is larger than the memory, truncated to "
+             << len << " bytes" << endl;
+    }
+    fclose(f);
+}
+
+unsigned int zynq7_memory::access(tlm::tlm_generic_payload &trans)
+{
+    uint64_t offset = trans.get_address() - m_base;
+    unsigned int len = trans.get_data_length();
+    unsigned char *data = trans.get_data_ptr();
+    unsigned char *be = trans.get_byte_enable_ptr();
+    unsigned int be_len = trans.get_byte_enable_length();
+
+    if ((trans.get_address() < m_base) || (offset + len > m_size) ||
+        (trans.get_streaming_width() < len)) {
+        trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+        return 0;
+    }
+
+    if (!be && trans.is_read()) {
+        memcpy(data, m_data + offset, len);
+    } else if (!be && trans.is_write()) {
+        memcpy(m_data + offset, data, len);
+    } else {
+        for (unsigned int i = 0; i < len; ++i) {
+            if (!be[i % be_len]) {
+                continue;
+            }
+            if (trans.is_read()) {
+                data[i] = m_data[offset + i];
+            } else {
+                m_data[offset + i] = data[i];
+            }
+        }
+    }
+    trans.set_response_status(tlm::TLM_OK_RESPONSE);
+    return len;
+}
+
+void zynq7_memory::fill_dmi(tlm::tlm_dmi &dmi_data)
+{
+    dmi_data.set_dmi_ptr(m_data);
+    dmi_data.set_start_address(m_base);
+    dmi_data.set_end_address(m_base + m_size - 1);
+    dmi_data.allow_read_write();
+    dmi_data.set_read_latency(SC_ZERO_TIME);
+    dmi_data.set_write_latency(SC_ZERO_TIME);
+}
+
+void zynq7_memory::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    access(trans);
+    trans.set_dmi_allowed(true);
+}
+
+unsigned int zynq7_memory::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+    return access(trans);
+}
+
+bool zynq7_memory::get_direct_mem_ptr(tlm::tlm_generic_payload &trans, tlm::tlm_dmi &dmi_data)
+{
+    fill_dmi(dmi_data);
+    return true;
+}
+
+// The contents of a file-backed memory are on disk at the end of the simulation
+void zynq7_memory::end_of_simulation(void)
+{
+    if (m_file_backed && (msync(m_data, m_size, MS_SYNC) < 0)) {
+        perror("msync");
+    }
+}
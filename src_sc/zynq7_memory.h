@@ -0,0 +1,80 @@
+/*
+ * Memory for Zynq Cosim
+ *
+ * Memory target (e.g., in place of a BRAM or of a DDR on the PL side), it
+ * can be bound to an initiator socket or be served by an address decoder
+ * (see zynq7_addr_decoder.h). The memory is mapped (mmap) :
+ * - from a file when one is given, the file holds the initial contents
+ *   (created and zero-filled if needed) and keeps the written contents
+ *   after the simulation (shared mapping)
+ * - anonymously otherwise (zero-filled pages allocated on first use, so
+ *   large memories cost nothing until accessed)
+ * An image can be loaded at the start of the memory in both cases (e.g.,
+ * firmware or frame buffer). DMI is granted over the whole memory.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_MEMORY_H__
+#define __ZYNQ7_MEMORY_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <string>
+
+class zynq7_memory : public sc_core::sc_module
+{
+public:
+    tlm_utils::simple_target_socket<zynq7_memory> tgt_socket;
+
+    // The addresses of the transactions start at base, the file and the
+    // image are optional (empty)
+    zynq7_memory(sc_core::sc_module_name name, uint64_t base, uint64_t size,
+                 const std::string &file = "", const std::string &image = "");
+    ~zynq7_memory();
+
+    uint64_t base(void) const { return m_base; }
+    uint64_t size(void) const { return m_size; }
+    unsigned char *data(void) { return m_data; }
+
+    // Serves a transaction, returns the number of bytes accessed
+    unsigned int access(tlm::tlm_generic_payload &trans);
+    // Fills the DMI data of the whole memory
+    void fill_dmi(tlm::tlm_dmi &dmi_data);
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    void b_transport(tlm::tlm_generic_payload &trans, sc_core::sc_time &delay);
+    unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans, tlm::tlm_dmi &dmi_data);
+
+    void load_image(const std::string &image);
+
+    uint64_t m_base;
+    uint64_t m_size;
+    unsigned char *m_data;
+    bool m_file_backed;
+};
+
+#endif /* __ZYNQ7_MEMORY_H__ */
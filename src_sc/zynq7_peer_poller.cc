@@ -0,0 +1,116 @@
+/*
+ * Shared socket poller of the QEMU peers for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_peer_poller.h"
+
+#include <stdio.h>
+#include <sys/select.h>
+
+using namespace sc_core;
+using namespace std;
+
+zynq7_peer_poller::zynq7_peer_poller() :
+    m_peers(0)
+{
+}
+
+zynq7_peer_poller &zynq7_peer_poller::instance(void)
+{
+    static zynq7_peer_poller poller;
+    return poller;
+}
+
+void zynq7_peer_poller::add_peer(void)
+{
+    zynq7_peer_poller &poller = instance();
+
+    if (poller.m_peers++ == 0) {
+        sc_spawn(sc_bind(&zynq7_peer_poller::poll, &poller));
+    }
+}
+
+void zynq7_peer_poller::wait_readable(int fd)
+{
+    zynq7_peer_poller &poller = instance();
+    waiter w;
+
+    w.fd = fd;
+    w.ready = false;
+    poller.m_waiting.push_back(&w);
+    poller.m_waiter_event.notify(SC_ZERO_TIME);
+    while (!w.ready) {
+        wait(w.event);
+    }
+}
+
+void zynq7_peer_poller::poll(void)
+{
+    for (;;) {
+        while (m_waiting.empty()) {
+            wait(m_waiter_event);
+        }
+
+        fd_set rfds;
+        int max_fd = -1;
+        FD_ZERO(&rfds);
+        for (size_t i = 0; i < m_waiting.size(); ++i) {
+            FD_SET(m_waiting[i]->fd, &rfds);
+            max_fd = max(max_fd, m_waiting[i]->fd);
+        }
+
+        // Nobody else can advance the simulation, block as a single peer would
+        bool block = (m_waiting.size() == m_peers);
+        struct timeval tv = { 0, 0 };
+        int r = select(max_fd + 1, &rfds, NULL, NULL, block ? NULL : &tv);
+        if (r < 0) {
+            perror("select()");
+            for(;;);
+        }
+
+        if (r > 0) {
+            vector<waiter *> waiting;
+            for (size_t i = 0; i < m_waiting.size(); ++i) {
+                if (FD_ISSET(m_waiting[i]->fd, &rfds)) {
+                    m_waiting[i]->ready = true;
+                    m_waiting[i]->event.notify(SC_ZERO_TIME);
+                } else {
+                    waiting.push_back(m_waiting[i]);
+                }
+            }
+            m_waiting.swap(waiting);
+        }
+
+        // Until the next quantum boundary or a new waiter (the woken peers
+        // wait again once served), not on every event of the simulation
+        sc_dt::uint64 quantum = tlm::tlm_global_quantum::instance().get().value();
+        if (quantum) {
+            sc_dt::uint64 now = sc_time_stamp().value();
+            wait(sc_time::from_value(quantum - now % quantum), m_waiter_event);
+        } else {
+            wait(m_waiter_event);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * Shared socket poller of the QEMU peers for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_PEER_POLLER_H__
+#define __ZYNQ7_PEER_POLLER_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <vector>
+
+// With several Zynq instances, the remote port of each one waits for its
+// QEMU socket here instead of blocking the kernel in read(). A single thread
+// selects on the sockets of all the waiting peers and wakes the ones that are
+// readable :
+// - when all the peers are waiting the select blocks, as the read of a single
+//   instance would
+// - otherwise the simulation goes on and the sockets are polled again when
+//   another peer starts waiting or at the next global quantum boundary, not
+//   on every event of the simulation (e.g., the FCLK edges) nor in a loop of
+//   delta cycles
+class zynq7_peer_poller
+{
+public:
+    // Registers a peer, the poller thread is spawned with the first one
+    // (elaboration or end of elaboration)
+    static void add_peer(void);
+
+    // Returns once fd is readable, set as the wait_peer hook of remoteport_tlm
+    static void wait_readable(int fd);
+
+private:
+    struct waiter {
+        int fd;
+        bool ready;
+        sc_core::sc_event event;
+    };
+
+    zynq7_peer_poller();
+    static zynq7_peer_poller &instance(void);
+    void poll(void);
+
+    unsigned int m_peers;
+    std::vector<waiter *> m_waiting;
+    sc_core::sc_event m_waiter_event;
+};
+
+#endif /* __ZYNQ7_PEER_POLLER_H__ */
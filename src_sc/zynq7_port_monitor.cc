@@ -0,0 +1,125 @@
+/*
+ * AXI port monitor for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_port_monitor.h"
+
+#include <iostream>
+#include <iomanip>
+
+using namespace sc_core;
+using namespace std;
+
+zynq7_port_monitor::zynq7_port_monitor(sc_module_name name, const string &port_name) :
+    sc_module(name),
+    tgt_socket("tgt_socket"),
+    init_socket("init_socket"),
+    m_port_name(port_name),
+    m_trace(false),
+    m_reads(0),
+    m_writes(0),
+    m_read_bytes(0),
+    m_write_bytes(0),
+    m_errors(0),
+    m_busy_time(SC_ZERO_TIME),
+    m_outstanding(0)
+{
+    tgt_socket.register_b_transport(this, &zynq7_port_monitor::b_transport);
+    tgt_socket.register_transport_dbg(this, &zynq7_port_monitor::transport_dbg);
+    tgt_socket.register_get_direct_mem_ptr(this, &zynq7_port_monitor::get_direct_mem_ptr);
+    init_socket.register_invalidate_direct_mem_ptr(this, &zynq7_port_monitor::invalidate_direct_mem_ptr);
+}
+
+void zynq7_port_monitor::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    // Start of the transaction in simulated time (local time included)
+    sc_time start = sc_time_stamp() + delay;
+
+    m_outstanding++;
+    for (size_t i = 0; i < m_observers.size(); ++i) {
+        m_observers[i]->transaction_begin(*this, trans, delay);
+    }
+    init_socket->b_transport(trans, delay);
+    for (size_t i = 0; i < m_observers.size(); ++i) {
+        m_observers[i]->transaction_end(*this, trans, delay);
+    }
+    m_outstanding--;
+
+    sc_time duration = sc_time_stamp() + delay - start;
+    m_busy_time += duration;
+
+    unsigned int len = trans.get_data_length();
+    if (trans.get_command() == tlm::TLM_READ_COMMAND) {
+        m_reads++;
+        m_read_bytes += len;
+    } else if (trans.get_command() == tlm::TLM_WRITE_COMMAND) {
+        m_writes++;
+        m_write_bytes += len;
+    }
+    if (trans.is_response_error()) {
+        m_errors++;
+    }
+
+    if (m_trace) {
+        cout << start << " " << m_port_name << " "
+             << (trans.is_read() ? "RD" : "WR") << " 0x"
+             << hex << setfill('0') << setw(8) << trans.get_address()
+             << dec << setfill(' ') << " len " << len
+             << " took " << duration
+             << (trans.is_response_error() ? " ERROR" : "") << endl;
+    }
+}
+
+// Debug and DMI accesses are only forwarded (they take no simulated time)
+unsigned int zynq7_port_monitor::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+    return init_socket->transport_dbg(trans);
+}
+
+bool zynq7_port_monitor::get_direct_mem_ptr(tlm::tlm_generic_payload &trans, tlm::tlm_dmi &dmi_data)
+{
+    return init_socket->get_direct_mem_ptr(trans, dmi_data);
+}
+
+void zynq7_port_monitor::invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range)
+{
+    tgt_socket->invalidate_direct_mem_ptr(start_range, end_range);
+}
+
+void zynq7_port_monitor::print_summary(ostream &os) const
+{
+    os << m_port_name << " : "
+       << m_reads << " reads (" << m_read_bytes << " bytes), "
+       << m_writes << " writes (" << m_write_bytes << " bytes), "
+       << m_errors << " errors, busy for " << m_busy_time << endl;
+}
+
+void zynq7_port_monitor::end_of_simulation(void)
+{
+    // Only report the ports that have been used
+    if (m_reads || m_writes) {
+        print_summary(cout);
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * AXI port monitor for Zynq Cosim
+ *
+ * TLM pass-through placed between the PS (QEMU) and the bridge of an AXI
+ * port. It counts the transactions going through the port and can trace
+ * them, a summary is printed at the end of the simulation. Other services
+ * can observe the transactions through the zynq7_port_observer interface.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_PORT_MONITOR_H__
+#define __ZYNQ7_PORT_MONITOR_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <string>
+#include <vector>
+
+class zynq7_port_monitor;
+
+// Interface for the services that need to see the transactions of a port
+class zynq7_port_observer
+{
+public:
+    virtual ~zynq7_port_observer() {}
+
+    // Called before the transaction is forwarded, in the context of the
+    // blocking transport (the observer may wait and update the delay)
+    virtual void transaction_begin(zynq7_port_monitor &port,
+                                   tlm::tlm_generic_payload &trans,
+                                   sc_core::sc_time &delay) = 0;
+    // Called once the transaction has completed
+    virtual void transaction_end(zynq7_port_monitor &port,
+                                 tlm::tlm_generic_payload &trans,
+                                 sc_core::sc_time &delay) = 0;
+};
+
+class zynq7_port_monitor : public sc_core::sc_module
+{
+public:
+    tlm_utils::simple_target_socket<zynq7_port_monitor>    tgt_socket;
+    tlm_utils::simple_initiator_socket<zynq7_port_monitor> init_socket;
+
+    zynq7_port_monitor(sc_core::sc_module_name name, const std::string &port_name);
+
+    // Print every transaction (off by default)
+    void set_trace(bool enable) { m_trace = enable; }
+
+    void add_observer(zynq7_port_observer *observer) { m_observers.push_back(observer); }
+
+    // Statistics
+    ///////////////
+    const std::string &port_name(void) const { return m_port_name; }
+    uint64_t reads(void) const { return m_reads; }
+    uint64_t writes(void) const { return m_writes; }
+    uint64_t read_bytes(void) const { return m_read_bytes; }
+    uint64_t write_bytes(void) const { return m_write_bytes; }
+    uint64_t errors(void) const { return m_errors; }
+    // Accumulated (annotated and waited) time spent in transactions
+    const sc_core::sc_time &busy_time(void) const { return m_busy_time; }
+    // Number of transactions currently in the port
+    unsigned int outstanding(void) const { return m_outstanding; }
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    void b_transport(tlm::tlm_generic_payload &trans, sc_core::sc_time &delay);
+    unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans, tlm::tlm_dmi &dmi_data);
+    void invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range);
+
+    std::string m_port_name;
+    bool m_trace;
+    std::vector<zynq7_port_observer *> m_observers;
+
+    uint64_t m_reads;
+    uint64_t m_writes;
+    uint64_t m_read_bytes;
+    uint64_t m_write_bytes;
+    uint64_t m_errors;
+    sc_core::sc_time m_busy_time;
+    unsigned int m_outstanding;
+};
+
+#endif /* __ZYNQ7_PORT_MONITOR_H__ */
@@ -23,6 +23,7 @@
  * THE SOFTWARE.
  */
 
+#include "zynq7_ps_pch.h"
 #include "zynq7_ps.h"
 
 SC_MODULE_EXPORT(zynq7_ps);
@@ -23,30 +23,33 @@
  * THE SOFTWARE.
  */
 
-#define SC_INCLUDE_DYNAMIC_PROCESSES
-
-// C/C++ includes
-#include <inttypes.h>
-#include <stdio.h>
-#include <signal.h>
-#include <unistd.h>
-#include <assert.h>
-
-// System C includes
-#include "systemc.h"
-// System C TLM includes
-#include "tlm_utils/simple_initiator_socket.h"
-#include "tlm_utils/simple_target_socket.h"
-#include "tlm_utils/tlm_quantumkeeper.h"
-
-// Xilinx Zynq
-// https://github.com/Xilinx/libsystemctlm-soc in zynq (moved to soc/xilinx in future revisions)
-#include "xilinx-zynq.h"
-
-// Xilinx Bridges (BFMs)
-// https://github.com/Xilinx/libsystemctlm-soc in tlm-bridges
-#include "tlm2axi-bridge.h"
-#include "axi2tlm-bridge.h"
+#ifndef __ZYNQ7_PS_H__
+#define __ZYNQ7_PS_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_ps_ports.h"
+#include "zynq7_port_monitor.h"
+#include "zynq7_fast_forward.h"
+#include "zynq7_rp_link.h"
+#include "zynq7_fclk_gen.h"
+#include "zynq7_slcr_shadow.h"
+#include "zynq7_traffic_gen.h"
+#include "zynq7_ddr_model.h"
+#include "zynq7_read_cache.h"
+#include "zynq7_addr_decoder.h"
+#include "zynq7_exit.h"
+#include "zynq7_axi_checker.h"
+#include "zynq7_axi_capture.h"
+#include "zynq7_bridge_gate.h"
+#include "zynq7_counters.h"
+#include "zynq7_timeline.h"
+#include "zynq7_peer_poller.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <set>
+#include <sstream>
 
 using namespace sc_core;
 using namespace sc_dt;
@@ -63,6 +66,37 @@ public:
     ///////////////////////
     SC_GENERIC_STRING(QEMU_PATH_TO_SOCKET_G, "unix:/opt/pkg/projects/zynq_project/qemu-tmp/qemu-rport-_cosim@0");
     SC_GENERIC_INT(QEMU_SYNC_QUANTUM_G, 10000);
+    // Connection to QEMU in the background through the link (see zynq7_rp_link.h), retried until
+    // QEMU listens for up to the timeout, the HDL elaborates meanwhile (the simulation then waits
+    // for QEMU at time 0, before the reset, the remote port exchanges its hello first). 0 : the Zynq
+    // model connects directly during the elaboration (QEMU must already be listening)
+    SC_GENERIC_INT(QEMU_CONNECT_TIMEOUT_IN_MS_G, 0);
+    // QEMU command line (shell) launched by the simulator, requires a connection timeout. The QEMU
+    // remote port socket must be the one above. Empty : QEMU is started separately
+    SC_GENERIC_STRING(QEMU_COMMAND_G, "");
+    // QEMU on another host with QEMU_PATH_TO_SOCKET_G = "tcp:host:port" (through the link, without
+    // Nagle). The packets ready at once are written together up to this number of bytes (0 : one
+    // write per packet), the link reports the traffic and round trip time at the end
+    SC_GENERIC_INT(QEMU_LINK_BATCH_IN_BYTES_G, 0);
+
+    // Time scaling
+    /////////////////
+    // HDL time = QEMU time x TIME_SCALE_G, the timestamps exchanged with QEMU are converted by a link
+    // (see zynq7_rp_link.h). When scaled, the FCLK periods below are the real (nominal) ones, e.g., with
+    // a scale of 1000 a 10 ns FCLK is simulated with a 10 us period and the PL still sees the same
+    // number of cycles per CPU instruction as on the real chip. The quantum (and the fast-forward
+    // budget) are given in QEMU time. 1 : no scaling (no link)
+    SC_GENERIC_INT(TIME_SCALE_G, 1);
+
+    // Fast-forward
+    /////////////////
+    // When the PL is idle (no AXI transaction, no IRQ change) for FAST_FORWARD_IDLE_QUANTA_G quanta
+    // QEMU may run up to FAST_FORWARD_BUDGET_IN_NS_G ahead of the simulation and the FCLKs are held,
+    // the time is caught up in one jump on the next PL access. The FCLKs run again after one budget
+    // at most, a PL busy without bus traffic is slowed down but not stalled (see zynq7_fast_forward.h)
+    SC_GENERIC_INT(FAST_FORWARD_G, 0); // 0 : disabled
+    SC_GENERIC_INT(FAST_FORWARD_BUDGET_IN_NS_G, 10000000);
+    SC_GENERIC_INT(FAST_FORWARD_IDLE_QUANTA_G, 10);
 
     // Clocks
     ///////////
@@ -72,6 +106,66 @@ public:
     SC_GENERIC_INT(FCLK_CLK1_PERIOD_IN_NS_G, -1);
     SC_GENERIC_INT(FCLK_CLK2_PERIOD_IN_NS_G, -1);
     SC_GENERIC_INT(FCLK_CLK3_PERIOD_IN_NS_G, -1);
+    // Remote port device id of the SLCR clock and reset shadow (see zynq7_slcr_shadow.h). The writes
+    // of the guest to the real SLCR are not visible : the FCLK periods only follow the guest when it
+    // also writes them to the shadow, which needs a modified QEMU hardware device tree (mapping) and
+    // firmware or clock driver (second write). The PL resets of FPGA_RST_CTRL come from QEMU without
+    // it. Negative value means unused (the FCLK periods are the ones above)
+    SC_GENERIC_INT(SLCR_SHADOW_DEV_ID_G, -1);
+
+    // Port services
+    //////////////////
+    // Print every transaction going through the enabled AXI ports (0 : off)
+    SC_GENERIC_INT(AXI_PORT_TRACE_G, 0);
+    // Timeline of the transactions of the ports, IRQ_F2P edges, PL resets and QEMU syncs in the
+    // Chrome trace event format, in simulated and host time (see zynq7_timeline.h). The syncs are
+    // seen by the link, which is then used. Empty : off
+    SC_GENERIC_STRING(TIMELINE_FILE_G, "");
+    // AXI protocol checkers on the pins of the enabled ports, a violation ends the simulation
+    // (see zynq7_axi_checker.h, 0 : off). Watchdog in cycles of the port clock (0 : off)
+    SC_GENERIC_INT(AXI_CHECKER_G, 0);
+    SC_GENERIC_INT(AXI_WATCHDOG_IN_CYCLES_G, 1000000);
+    // Capture of the last cycles of the AXI channels of the enabled ports, written to
+    // FILE_N.vcd on a violation, an access to the trigger address, an edge of the masked
+    // IRQ_F2P bits or a write to a marker region (see zynq7_axi_capture.h, depth 0 : off)
+    SC_GENERIC_INT(AXI_CAPTURE_DEPTH_G, 0);
+    SC_GENERIC_STRING(AXI_CAPTURE_FILE_G, "axi_capture");
+    SC_GENERIC_STRING(AXI_CAPTURE_TRIGGER_ADDRESS_G, "");
+    SC_GENERIC_INT(AXI_CAPTURE_TRIGGER_IRQ_G, 0);
+    // Suspends the processes of the bridge of an enabled port after this number of idle cycles
+    // (at least 4), until a VALID rises or a transaction comes from QEMU (see zynq7_bridge_gate.h,
+    // 0 : off)
+    SC_GENERIC_INT(AXI_BRIDGE_IDLE_CYCLES_G, 0);
+    // Synthetic traffic in place of the PL master of an HP port (see zynq7_traffic_gen.h for the
+    // syntax), the port must not be enabled. Empty : no generator
+    SC_GENERIC_STRING(S_AXI_HP0_TRAFFIC_G, "");
+    SC_GENERIC_STRING(S_AXI_HP1_TRAFFIC_G, "");
+    SC_GENERIC_STRING(S_AXI_HP2_TRAFFIC_G, "");
+    SC_GENERIC_STRING(S_AXI_HP3_TRAFFIC_G, "");
+    // DDR timing model, arbitrates the S_AXI ports for the DDR controller and delays their
+    // transactions by the time they would take on the chip (see zynq7_ddr_model.h, 0 : off)
+    SC_GENERIC_INT(DDR_MODEL_G, 0);
+    // DDR bandwidth (MB/s, 533 MHz DDR3 x 32 bits by default), access latency and extra latency
+    // of the S_AXI_GP ports (central interconnect)
+    SC_GENERIC_INT(DDR_BANDWIDTH_IN_MBPS_G, 4264);
+    SC_GENERIC_INT(DDR_LATENCY_IN_NS_G, 80);
+    SC_GENERIC_INT(DDR_GP_LATENCY_IN_NS_G, 40);
+    // Idempotent ranges of the M_AXI_GP ports, their repeated reads are answered without the PL
+    // (see zynq7_read_cache.h for the syntax). Empty : no cache
+    SC_GENERIC_STRING(M_AXI_GP0_READ_CACHE_G, "");
+    SC_GENERIC_STRING(M_AXI_GP1_READ_CACHE_G, "");
+    // Lifetime of a cached value in FCLK_CLK0 cycles (initial period), 0 : until invalidated
+    // (write to the range or change of irq_f2p)
+    SC_GENERIC_INT(READ_CACHE_LIFETIME_IN_CYCLES_G, 0);
+    // Address map of the M_AXI_GP ports, the listed ranges are served in SystemC (memories,
+    // decode errors, guest exit) instead of the PL (see zynq7_addr_decoder.h for the syntax).
+    // Empty : all to PL
+    SC_GENERIC_STRING(M_AXI_GP0_ADDR_MAP_G, "");
+    SC_GENERIC_STRING(M_AXI_GP1_ADDR_MAP_G, "");
+    // The slaves of the M_AXI_GP ports are AXI4-Lite, single beat bridge that only drives the
+    // address, data, strobe and response signals (see zynq7_axi_lite_bridge.h, 0 : full AXI)
+    SC_GENERIC_INT(M_AXI_GP0_LITE_G, 0);
+    SC_GENERIC_INT(M_AXI_GP1_LITE_G, 0);
 
     // AXI GP Masters
     ///////////////////
@@ -383,29 +477,71 @@ public:
     static const int S_AXI_HP3_ARUSER_WIDTH_G = 2;
 #endif
 
+    // AXI ACP Slave
+    //////////////////
+
+    SC_GENERIC_INT(S_AXI_ACP_ENABLE_G, 0);
+
+#ifdef __S_AXI_ACP_ADDR_WIDTH__
+    static const int S_AXI_ACP_ADDR_WIDTH_G   = __S_AXI_ACP_ADDR_WIDTH__;
+#else
+    static const int S_AXI_ACP_ADDR_WIDTH_G   = 32;
+#endif
+#ifdef __S_AXI_ACP_DATA_WIDTH__
+    static const int S_AXI_ACP_DATA_WIDTH_G   = __S_AXI_ACP_DATA_WIDTH__;
+#else
+    static const int S_AXI_ACP_DATA_WIDTH_G   = 64;
+#endif
+#ifdef __S_AXI_ACP_ID_WIDTH__
+    static const int S_AXI_ACP_ID_WIDTH_G     = __S_AXI_ACP_ID_WIDTH__;
+#else
+    static const int S_AXI_ACP_ID_WIDTH_G     = 3;
+#endif
+#ifdef __S_AXI_ACP_AXLEN_WIDTH__
+    static const int S_AXI_ACP_AXLEN_WIDTH_G  = __S_AXI_ACP_AXLEN_WIDTH__;
+#else
+    static const int S_AXI_ACP_AXLEN_WIDTH_G  = 4;
+#endif
+#ifdef __S_AXI_ACP_AXLOCK_WIDTH__
+    static const int S_AXI_ACP_AXLOCK_WIDTH_G = __S_AXI_ACP_AXLOCK_WIDTH__;
+#else
+    static const int S_AXI_ACP_AXLOCK_WIDTH_G = 2;
+#endif
+#ifdef __S_AXI_ACP_AWUSER_WIDTH__
+    static const int S_AXI_ACP_AWUSER_WIDTH_G = __S_AXI_ACP_AWUSER_WIDTH__;
+#else
+    static const int S_AXI_ACP_AWUSER_WIDTH_G = 5;
+#endif
+#ifdef __S_AXI_ACP_ARUSER_WIDTH__
+    static const int S_AXI_ACP_ARUSER_WIDTH_G = __S_AXI_ACP_ARUSER_WIDTH__;
+#else
+    static const int S_AXI_ACP_ARUSER_WIDTH_G = 5;
+#endif
+
     /////////////
     // Modules //
     /////////////
+    // Link to QEMU (time scaling, background connection), must be created before the Zynq model connects (NULL when unused)
+    zynq7_rp_link *rp_link;
     xilinx_zynq zynq;
 
     sc_signal<bool> rst, rst_n;
 
     // Clocks
     ///////////
-    sc_clock *fclk_clk0_gen;
-    sc_clock *fclk_clk1_gen;
-    sc_clock *fclk_clk2_gen;
-    sc_clock *fclk_clk3_gen;
+    // Generator of the four clocks (single process)
+    zynq7_fclk_gen *fclk_gen;
     // Clock ports
     sc_out<bool> fclk_clk0;
     sc_out<bool> fclk_clk1;
     sc_out<bool> fclk_clk2;
     sc_out<bool> fclk_clk3;
-    // Clock assign functions (separate because separate sensitivities)
-    inline void fclk_clk0_assign() { fclk_clk0.write(fclk_clk0_gen->signal().read()); }
-    inline void fclk_clk1_assign() { fclk_clk1.write(fclk_clk1_gen->signal().read()); }
-    inline void fclk_clk2_assign() { fclk_clk2.write(fclk_clk2_gen->signal().read()); }
-    inline void fclk_clk3_assign() { fclk_clk3.write(fclk_clk3_gen->signal().read()); }
+
+    // Changes the period of a clock at run time (e.g., SLCR), 0 stops it
+    void set_fclk_period(int n, const sc_time &period) { fclk_gen->set_period(n, period); }
+
+    // Fast-forward (NULL when disabled)
+    zynq7_fast_forward *fast_forward;
 
     /////////
     // AXI //
@@ -414,77 +550,47 @@ public:
     // Bridges
     ////////////
 
-    // Pointer to bridge for M AXI GP0
-    tlm2axi_bridge<M_AXI_GP0_ADDR_WIDTH_G,
-                   M_AXI_GP0_DATA_WIDTH_G,
-                   M_AXI_GP0_ID_WIDTH_G,
-                   M_AXI_GP0_AXLEN_WIDTH_G,
-                   M_AXI_GP0_AXLOCK_WIDTH_G,
-                   M_AXI_GP0_AWUSER_WIDTH_G,
-                   M_AXI_GP0_ARUSER_WIDTH_G> *tlm2axi_gp0;
-
-    // Pointer to bridge for M AXI GP1
-    tlm2axi_bridge<M_AXI_GP1_ADDR_WIDTH_G,
-                   M_AXI_GP1_DATA_WIDTH_G,
-                   M_AXI_GP1_ID_WIDTH_G,
-                   M_AXI_GP1_AXLEN_WIDTH_G,
-                   M_AXI_GP1_AXLOCK_WIDTH_G,
-                   M_AXI_GP1_AWUSER_WIDTH_G,
-                   M_AXI_GP1_ARUSER_WIDTH_G> *tlm2axi_gp1;
-
-    // Pointer to bridge for S AXI GP0
-    axi2tlm_bridge<S_AXI_GP0_ADDR_WIDTH_G,
-                   S_AXI_GP0_DATA_WIDTH_G,
-                   S_AXI_GP0_ID_WIDTH_G,
-                   S_AXI_GP0_AXLEN_WIDTH_G,
-                   S_AXI_GP0_AXLOCK_WIDTH_G,
-                   S_AXI_GP0_AWUSER_WIDTH_G,
-                   S_AXI_GP0_ARUSER_WIDTH_G> *axi2tlm_gp0;
-
-    // Pointer to bridge for S AXI GP1
-    axi2tlm_bridge<S_AXI_GP1_ADDR_WIDTH_G,
-                   S_AXI_GP1_DATA_WIDTH_G,
-                   S_AXI_GP1_ID_WIDTH_G,
-                   S_AXI_GP1_AXLEN_WIDTH_G,
-                   S_AXI_GP1_AXLOCK_WIDTH_G,
-                   S_AXI_GP1_AWUSER_WIDTH_G,
-                   S_AXI_GP1_ARUSER_WIDTH_G> *axi2tlm_gp1;
-
-    // Pointer to bridge for S AXI HP0
-    axi2tlm_bridge<S_AXI_HP0_ADDR_WIDTH_G,
-                   S_AXI_HP0_DATA_WIDTH_G,
-                   S_AXI_HP0_ID_WIDTH_G,
-                   S_AXI_HP0_AXLEN_WIDTH_G,
-                   S_AXI_HP0_AXLOCK_WIDTH_G,
-                   S_AXI_HP0_AWUSER_WIDTH_G,
-                   S_AXI_HP0_ARUSER_WIDTH_G> *axi2tlm_hp0;
-
-    // Pointer to bridge for S AXI HP1
-    axi2tlm_bridge<S_AXI_HP1_ADDR_WIDTH_G,
-                   S_AXI_HP1_DATA_WIDTH_G,
-                   S_AXI_HP1_ID_WIDTH_G,
-                   S_AXI_HP1_AXLEN_WIDTH_G,
-                   S_AXI_HP1_AXLOCK_WIDTH_G,
-                   S_AXI_HP1_AWUSER_WIDTH_G,
-                   S_AXI_HP1_ARUSER_WIDTH_G> *axi2tlm_hp1;
-
-    // Pointer to bridge for S AXI HP2
-    axi2tlm_bridge<S_AXI_HP2_ADDR_WIDTH_G,
-                   S_AXI_HP2_DATA_WIDTH_G,
-                   S_AXI_HP2_ID_WIDTH_G,
-                   S_AXI_HP2_AXLEN_WIDTH_G,
-                   S_AXI_HP2_AXLOCK_WIDTH_G,
-                   S_AXI_HP2_AWUSER_WIDTH_G,
-                   S_AXI_HP2_ARUSER_WIDTH_G> *axi2tlm_hp2;
-
-    // Pointer to bridge for S AXI HP3
-    axi2tlm_bridge<S_AXI_HP3_ADDR_WIDTH_G,
-                   S_AXI_HP3_DATA_WIDTH_G,
-                   S_AXI_HP3_ID_WIDTH_G,
-                   S_AXI_HP3_AXLEN_WIDTH_G,
-                   S_AXI_HP3_AXLOCK_WIDTH_G,
-                   S_AXI_HP3_AWUSER_WIDTH_G,
-                   S_AXI_HP3_ARUSER_WIDTH_G> *axi2tlm_hp3;
+    // The bridges are only created in the per-port translation units
+    // (zynq7_ps_<port>.cc), the other units only hold pointers to them.
+
+    // For every port of the table (see zynq7_ps_ports.h) :
+    // - port_port_t is the descriptor of the port
+    // - port_bridge_t is the type of the bridge of the port
+    // - a pointer to the bridge (e.g., tlm2axi_gp0), NULL when the port is disabled
+#define ZYNQ7_PS_DECLARE_AXI_PORT(PORT, port, member, bridge, KIND, INDEX) \
+    typedef ZYNQ7_PS_AXI_PORT_DESC(PORT, KIND, INDEX) port##_port_t;      \
+    typedef port##_port_t::bridge_t port##_bridge_t;                        \
+    port##_bridge_t *member;
+    ZYNQ7_PS_AXI_PORTS(ZYNQ7_PS_DECLARE_AXI_PORT)
+#undef ZYNQ7_PS_DECLARE_AXI_PORT
+    // AXI4-Lite bridges of the M_AXI_GP ports, in place of the full bridge (NULL then)
+    m_axi_gp0_port_t::lite_bridge_t *axi_lite_gp0;
+    m_axi_gp1_port_t::lite_bridge_t *axi_lite_gp1;
+
+    // Port services
+    //////////////////
+    // Monitors (counters and tracing) of the enabled ports
+    std::vector<zynq7_port_monitor *> port_monitors;
+    // Traffic generators (in place of PL masters)
+    std::vector<zynq7_traffic_gen *> traffic_gens;
+    // DDR timing model (NULL when disabled)
+    zynq7_ddr_model *ddr_model;
+    // Read caches of the M_AXI_GP ports
+    std::vector<zynq7_read_cache *> read_caches;
+    // Address decoders of the M_AXI_GP ports
+    std::vector<zynq7_addr_decoder *> addr_decoders;
+    // Protocol checkers of the enabled ports
+    std::vector<zynq7_axi_checker_base *> axi_checkers;
+    // Capture of the AXI channels (NULL when disabled)
+    zynq7_axi_capture *axi_capture;
+    // Counters read by the guest through a counter region (NULL when unused)
+    zynq7_counters *counters;
+    // Timeline of the simulation (NULL when disabled)
+    zynq7_timeline *timeline;
+    // Gates of the bridges of the enabled ports
+    std::vector<zynq7_bridge_gate *> bridge_gates;
+    // IRQ_F2P on the previous change (capture trigger)
+    unsigned int irq_state;
 
     // M AXI GP0 Ports
     ////////////////////
@@ -1082,6 +1188,82 @@ public:
     //sc_out<AXISignal(ID_WIDTH) > rid;
     sc_out<bool>                             s_axi_hp3_rlast;
 
+    // S AXI ACP Ports
+    ////////////////////
+
+    sc_in<bool>                              s_axi_acp_aclk;
+    sc_in<bool>                              s_axi_acp_aresetn;
+
+    /* Write address channel.  */
+    sc_in<bool>                              s_axi_acp_awvalid;
+    sc_out<bool>                             s_axi_acp_awready;
+    sc_in<sc_bv<S_AXI_ACP_ADDR_WIDTH_G> >    s_axi_acp_awaddr;
+    sc_in<sc_bv<3> >                         s_axi_acp_awprot;
+    //sc_in<sc_bv<S_AXI_ACP_AWUSER_WIDTH_G> >  s_axi_acp_awuser;
+    //sc_in<AXISignal(AWUSER_WIDTH) > awuser;
+    sc_in<sc_bv<4> >                         s_axi_acp_awregion;
+    sc_in<sc_bv<4> >                         s_axi_acp_awqos;
+    sc_in<sc_bv<4> >                         s_axi_acp_awcache;
+    sc_in<sc_bv<2> >                         s_axi_acp_awburst;
+    sc_in<sc_bv<3> >                         s_axi_acp_awsize;
+    sc_in<sc_bv<S_AXI_ACP_AXLEN_WIDTH_G> >   s_axi_acp_awlen;
+    //sc_in<AXISignal(AxLEN_WIDTH) > awlen;
+    sc_in<sc_bv<S_AXI_ACP_ID_WIDTH_G> >      s_axi_acp_awid;
+    //sc_in<AXISignal(ID_WIDTH) > awid;
+    sc_in<sc_bv<S_AXI_ACP_AXLOCK_WIDTH_G> >  s_axi_acp_awlock;
+    //sc_in<AXISignal(AxLOCK_WIDTH) > awlock;
+
+    /* Write data channel.  */
+    //sc_in<sc_bv<S_AXI_ACP_ID_WIDTH_G> >      s_axi_acp_wid;
+    //sc_in<AXISignal(ID_WIDTH) > wid;
+    sc_in<bool>                              s_axi_acp_wvalid;
+    sc_out<bool>                             s_axi_acp_wready;
+    sc_in<sc_bv<S_AXI_ACP_DATA_WIDTH_G> >    s_axi_acp_wdata;
+    sc_in<sc_bv<S_AXI_ACP_DATA_WIDTH_G/8> >  s_axi_acp_wstrb;
+    //sc_in<sc_bv<2> >                         s_axi_acp_wuser;
+    //sc_in<AXISignal(WUSER_WIDTH) > wuser;
+    sc_in<bool>                              s_axi_acp_wlast;
+
+    /* Write response channel.  */
+    sc_out<bool>                             s_axi_acp_bvalid;
+    sc_in<bool>                              s_axi_acp_bready;
+    sc_out<sc_bv<2> >                        s_axi_acp_bresp;
+    //sc_out<sc_bv<2> >                        s_axi_acp_buser;
+    //sc_out<AXISignal(BUSER_WIDTH) > buser;
+    sc_out<sc_bv<S_AXI_ACP_ID_WIDTH_G> >     s_axi_acp_bid;
+    //sc_out<AXISignal(ID_WIDTH) > bid;
+
+    /* Read address channel.  */
+    sc_in<bool>                              s_axi_acp_arvalid;
+    sc_out<bool>                             s_axi_acp_arready;
+    sc_in<sc_bv<S_AXI_ACP_ADDR_WIDTH_G> >    s_axi_acp_araddr;
+    sc_in<sc_bv<3> >                         s_axi_acp_arprot;
+    //sc_in<sc_bv<S_AXI_ACP_ARUSER_WIDTH_G> >  s_axi_acp_aruser;
+    //sc_in<AXISignal(ARUSER_WIDTH) > aruser;
+    sc_in<sc_bv<4> >                         s_axi_acp_arregion;
+    sc_in<sc_bv<4> >                         s_axi_acp_arqos;
+    sc_in<sc_bv<4> >                         s_axi_acp_arcache;
+    sc_in<sc_bv<2> >                         s_axi_acp_arburst;
+    sc_in<sc_bv<3> >                         s_axi_acp_arsize;
+    sc_in<sc_bv<S_AXI_ACP_AXLEN_WIDTH_G> >   s_axi_acp_arlen;
+    //sc_in<AXISignal(AxLEN_WIDTH) > arlen;
+    sc_in<sc_bv<S_AXI_ACP_ID_WIDTH_G> >      s_axi_acp_arid;
+    //sc_in<AXISignal(ID_WIDTH) > arid;
+    sc_in<sc_bv<S_AXI_ACP_AXLOCK_WIDTH_G> >  s_axi_acp_arlock;
+    //sc_in<AXISignal(AxLOCK_WIDTH) > arlock;
+
+    /* Read data channel.  */
+    sc_out<bool>                             s_axi_acp_rvalid;
+    sc_in<bool>                              s_axi_acp_rready;
+    sc_out<sc_bv<S_AXI_ACP_DATA_WIDTH_G> >   s_axi_acp_rdata;
+    sc_out<sc_bv<2> >                        s_axi_acp_rresp;
+    //sc_out<sc_bv<(ACE_MODE == ACE_MODE_ACE) ? 4 : 2> > rresp;
+    //sc_out<sc_bv<2> >                        s_axi_acp_ruser;
+    //sc_out<AXISignal(RUSER_WIDTH) > ruser;
+    sc_out<sc_bv<S_AXI_ACP_ID_WIDTH_G> >     s_axi_acp_rid;
+    //sc_out<AXISignal(ID_WIDTH) > rid;
+    sc_out<bool>                             s_axi_acp_rlast;
+
     ///////// END AXI
 
 
@@ -1097,6 +1279,19 @@ public:
     // Global reset
     sc_out<bool> rst_o;
 
+    // PL resets (FCLK_RESETn_N), from FPGA_RST_CTRL (QEMU wires and SLCR shadow) and the global reset
+    sc_out<bool> fclk_reset0_n;
+    sc_out<bool> fclk_reset1_n;
+    sc_out<bool> fclk_reset2_n;
+    sc_out<bool> fclk_reset3_n;
+
+    // SLCR clock and reset shadow (NULL when unused)
+    remoteport_tlm_memory_master *slcr_rp;
+    zynq7_slcr_shadow *slcr_shadow;
+
+    // End of the simulation on request of the guest (exit regions of the address maps)
+    zynq7_exit *guest_exit;
+
     /////////////
     // Methods //
     /////////////
@@ -1114,11 +1309,93 @@ public:
 
     // Assignations of IRQs
     void assign_irq(void) {
+        if (fast_forward) {
+            fast_forward->notify_activity();
+        }
+        // The PL may have changed its (cached) status registers
+        for (size_t i = 0; i < read_caches.size(); ++i) {
+            read_caches[i]->invalidate();
+        }
         auto tmp_irq = irq_f2p.read();
         for (int i = 0; i < 16; ++i) {
             bool tmp_value = tmp_irq.get_bit(i);
             zynq.pl2ps_irq[i].write(tmp_value);
         }
+        unsigned int changes = tmp_irq.to_uint() ^ irq_state;
+        unsigned int edges = changes & AXI_CAPTURE_TRIGGER_IRQ_G;
+        irq_state = tmp_irq.to_uint();
+        for (int i = 0; timeline && (i < 16); ++i) {
+            if ((changes >> i) & 1) {
+                timeline->irq(i, tmp_irq.get_bit(i));
+            }
+        }
+        if (axi_capture && edges) {
+            std::ostringstream oss;
+            oss << "IRQ_F2P edge 0x" << std::hex << edges;
+            axi_capture->trigger(oss.str());
+        }
+    }
+
+    // The guest wrote a marker (marker region or MARKER register of a counter region)
+    void guest_marker(void)
+    {
+        uint32_t value;
+        for (size_t i = 0; i < addr_decoders.size(); ++i) {
+            while (addr_decoders[i]->take_marker(value)) {
+                std::ostringstream oss;
+                oss << "guest marker 0x" << std::hex << value;
+                cout << sc_time_stamp() << " " << name() << " : " << oss.str();
+                if (fclk_gen) {
+                    cout << " (FCLK0 cycle " << fclk_gen->cycles(0) << ")";
+                }
+                cout << endl;
+                if (timeline) {
+                    timeline->marker(value);
+                }
+                if (axi_capture) {
+                    axi_capture->trigger(oss.str());
+                }
+            }
+        }
+    }
+
+    // The guest wrote its exit status to an exit region
+    void guest_exit_request(void)
+    {
+        for (size_t i = 0; i < addr_decoders.size(); ++i) {
+            if (addr_decoders[i]->exit_requested()) {
+                guest_exit->request(addr_decoders[i]->exit_status());
+            }
+        }
+    }
+
+    // The clocks are held while fast-forwarding
+    void fast_forward_update(void)
+    {
+        fclk_gen->hold(fast_forward->active());
+    }
+
+    // PL resets
+    bool fpga_rst(int n)
+    {
+        bool value = rst.read();
+        if ((size_t) n < zynq.ps2pl_rst.size()) {
+            value |= zynq.ps2pl_rst[n].read();
+        }
+        if (slcr_shadow) {
+            value |= slcr_shadow->fpga_rst[n].read();
+        }
+        return value;
+    }
+    void gen_fclk_resets(void)
+    {
+        fclk_reset0_n.write(!fpga_rst(0));
+        fclk_reset1_n.write(!fpga_rst(1));
+        fclk_reset2_n.write(!fpga_rst(2));
+        fclk_reset3_n.write(!fpga_rst(3));
+        for (int n = 0; timeline && (n < 4); ++n) {
+            timeline->reset(n, fpga_rst(n));
+        }
     }
 
     // Generate negative reset (if needed internally)
@@ -1127,6 +1404,287 @@ public:
         rst_n.write(!rst.read());
     }
 
+    // Time in the simulation for a time (in ns) on the QEMU side
+    sc_time scaled_time(double ns)
+    {
+        return sc_time(ns * TIME_SCALE_G, SC_NS);
+    }
+
+    // QEMU sockets of the instances of the simulation (several boards)
+    static std::set<std::string> &qemu_sockets(void)
+    {
+        static std::set<std::string> sockets;
+        return sockets;
+    }
+
+    // Remote port descriptor the Zynq model connects to, with time scaling, a
+    // background connection, TCP or batching the model connects to the link
+    // (created here) instead of QEMU directly
+    const char *qemu_socket_descr(void)
+    {
+#ifdef __QEMU_PATH_TO_SOCKET__
+        const char *descr = __QEMU_PATH_TO_SOCKET__;
+#else
+        const char *descr = QEMU_PATH_TO_SOCKET_G.c_str();
+#endif
+        // One QEMU per instance
+        if (!qemu_sockets().insert(descr).second) {
+            cerr << name() << " : QEMU socket " << descr << " already used by another instance" << endl;
+            for(;;);
+        }
+        if (!QEMU_COMMAND_G.empty() && (QEMU_CONNECT_TIMEOUT_IN_MS_G <= 0)) {
+            cerr << "QEMU_COMMAND_G requires a QEMU_CONNECT_TIMEOUT_IN_MS_G" << endl;
+            for(;;);
+        }
+        if ((TIME_SCALE_G > 1) || (QEMU_CONNECT_TIMEOUT_IN_MS_G > 0) ||
+            (strncmp(descr, "tcp:", 4) == 0) || (QEMU_LINK_BATCH_IN_BYTES_G > 0) ||
+            !TIMELINE_FILE_G.empty()) {
+            rp_link = new zynq7_rp_link(descr, TIME_SCALE_G, std::max(QEMU_CONNECT_TIMEOUT_IN_MS_G, 0),
+                                        QEMU_COMMAND_G, std::max(QEMU_LINK_BATCH_IN_BYTES_G, 0));
+            return rp_link->descr();
+        }
+        return descr;
+    }
+
+    // Per-port bridge instantiation and binding, each one is defined in its
+    // own translation unit (zynq7_ps_<port>.cc) so the ports are compiled
+    // separately, the compilation script only rebuilds the units that are
+    // out of date (see scripts/generate_sim_files.py)
+#define ZYNQ7_PS_DECLARE_AXI_PORT_INIT(PORT, port, member, bridge, KIND, INDEX) \
+    void init_##port(void);
+    ZYNQ7_PS_AXI_PORTS(ZYNQ7_PS_DECLARE_AXI_PORT_INIT)
+#undef ZYNQ7_PS_DECLARE_AXI_PORT_INIT
+
+    // Creates the bridge and the services of a port and binds the TLM
+    // sockets, the signals are bound by the caller (ZYNQ7_PS_BIND_AXI)
+    // PS is the master : zynq -> monitor -> bridge (tlm2axi)
+    // PL is the master : bridge (axi2tlm) -> monitor -> zynq
+    // BRIDGE replaces the bridge of the port (e.g., AXI4-Lite)
+    template <class PORT, class BRIDGE = typename PORT::bridge_t>
+    BRIDGE *create_axi_port(const char *name)
+    {
+        BRIDGE *bridge = new BRIDGE(name);
+        zynq7_port_monitor *monitor = create_port_monitor(name, PORT::name());
+
+        bind_axi_port(bridge, monitor, PORT::kind, PORT::index, typename PORT::master_tag());
+
+        return bridge;
+    }
+
+    // Protocol checker of a port, NULL when disabled (bound by ZYNQ7_PS_CHECK_AXI)
+    template <class PORT>
+    zynq7_axi_checker<PORT> *create_axi_checker(const char *name)
+    {
+        if ((AXI_CHECKER_G <= 0) && !axi_capture) {
+            return NULL;
+        }
+        zynq7_axi_checker<PORT> *checker =
+            new zynq7_axi_checker<PORT>(name, AXI_CHECKER_G > 0, AXI_WATCHDOG_IN_CYCLES_G);
+        if (axi_capture) {
+            checker->set_capture(axi_capture, PORT::addr_width, PORT::axlen_width, PORT::id_width);
+        }
+        axi_checkers.push_back(checker);
+        return checker;
+    }
+
+    // Gate of the bridge of a port, NULL when disabled (bound by ZYNQ7_PS_GATE_AXI)
+    template <class PORT>
+    zynq7_bridge_gate *create_bridge_gate(sc_object *bridge, const char *name)
+    {
+        zynq7_port_monitor *monitor = find_port_monitor(PORT::name());
+        if ((AXI_BRIDGE_IDLE_CYCLES_G <= 0) || !monitor) {
+            return NULL;
+        }
+        if (AXI_BRIDGE_IDLE_CYCLES_G < (int) zynq7_bridge_gate::MIN_IDLE_CYCLES) {
+            cerr << "AXI_BRIDGE_IDLE_CYCLES_G must be at least " << zynq7_bridge_gate::MIN_IDLE_CYCLES
+                 << " (or 0 : off)" << endl;
+            for(;;);
+        }
+        zynq7_bridge_gate *gate = new zynq7_bridge_gate(name, bridge, monitor, AXI_BRIDGE_IDLE_CYCLES_G);
+        bridge_gates.push_back(gate);
+        return gate;
+    }
+
+    // Monitor of a port (enabled or driven by a traffic generator), NULL if none
+    zynq7_port_monitor *find_port_monitor(const std::string &port_name)
+    {
+        for (size_t i = 0; i < port_monitors.size(); ++i) {
+            if (port_monitors[i]->port_name() == port_name) {
+                return port_monitors[i];
+            }
+        }
+        return NULL;
+    }
+
+    zynq7_port_monitor *create_port_monitor(const char *name, const std::string &port_name)
+    {
+        zynq7_port_monitor *monitor =
+            new zynq7_port_monitor((std::string(name) + "_monitor").c_str(), port_name);
+        monitor->set_trace(AXI_PORT_TRACE_G > 0);
+        port_monitors.push_back(monitor);
+        return monitor;
+    }
+
+    // Traffic generator on a port where the PL is the master :
+    // generator -> monitor -> zynq
+    void create_traffic_gen(zynq7_axi_port_kind kind, int index, bool port_enabled,
+                            const std::string &descr)
+    {
+        if (descr.empty()) {
+            return;
+        }
+
+        std::string port_name = zynq7_axi_port_name(kind, index);
+        std::string error;
+        zynq7_traffic_gen::config cfg;
+        if (port_enabled) {
+            cerr << port_name << " traffic generator : the port is enabled (PL master)" << endl;
+            for(;;);
+        }
+        if (!zynq7_traffic_gen::parse(descr, cfg, error)) {
+            cerr << port_name << " traffic generator : " << error << " (" << descr << ")" << endl;
+            for(;;);
+        }
+        // The start time and the rate are given in QEMU time, as for the DDR model
+        cfg.start = cfg.start * (double) TIME_SCALE_G;
+        cfg.rate_mbps /= TIME_SCALE_G;
+
+        std::string name = "traffic_gen_" + port_name;
+        zynq7_traffic_gen *gen = new zynq7_traffic_gen(name.c_str(), port_name, cfg);
+        zynq7_port_monitor *monitor = create_port_monitor(name.c_str(), port_name);
+        gen->socket.bind(monitor->tgt_socket);
+        monitor->init_socket.bind(*zynq_slave_socket(kind, index));
+        traffic_gens.push_back(gen);
+        if (ddr_model) {
+            ddr_model->add_port(monitor, kind, NULL);
+        }
+    }
+
+    // The DDR model arbitrates the ports where the PL is the master, the QoS
+    // comes from the AxQOS signals of the port (latched at the handshakes)
+    void attach_ddr_port(zynq7_axi_port_kind kind, int index, sc_in<bool> &aclk,
+                         sc_in<bool> &awvalid, sc_out<bool> &awready, sc_in<sc_bv<4> > &awqos,
+                         sc_in<bool> &arvalid, sc_out<bool> &arready, sc_in<sc_bv<4> > &arqos)
+    {
+        std::string port_name = zynq7_axi_port_name(kind, index);
+        zynq7_ddr_model::qos_signals qos = {
+            &aclk, &awvalid, &awready, &awqos, &arvalid, &arready, &arqos
+        };
+
+        for (size_t i = 0; i < port_monitors.size(); ++i) {
+            if (port_monitors[i]->port_name() == port_name) {
+                ddr_model->add_port(port_monitors[i], kind, &qos);
+            }
+        }
+    }
+
+    // PS is the master (M_AXI_GP), nothing to arbitrate
+    void attach_ddr_port(zynq7_axi_port_kind kind, int index, sc_in<bool> &aclk,
+                         sc_out<bool> &awvalid, sc_in<bool> &awready, sc_out<sc_bv<4> > &awqos,
+                         sc_out<bool> &arvalid, sc_in<bool> &arready, sc_out<sc_bv<4> > &arqos) {}
+
+    // zynq -> monitor -> (address decoder) -> (read cache) -> bridge
+    template <class BRIDGE>
+    void bind_axi_port(BRIDGE *bridge, zynq7_port_monitor *monitor,
+                       zynq7_axi_port_kind kind, int index, std::true_type /* PS is the master */)
+    {
+        zynq7_addr_decoder *decoder = create_addr_decoder(index);
+        zynq7_read_cache *cache = create_read_cache(index);
+
+        tlm::tlm_initiator_socket<> *last = &monitor->init_socket;
+
+        zynq.m_axi_gp[index]->bind(monitor->tgt_socket);
+        if (decoder) {
+            last->bind(decoder->tgt_socket);
+            last = &decoder->init_socket;
+        }
+        if (cache) {
+            last->bind(cache->tgt_socket);
+            last = &cache->init_socket;
+        }
+        last->bind(bridge->tgt_socket);
+    }
+
+    // Address decoder of an M_AXI_GP port, NULL when there is no address map
+    zynq7_addr_decoder *create_addr_decoder(int index)
+    {
+        const std::string &descr = index ? M_AXI_GP1_ADDR_MAP_G : M_AXI_GP0_ADDR_MAP_G;
+        if (descr.empty()) {
+            return NULL;
+        }
+
+        std::string port_name = zynq7_axi_port_name(ZYNQ7_M_AXI_GP, index);
+        std::vector<zynq7_addr_decoder::region> regions;
+        std::string error;
+        if (!zynq7_addr_decoder::parse(descr, regions, error)) {
+            cerr << port_name << " address map : " << error << " (" << descr << ")" << endl;
+            for(;;);
+        }
+
+        zynq7_addr_decoder *decoder =
+            new zynq7_addr_decoder(("addr_decoder_" + port_name).c_str(), port_name, regions);
+        addr_decoders.push_back(decoder);
+
+        // Shared by the counter regions of both ports
+        for (size_t i = 0; i < regions.size(); ++i) {
+            if (regions[i].kind == zynq7_addr_decoder::COUNTER) {
+                if (!counters) {
+                    counters = new zynq7_counters("counters");
+                }
+                decoder->set_counters(counters);
+            }
+        }
+        return decoder;
+    }
+
+    // Read cache of an M_AXI_GP port, NULL when no range is declared
+    zynq7_read_cache *create_read_cache(int index)
+    {
+        const std::string &descr = index ? M_AXI_GP1_READ_CACHE_G : M_AXI_GP0_READ_CACHE_G;
+        if (descr.empty()) {
+            return NULL;
+        }
+
+        std::string port_name = zynq7_axi_port_name(ZYNQ7_M_AXI_GP, index);
+        std::vector<zynq7_read_cache::range> ranges;
+        std::string error;
+        if (!zynq7_read_cache::parse(descr, ranges, error)) {
+            cerr << port_name << " read cache : " << error << " (" << descr << ")" << endl;
+            for(;;);
+        }
+
+        zynq7_read_cache *cache =
+            new zynq7_read_cache(("read_cache_" + port_name).c_str(), port_name, ranges,
+                                 scaled_time(FCLK_CLK0_PERIOD_IN_NS_G) * READ_CACHE_LIFETIME_IN_CYCLES_G);
+        read_caches.push_back(cache);
+        return cache;
+    }
+
+    template <class BRIDGE>
+    void bind_axi_port(BRIDGE *bridge, zynq7_port_monitor *monitor,
+                       zynq7_axi_port_kind kind, int index, std::false_type /* PL is the master */)
+    {
+        bridge->socket.bind(monitor->tgt_socket);
+        monitor->init_socket.bind(*zynq_slave_socket(kind, index));
+    }
+
+    // Target socket of the PS for a port where the PL is the master
+    tlm_utils::simple_target_socket<remoteport_tlm_memory_slave> *
+    zynq_slave_socket(zynq7_axi_port_kind kind, int index)
+    {
+        switch (kind) {
+        case ZYNQ7_S_AXI_GP:
+            return zynq.s_axi_gp[index];
+        case ZYNQ7_S_AXI_HP:
+            return zynq.s_axi_hp[index];
+        case ZYNQ7_S_AXI_ACP:
+            return zynq.s_axi_acp;
+        default:
+            assert(false); // PS is the master on the other ports
+            return NULL;
+        }
+    }
+
     SC_HAS_PROCESS(zynq7_ps);
     // The combination of SC_HAS_PROCESS and a normal constructor replaces the use of SC_CTOR
     // SC_HAS_PROCESS is only needed if you have SC_THREADs or SC_METHODs in your module! If there are no processes then you don't need SC_HAS_PROCESS.
@@ -1140,11 +1698,45 @@ public:
         // QEMU
         SC_INIT_GENERIC_STRING(QEMU_PATH_TO_SOCKET_G),
         SC_INIT_GENERIC_INT(QEMU_SYNC_QUANTUM_G),
+        SC_INIT_GENERIC_INT(QEMU_CONNECT_TIMEOUT_IN_MS_G),
+        SC_INIT_GENERIC_STRING(QEMU_COMMAND_G),
+        SC_INIT_GENERIC_INT(QEMU_LINK_BATCH_IN_BYTES_G),
+        // Time scaling
+        SC_INIT_GENERIC_INT(TIME_SCALE_G),
+        // Fast-forward
+        SC_INIT_GENERIC_INT(FAST_FORWARD_G),
+        SC_INIT_GENERIC_INT(FAST_FORWARD_BUDGET_IN_NS_G),
+        SC_INIT_GENERIC_INT(FAST_FORWARD_IDLE_QUANTA_G),
         // Clocks
         SC_INIT_GENERIC_INT(FCLK_CLK0_PERIOD_IN_NS_G),
         SC_INIT_GENERIC_INT(FCLK_CLK1_PERIOD_IN_NS_G),
         SC_INIT_GENERIC_INT(FCLK_CLK2_PERIOD_IN_NS_G),
         SC_INIT_GENERIC_INT(FCLK_CLK3_PERIOD_IN_NS_G),
+        SC_INIT_GENERIC_INT(SLCR_SHADOW_DEV_ID_G),
+        // Port services
+        SC_INIT_GENERIC_INT(AXI_PORT_TRACE_G),
+        SC_INIT_GENERIC_INT(AXI_CHECKER_G),
+        SC_INIT_GENERIC_INT(AXI_WATCHDOG_IN_CYCLES_G),
+        SC_INIT_GENERIC_INT(AXI_CAPTURE_DEPTH_G),
+        SC_INIT_GENERIC_STRING(AXI_CAPTURE_FILE_G),
+        SC_INIT_GENERIC_STRING(AXI_CAPTURE_TRIGGER_ADDRESS_G),
+        SC_INIT_GENERIC_INT(AXI_CAPTURE_TRIGGER_IRQ_G),
+        SC_INIT_GENERIC_INT(AXI_BRIDGE_IDLE_CYCLES_G),
+        SC_INIT_GENERIC_STRING(S_AXI_HP0_TRAFFIC_G),
+        SC_INIT_GENERIC_STRING(S_AXI_HP1_TRAFFIC_G),
+        SC_INIT_GENERIC_STRING(S_AXI_HP2_TRAFFIC_G),
+        SC_INIT_GENERIC_STRING(S_AXI_HP3_TRAFFIC_G),
+        SC_INIT_GENERIC_INT(DDR_MODEL_G),
+        SC_INIT_GENERIC_INT(DDR_BANDWIDTH_IN_MBPS_G),
+        SC_INIT_GENERIC_INT(DDR_LATENCY_IN_NS_G),
+        SC_INIT_GENERIC_INT(DDR_GP_LATENCY_IN_NS_G),
+        SC_INIT_GENERIC_STRING(M_AXI_GP0_READ_CACHE_G),
+        SC_INIT_GENERIC_STRING(M_AXI_GP1_READ_CACHE_G),
+        SC_INIT_GENERIC_INT(READ_CACHE_LIFETIME_IN_CYCLES_G),
+        SC_INIT_GENERIC_STRING(M_AXI_GP0_ADDR_MAP_G),
+        SC_INIT_GENERIC_STRING(M_AXI_GP1_ADDR_MAP_G),
+        SC_INIT_GENERIC_INT(M_AXI_GP0_LITE_G),
+        SC_INIT_GENERIC_INT(M_AXI_GP1_LITE_G),
         // M AXI GP0
         SC_INIT_GENERIC_INT(M_AXI_GP0_ENABLE_G),
         // M AXI GP1
@@ -1161,20 +1753,31 @@ public:
         SC_INIT_GENERIC_INT(S_AXI_HP2_ENABLE_G),
         // S AXI HP3
         SC_INIT_GENERIC_INT(S_AXI_HP3_ENABLE_G),
+        // S AXI ACP
+        SC_INIT_GENERIC_INT(S_AXI_ACP_ENABLE_G),
 
         // Modules
         ////////////
 
         // Set the path to the socket from the generic parameter
-#ifdef __QEMU_PATH_TO_SOCKET__
-        zynq("zynq", __QEMU_PATH_TO_SOCKET__),
-#else
-        zynq("zynq", QEMU_PATH_TO_SOCKET_G.c_str()),
-#endif
+        rp_link(NULL),
+        zynq("zynq", qemu_socket_descr()),
 
         // Signals
         ////////////
-        rst("rst")
+        rst("rst"),
+
+        // Services
+        /////////////
+        fast_forward(NULL),
+        ddr_model(NULL),
+        axi_capture(NULL),
+        counters(NULL),
+        timeline(NULL),
+        irq_state(0),
+        slcr_rp(NULL),
+        slcr_shadow(NULL),
+        guest_exit(NULL)
     {
         // QEMU related
         /////////////////
@@ -1183,8 +1786,15 @@ public:
 #else
         cout << "QEMU connection path is : " << QEMU_PATH_TO_SOCKET_G << endl;
 #endif
-        // Set the global sim time quantum from the generic parameter
-        m_qk.set_global_quantum(sc_time((double) QEMU_SYNC_QUANTUM_G, SC_NS));
+        if (rp_link) {
+            cout << "Time scale is " << TIME_SCALE_G << ", the Zynq connects through : " << rp_link->descr() << endl;
+        }
+        // Set the global sim time quantum from the generic parameter, it is shared
+        // by the instances, the smallest one is used
+        sc_time quantum = scaled_time(QEMU_SYNC_QUANTUM_G);
+        if ((qemu_sockets().size() == 1) || (quantum < m_qk.get_global_quantum())) {
+            m_qk.set_global_quantum(quantum);
+        }
 
         // Reset
         //////////
@@ -1197,644 +1807,136 @@ public:
         // AXI Interfaces //
         ////////////////////
 
-        // M AXI GP0
-        //////////////
-        if (M_AXI_GP0_ENABLE_G > 0) {
-            tlm2axi_gp0 = new tlm2axi_bridge<M_AXI_GP0_ADDR_WIDTH_G,
-                                             M_AXI_GP0_DATA_WIDTH_G,
-                                             M_AXI_GP0_ID_WIDTH_G,
-                                             M_AXI_GP0_AXLEN_WIDTH_G,
-                                             M_AXI_GP0_AXLOCK_WIDTH_G,
-                                             M_AXI_GP0_AWUSER_WIDTH_G,
-                                             M_AXI_GP0_ARUSER_WIDTH_G>("tlm2axi_gp0");
-
-            zynq.m_axi_gp[0]->bind(tlm2axi_gp0->tgt_socket);
-
-            // Note : Commented signal assignations below are connected to dummy internally (in bridge) e.g., awuser
-
-            /* Clock and Reset */
-            /* sc_in<bool>                      */ tlm2axi_gp0->clk(     m_axi_gp0_aclk    );
-            /* sc_in<bool>                      */ tlm2axi_gp0->resetn(  m_axi_gp0_aresetn );
-
-            /* Write address channel.  */
-            /* sc_out<bool >                    */ tlm2axi_gp0->awvalid( m_axi_gp0_awvalid );
-            /* sc_in<bool >                     */ tlm2axi_gp0->awready( m_axi_gp0_awready );
-            /* sc_out<sc_bv<ADDR_WIDTH> >       */ tlm2axi_gp0->awaddr(  m_axi_gp0_awaddr  );
-            /* sc_out<sc_bv<3> >                */ tlm2axi_gp0->awprot(  m_axi_gp0_awprot  );
-            /* sc_out<AXISignal(AWUSER_WIDTH) > */ //tlm2axi_gp0->awuser();
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp0->awregion(m_axi_gp0_awregion);
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp0->awqos(   m_axi_gp0_awqos   );
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp0->awcache( m_axi_gp0_awcache );
-            /* sc_out<sc_bv<2> >                */ tlm2axi_gp0->awburst( m_axi_gp0_awburst );
-            /* sc_out<sc_bv<3> >                */ tlm2axi_gp0->awsize(  m_axi_gp0_awsize  );
-            /* sc_out<AXISignal(AxLEN_WIDTH) >  */ tlm2axi_gp0->awlen(   m_axi_gp0_awlen   );
-            /* sc_out<AXISignal(ID_WIDTH) >     */ tlm2axi_gp0->awid(    m_axi_gp0_awid    );
-            /* sc_out<AXISignal(AxLOCK_WIDTH) > */ tlm2axi_gp0->awlock(  m_axi_gp0_awlock  );
-
-            /* Write data channel.  */
-            /* sc_out<AXISignal(ID_WIDTH) >    */  //tlm2axi_gp0->wid(     m_axi_gp0_wid    );
-            /* sc_out<bool >                   */  tlm2axi_gp0->wvalid(  m_axi_gp0_wvalid );
-            /* sc_in<bool >                    */  tlm2axi_gp0->wready(  m_axi_gp0_wready );
-            /* sc_out<sc_bv<DATA_WIDTH> >      */  tlm2axi_gp0->wdata(   m_axi_gp0_wdata  );
-            /* sc_out<sc_bv<DATA_WIDTH/8> >    */  tlm2axi_gp0->wstrb(   m_axi_gp0_wstrb  );
-            /* sc_out<AXISignal(WUSER_WIDTH) > */  //tlm2axi_gp0->wuser();
-            /* sc_out<bool >                   */  tlm2axi_gp0->wlast(   m_axi_gp0_wlast  );
-
-            /* Write response channel.  */
-            /* sc_in<bool >                   */   tlm2axi_gp0->bvalid(  m_axi_gp0_bvalid );
-            /* sc_out<bool >                  */   tlm2axi_gp0->bready(  m_axi_gp0_bready );
-            /* sc_in<sc_bv<2> >               */   tlm2axi_gp0->bresp(   m_axi_gp0_bresp  );
-            /* sc_in<AXISignal(BUSER_WIDTH) > */   //tlm2axi_gp0->buser();
-            /* sc_in<AXISignal(ID_WIDTH) >    */   tlm2axi_gp0->bid(     m_axi_gp0_bid    );
-
-            /* Read address channel.  */
-            /* sc_out<bool >                    */ tlm2axi_gp0->arvalid( m_axi_gp0_arvalid );
-            /* sc_in<bool >                     */ tlm2axi_gp0->arready( m_axi_gp0_arready );
-            /* sc_out<sc_bv<ADDR_WIDTH> >       */ tlm2axi_gp0->araddr ( m_axi_gp0_araddr  );
-            /* sc_out<sc_bv<3> >                */ tlm2axi_gp0->arprot ( m_axi_gp0_arprot  );
-            /* sc_out<AXISignal(ARUSER_WIDTH) > */ //tlm2axi_gp0->aruser();
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp0->arregion(m_axi_gp0_arregion);
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp0->arqos  ( m_axi_gp0_arqos   );
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp0->arcache( m_axi_gp0_arcache );
-            /* sc_out<sc_bv<2> >                */ tlm2axi_gp0->arburst( m_axi_gp0_arburst );
-            /* sc_out<sc_bv<3> >                */ tlm2axi_gp0->arsize(  m_axi_gp0_arsize  );
-            /* sc_out<AXISignal(AxLEN_WIDTH) >  */ tlm2axi_gp0->arlen(   m_axi_gp0_arlen   );
-            /* sc_out<AXISignal(ID_WIDTH) >     */ tlm2axi_gp0->arid(    m_axi_gp0_arid    );
-            /* sc_out<AXISignal(AxLOCK_WIDTH) > */ tlm2axi_gp0->arlock(  m_axi_gp0_arlock  );
-
-            /* Read data channel.  */
-            /* sc_in<bool >                   */   tlm2axi_gp0->rvalid(  m_axi_gp0_rvalid );
-            /* sc_out<bool >                  */   tlm2axi_gp0->rready(  m_axi_gp0_rready );
-            /* sc_in<sc_bv<DATA_WIDTH> >      */   tlm2axi_gp0->rdata(   m_axi_gp0_rdata  );
-            /* sc_in<sc_bv<2> >               */   tlm2axi_gp0->rresp(   m_axi_gp0_rresp  );
-            /* sc_in<AXISignal(RUSER_WIDTH) > */   //tlm2axi_gp0->ruser();
-            /* sc_in<AXISignal(ID_WIDTH) >    */   tlm2axi_gp0->rid(     m_axi_gp0_rid    );
-            /* sc_in<bool >                   */   tlm2axi_gp0->rlast(   m_axi_gp0_rlast  );
-
+        // DDR model, before the ports so it sees their transactions first
+        if (DDR_MODEL_G > 0) {
+            ddr_model = new zynq7_ddr_model("ddr_model",
+                                            DDR_BANDWIDTH_IN_MBPS_G * 1e6 / TIME_SCALE_G,
+                                            scaled_time(DDR_LATENCY_IN_NS_G),
+                                            scaled_time(DDR_GP_LATENCY_IN_NS_G));
         }
 
-        // M AXI GP1
-        //////////////
-        if (M_AXI_GP1_ENABLE_G > 0) {
-            tlm2axi_gp1 = new tlm2axi_bridge<M_AXI_GP1_ADDR_WIDTH_G,
-                                             M_AXI_GP1_DATA_WIDTH_G,
-                                             M_AXI_GP1_ID_WIDTH_G,
-                                             M_AXI_GP1_AXLEN_WIDTH_G,
-                                             M_AXI_GP1_AXLOCK_WIDTH_G,
-                                             M_AXI_GP1_AWUSER_WIDTH_G,
-                                             M_AXI_GP1_ARUSER_WIDTH_G>("tlm2axi_gp1");
-
-            zynq.m_axi_gp[1]->bind(tlm2axi_gp1->tgt_socket);
-
-            // Note : Commented signal assignations below are connected to dummy internally (in bridge) e.g., awuser
-
-            /* Clock and Reset */
-            /* sc_in<bool>                      */ tlm2axi_gp1->clk(     m_axi_gp1_aclk    );
-            /* sc_in<bool>                      */ tlm2axi_gp1->resetn(  m_axi_gp1_aresetn );
-
-            /* Write address channel.  */
-            /* sc_out<bool >                    */ tlm2axi_gp1->awvalid( m_axi_gp1_awvalid );
-            /* sc_in<bool >                     */ tlm2axi_gp1->awready( m_axi_gp1_awready );
-            /* sc_out<sc_bv<ADDR_WIDTH> >       */ tlm2axi_gp1->awaddr(  m_axi_gp1_awaddr  );
-            /* sc_out<sc_bv<3> >                */ tlm2axi_gp1->awprot(  m_axi_gp1_awprot  );
-            /* sc_out<AXISignal(AWUSER_WIDTH) > */ //tlm2axi_gp1->awuser();
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp1->awregion(m_axi_gp1_awregion);
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp1->awqos(   m_axi_gp1_awqos   );
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp1->awcache( m_axi_gp1_awcache );
-            /* sc_out<sc_bv<2> >                */ tlm2axi_gp1->awburst( m_axi_gp1_awburst );
-            /* sc_out<sc_bv<3> >                */ tlm2axi_gp1->awsize(  m_axi_gp1_awsize  );
-            /* sc_out<AXISignal(AxLEN_WIDTH) >  */ tlm2axi_gp1->awlen(   m_axi_gp1_awlen   );
-            /* sc_out<AXISignal(ID_WIDTH) >     */ tlm2axi_gp1->awid(    m_axi_gp1_awid    );
-            /* sc_out<AXISignal(AxLOCK_WIDTH) > */ tlm2axi_gp1->awlock(  m_axi_gp1_awlock  );
-
-            /* Write data channel.  */
-            /* sc_out<AXISignal(ID_WIDTH) >    */  //tlm2axi_gp1->wid(     m_axi_gp1_wid    );
-            /* sc_out<bool >                   */  tlm2axi_gp1->wvalid(  m_axi_gp1_wvalid );
-            /* sc_in<bool >                    */  tlm2axi_gp1->wready(  m_axi_gp1_wready );
-            /* sc_out<sc_bv<DATA_WIDTH> >      */  tlm2axi_gp1->wdata(   m_axi_gp1_wdata  );
-            /* sc_out<sc_bv<DATA_WIDTH/8> >    */  tlm2axi_gp1->wstrb(   m_axi_gp1_wstrb  );
-            /* sc_out<AXISignal(WUSER_WIDTH) > */  //tlm2axi_gp1->wuser();
-            /* sc_out<bool >                   */  tlm2axi_gp1->wlast(   m_axi_gp1_wlast  );
-
-            /* Write response channel.  */
-            /* sc_in<bool >                   */   tlm2axi_gp1->bvalid(  m_axi_gp1_bvalid );
-            /* sc_out<bool >                  */   tlm2axi_gp1->bready(  m_axi_gp1_bready );
-            /* sc_in<sc_bv<2> >               */   tlm2axi_gp1->bresp(   m_axi_gp1_bresp  );
-            /* sc_in<AXISignal(BUSER_WIDTH) > */   //tlm2axi_gp1->buser();
-            /* sc_in<AXISignal(ID_WIDTH) >    */   tlm2axi_gp1->bid(     m_axi_gp1_bid    );
-
-            /* Read address channel.  */
-            /* sc_out<bool >                    */ tlm2axi_gp1->arvalid( m_axi_gp1_arvalid );
-            /* sc_in<bool >                     */ tlm2axi_gp1->arready( m_axi_gp1_arready );
-            /* sc_out<sc_bv<ADDR_WIDTH> >       */ tlm2axi_gp1->araddr ( m_axi_gp1_araddr  );
-            /* sc_out<sc_bv<3> >                */ tlm2axi_gp1->arprot ( m_axi_gp1_arprot  );
-            /* sc_out<AXISignal(ARUSER_WIDTH) > */ //tlm2axi_gp1->aruser();
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp1->arregion(m_axi_gp1_arregion);
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp1->arqos  ( m_axi_gp1_arqos   );
-            /* sc_out<sc_bv<4> >                */ tlm2axi_gp1->arcache( m_axi_gp1_arcache );
-            /* sc_out<sc_bv<2> >                */ tlm2axi_gp1->arburst( m_axi_gp1_arburst );
-            /* sc_out<sc_bv<3> >                */ tlm2axi_gp1->arsize(  m_axi_gp1_arsize  );
-            /* sc_out<AXISignal(AxLEN_WIDTH) >  */ tlm2axi_gp1->arlen(   m_axi_gp1_arlen   );
-            /* sc_out<AXISignal(ID_WIDTH) >     */ tlm2axi_gp1->arid(    m_axi_gp1_arid    );
-            /* sc_out<AXISignal(AxLOCK_WIDTH) > */ tlm2axi_gp1->arlock(  m_axi_gp1_arlock  );
-
-            /* Read data channel.  */
-            /* sc_in<bool >                   */   tlm2axi_gp1->rvalid(  m_axi_gp1_rvalid );
-            /* sc_out<bool >                  */   tlm2axi_gp1->rready(  m_axi_gp1_rready );
-            /* sc_in<sc_bv<DATA_WIDTH> >      */   tlm2axi_gp1->rdata(   m_axi_gp1_rdata  );
-            /* sc_in<sc_bv<2> >               */   tlm2axi_gp1->rresp(   m_axi_gp1_rresp  );
-            /* sc_in<AXISignal(RUSER_WIDTH) > */   //tlm2axi_gp1->ruser();
-            /* sc_in<AXISignal(ID_WIDTH) >    */   tlm2axi_gp1->rid(     m_axi_gp1_rid    );
-            /* sc_in<bool >                   */   tlm2axi_gp1->rlast(   m_axi_gp1_rlast  );
+        // AXI capture, before the ports so their checkers record to it
+        if (AXI_CAPTURE_DEPTH_G > 0) {
+            axi_capture = new zynq7_axi_capture("axi_capture", AXI_CAPTURE_DEPTH_G, AXI_CAPTURE_FILE_G);
+            std::string addr = AXI_CAPTURE_TRIGGER_ADDRESS_G;
+            if (!addr.empty()) {
+                char *end;
+                uint64_t value = strtoull(addr.c_str(), &end, 0);
+                if (*end) {
+                    cerr << "AXI capture : invalid trigger address " << addr << endl;
+                    for(;;);
+                }
+                axi_capture->set_trigger_address(value);
+            }
         }
 
-        // S AXI GP0
-        //////////////
-        if (S_AXI_GP0_ENABLE_G > 0) {
-            axi2tlm_gp0 = new axi2tlm_bridge<S_AXI_GP0_ADDR_WIDTH_G,
-                                             S_AXI_GP0_DATA_WIDTH_G,
-                                             S_AXI_GP0_ID_WIDTH_G,
-                                             S_AXI_GP0_AXLEN_WIDTH_G,
-                                             S_AXI_GP0_AXLOCK_WIDTH_G,
-                                             S_AXI_GP0_AWUSER_WIDTH_G,
-                                             S_AXI_GP0_ARUSER_WIDTH_G> ("axi2tlm_gp0");
-
-            zynq.s_axi_gp[0]->bind(axi2tlm_gp0->socket);
-
-            // Note : Commented signal assignations below are connected to dummy internally (in bridge) e.g., awuser
-
-            /* Clock and Reset */
-            /* sc_in<bool>                     */ axi2tlm_gp0->clk(     s_axi_gp0_aclk    );
-            /* sc_in<bool>                     */ axi2tlm_gp0->resetn(  s_axi_gp0_aresetn );
-
-            /* Write address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_gp0->awvalid( s_axi_gp0_awvalid );
-            /* sc_out<bool>                    */ axi2tlm_gp0->awready( s_axi_gp0_awready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_gp0->awaddr(  s_axi_gp0_awaddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_gp0->awprot(  s_axi_gp0_awprot  );
-            /* sc_in<AXISignal(AWUSER_WIDTH) > */ //axi2tlm_gp0->awuser(  s_axi_gp0_awuser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp0->awregion(s_axi_gp0_awregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp0->awqos(   s_axi_gp0_awqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp0->awcache( s_axi_gp0_awcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_gp0->awburst( s_axi_gp0_awburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_gp0->awsize(  s_axi_gp0_awsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_gp0->awlen(   s_axi_gp0_awlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_gp0->awid(    s_axi_gp0_awid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_gp0->awlock(  s_axi_gp0_awlock  );
-
-            /* Write data channel.  */
-            /* sc_in<AXISignal(ID_WIDTH) >     */ //axi2tlm_gp0->wid(     s_axi_gp0_wid     );
-            /* sc_in<bool>                     */ axi2tlm_gp0->wvalid(  s_axi_gp0_wvalid  );
-            /* sc_out<bool>                    */ axi2tlm_gp0->wready(  s_axi_gp0_wready  );
-            /* sc_in<sc_bv<DATA_WIDTH> >       */ axi2tlm_gp0->wdata(   s_axi_gp0_wdata   );
-            /* sc_in<sc_bv<DATA_WIDTH/8> >     */ axi2tlm_gp0->wstrb(   s_axi_gp0_wstrb   );
-            /* sc_in<AXISignal(WUSER_WIDTH) >  */ //axi2tlm_gp0->wuser(   s_axi_gp0_wuser   );
-            /* sc_in<bool>                     */ axi2tlm_gp0->wlast(   s_axi_gp0_wlast   );
-
-            /* Write response channel.  */
-            /* sc_out<bool>                    */ axi2tlm_gp0->bvalid(  s_axi_gp0_bvalid  );
-            /* sc_in<bool>                     */ axi2tlm_gp0->bready(  s_axi_gp0_bready  );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_gp0->bresp(   s_axi_gp0_bresp   );
-            /* sc_out<AXISignal(BUSER_WIDTH) > */ //axi2tlm_gp0->buser(   s_axi_gp0_buser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_gp0->bid(     s_axi_gp0_bid     );
-
-            /* Read address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_gp0->arvalid( s_axi_gp0_arvalid );
-            /* sc_out<bool>                    */ axi2tlm_gp0->arready( s_axi_gp0_arready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_gp0->araddr(  s_axi_gp0_araddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_gp0->arprot(  s_axi_gp0_arprot  );
-            /* sc_in<AXISignal(ARUSER_WIDTH) > */ //axi2tlm_gp0->aruser(  s_axi_gp0_aruser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp0->arregion(s_axi_gp0_arregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp0->arqos(   s_axi_gp0_arqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp0->arcache( s_axi_gp0_arcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_gp0->arburst( s_axi_gp0_arburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_gp0->arsize(  s_axi_gp0_arsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_gp0->arlen(   s_axi_gp0_arlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_gp0->arid(    s_axi_gp0_arid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_gp0->arlock(  s_axi_gp0_arlock  );
-
-            /* Read data channel.  */
-            /* sc_out<bool>                    */ axi2tlm_gp0->rvalid(  s_axi_gp0_rvalid  );
-            /* sc_in<bool>                     */ axi2tlm_gp0->rready(  s_axi_gp0_rready  );
-            /* sc_out<sc_bv<DATA_WIDTH> >      */ axi2tlm_gp0->rdata(   s_axi_gp0_rdata   );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_gp0->rresp(   s_axi_gp0_rresp   );
-            /* sc_out<AXISignal(RUSER_WIDTH) > */ //axi2tlm_gp0->ruser(   s_axi_gp0_ruser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_gp0->rid(     s_axi_gp0_rid     );
-            /* sc_out<bool>                    */ axi2tlm_gp0->rlast(   s_axi_gp0_rlast   );
-        }
-
-        // S AXI GP1
-        //////////////
-        if (S_AXI_GP1_ENABLE_G > 0) {
-            axi2tlm_gp1 = new axi2tlm_bridge<S_AXI_GP1_ADDR_WIDTH_G,
-                                             S_AXI_GP1_DATA_WIDTH_G,
-                                             S_AXI_GP1_ID_WIDTH_G,
-                                             S_AXI_GP1_AXLEN_WIDTH_G,
-                                             S_AXI_GP1_AXLOCK_WIDTH_G,
-                                             S_AXI_GP1_AWUSER_WIDTH_G,
-                                             S_AXI_GP1_ARUSER_WIDTH_G> ("axi2tlm_gp1");
-
-            zynq.s_axi_gp[1]->bind(axi2tlm_gp1->socket);
-
-            // Note : Commented signal assignations below are connected to dummy internally (in bridge) e.g., awuser
-
-            /* Clock and Reset */
-            /* sc_in<bool>                     */ axi2tlm_gp1->clk(     s_axi_gp1_aclk    );
-            /* sc_in<bool>                     */ axi2tlm_gp1->resetn(  s_axi_gp1_aresetn );
-
-            /* Write address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_gp1->awvalid( s_axi_gp1_awvalid );
-            /* sc_out<bool>                    */ axi2tlm_gp1->awready( s_axi_gp1_awready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_gp1->awaddr(  s_axi_gp1_awaddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_gp1->awprot(  s_axi_gp1_awprot  );
-            /* sc_in<AXISignal(AWUSER_WIDTH) > */ //axi2tlm_gp1->awuser(  s_axi_gp1_awuser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp1->awregion(s_axi_gp1_awregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp1->awqos(   s_axi_gp1_awqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp1->awcache( s_axi_gp1_awcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_gp1->awburst( s_axi_gp1_awburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_gp1->awsize(  s_axi_gp1_awsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_gp1->awlen(   s_axi_gp1_awlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_gp1->awid(    s_axi_gp1_awid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_gp1->awlock(  s_axi_gp1_awlock  );
-
-            /* Write data channel.  */
-            /* sc_in<AXISignal(ID_WIDTH) >     */ //axi2tlm_gp1->wid(     s_axi_gp1_wid     );
-            /* sc_in<bool>                     */ axi2tlm_gp1->wvalid(  s_axi_gp1_wvalid  );
-            /* sc_out<bool>                    */ axi2tlm_gp1->wready(  s_axi_gp1_wready  );
-            /* sc_in<sc_bv<DATA_WIDTH> >       */ axi2tlm_gp1->wdata(   s_axi_gp1_wdata   );
-            /* sc_in<sc_bv<DATA_WIDTH/8> >     */ axi2tlm_gp1->wstrb(   s_axi_gp1_wstrb   );
-            /* sc_in<AXISignal(WUSER_WIDTH) >  */ //axi2tlm_gp1->wuser(   s_axi_gp1_wuser   );
-            /* sc_in<bool>                     */ axi2tlm_gp1->wlast(   s_axi_gp1_wlast   );
-
-            /* Write response channel.  */
-            /* sc_out<bool>                    */ axi2tlm_gp1->bvalid(  s_axi_gp1_bvalid  );
-            /* sc_in<bool>                     */ axi2tlm_gp1->bready(  s_axi_gp1_bready  );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_gp1->bresp(   s_axi_gp1_bresp   );
-            /* sc_out<AXISignal(BUSER_WIDTH) > */ //axi2tlm_gp1->buser(   s_axi_gp1_buser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_gp1->bid(     s_axi_gp1_bid     );
-
-            /* Read address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_gp1->arvalid( s_axi_gp1_arvalid );
-            /* sc_out<bool>                    */ axi2tlm_gp1->arready( s_axi_gp1_arready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_gp1->araddr(  s_axi_gp1_araddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_gp1->arprot(  s_axi_gp1_arprot  );
-            /* sc_in<AXISignal(ARUSER_WIDTH) > */ //axi2tlm_gp1->aruser(  s_axi_gp1_aruser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp1->arregion(s_axi_gp1_arregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp1->arqos(   s_axi_gp1_arqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_gp1->arcache( s_axi_gp1_arcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_gp1->arburst( s_axi_gp1_arburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_gp1->arsize(  s_axi_gp1_arsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_gp1->arlen(   s_axi_gp1_arlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_gp1->arid(    s_axi_gp1_arid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_gp1->arlock(  s_axi_gp1_arlock  );
-
-            /* Read data channel.  */
-            /* sc_out<bool>                    */ axi2tlm_gp1->rvalid(  s_axi_gp1_rvalid  );
-            /* sc_in<bool>                     */ axi2tlm_gp1->rready(  s_axi_gp1_rready  );
-            /* sc_out<sc_bv<DATA_WIDTH> >      */ axi2tlm_gp1->rdata(   s_axi_gp1_rdata   );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_gp1->rresp(   s_axi_gp1_rresp   );
-            /* sc_out<AXISignal(RUSER_WIDTH) > */ //axi2tlm_gp1->ruser(   s_axi_gp1_ruser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_gp1->rid(     s_axi_gp1_rid     );
-            /* sc_out<bool>                    */ axi2tlm_gp1->rlast(   s_axi_gp1_rlast   );
+        // Only the enabled ports get a bridge (and services)
+        axi_lite_gp0 = NULL;
+        axi_lite_gp1 = NULL;
+#define ZYNQ7_PS_INIT_AXI_PORT(PORT, port, member, bridge, KIND, INDEX) \
+        member = NULL;                                                  \
+        if (PORT##_ENABLE_G > 0) {                                      \
+            init_##port();                                              \
         }
-
-        // S AXI HP0
-        //////////////
-        if (S_AXI_HP0_ENABLE_G > 0) {
-            axi2tlm_hp0 = new axi2tlm_bridge<S_AXI_HP0_ADDR_WIDTH_G,
-                                             S_AXI_HP0_DATA_WIDTH_G,
-                                             S_AXI_HP0_ID_WIDTH_G,
-                                             S_AXI_HP0_AXLEN_WIDTH_G,
-                                             S_AXI_HP0_AXLOCK_WIDTH_G,
-                                             S_AXI_HP0_AWUSER_WIDTH_G,
-                                             S_AXI_HP0_ARUSER_WIDTH_G> ("axi2tlm_hp0");
-
-            zynq.s_axi_hp[0]->bind(axi2tlm_hp0->socket);
-
-            // Note : Commented signal assignations below are connected to dummy internally (in bridge) e.g., awuser
-
-            /* Clock and Reset */
-            /* sc_in<bool>                     */ axi2tlm_hp0->clk(     s_axi_hp0_aclk    );
-            /* sc_in<bool>                     */ axi2tlm_hp0->resetn(  s_axi_hp0_aresetn );
-
-            /* Write address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_hp0->awvalid( s_axi_hp0_awvalid );
-            /* sc_out<bool>                    */ axi2tlm_hp0->awready( s_axi_hp0_awready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_hp0->awaddr(  s_axi_hp0_awaddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp0->awprot(  s_axi_hp0_awprot  );
-            /* sc_in<AXISignal(AWUSER_WIDTH) > */ //axi2tlm_hp0->awuser(  s_axi_hp0_awuser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp0->awregion(s_axi_hp0_awregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp0->awqos(   s_axi_hp0_awqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp0->awcache( s_axi_hp0_awcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_hp0->awburst( s_axi_hp0_awburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp0->awsize(  s_axi_hp0_awsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_hp0->awlen(   s_axi_hp0_awlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_hp0->awid(    s_axi_hp0_awid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_hp0->awlock(  s_axi_hp0_awlock  );
-
-            /* Write data channel.  */
-            /* sc_in<AXISignal(ID_WIDTH) >     */ //axi2tlm_hp0->wid(     s_axi_hp0_wid     );
-            /* sc_in<bool>                     */ axi2tlm_hp0->wvalid(  s_axi_hp0_wvalid  );
-            /* sc_out<bool>                    */ axi2tlm_hp0->wready(  s_axi_hp0_wready  );
-            /* sc_in<sc_bv<DATA_WIDTH> >       */ axi2tlm_hp0->wdata(   s_axi_hp0_wdata   );
-            /* sc_in<sc_bv<DATA_WIDTH/8> >     */ axi2tlm_hp0->wstrb(   s_axi_hp0_wstrb   );
-            /* sc_in<AXISignal(WUSER_WIDTH) >  */ //axi2tlm_hp0->wuser(   s_axi_hp0_wuser   );
-            /* sc_in<bool>                     */ axi2tlm_hp0->wlast(   s_axi_hp0_wlast   );
-
-            /* Write response channel.  */
-            /* sc_out<bool>                    */ axi2tlm_hp0->bvalid(  s_axi_hp0_bvalid  );
-            /* sc_in<bool>                     */ axi2tlm_hp0->bready(  s_axi_hp0_bready  );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_hp0->bresp(   s_axi_hp0_bresp   );
-            /* sc_out<AXISignal(BUSER_WIDTH) > */ //axi2tlm_hp0->buser(   s_axi_hp0_buser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_hp0->bid(     s_axi_hp0_bid     );
-
-            /* Read address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_hp0->arvalid( s_axi_hp0_arvalid );
-            /* sc_out<bool>                    */ axi2tlm_hp0->arready( s_axi_hp0_arready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_hp0->araddr(  s_axi_hp0_araddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp0->arprot(  s_axi_hp0_arprot  );
-            /* sc_in<AXISignal(ARUSER_WIDTH) > */ //axi2tlm_hp0->aruser(  s_axi_hp0_aruser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp0->arregion(s_axi_hp0_arregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp0->arqos(   s_axi_hp0_arqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp0->arcache( s_axi_hp0_arcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_hp0->arburst( s_axi_hp0_arburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp0->arsize(  s_axi_hp0_arsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_hp0->arlen(   s_axi_hp0_arlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_hp0->arid(    s_axi_hp0_arid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_hp0->arlock(  s_axi_hp0_arlock  );
-
-            /* Read data channel.  */
-            /* sc_out<bool>                    */ axi2tlm_hp0->rvalid(  s_axi_hp0_rvalid  );
-            /* sc_in<bool>                     */ axi2tlm_hp0->rready(  s_axi_hp0_rready  );
-            /* sc_out<sc_bv<DATA_WIDTH> >      */ axi2tlm_hp0->rdata(   s_axi_hp0_rdata   );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_hp0->rresp(   s_axi_hp0_rresp   );
-            /* sc_out<AXISignal(RUSER_WIDTH) > */ //axi2tlm_hp0->ruser(   s_axi_hp0_ruser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_hp0->rid(     s_axi_hp0_rid     );
-            /* sc_out<bool>                    */ axi2tlm_hp0->rlast(   s_axi_hp0_rlast   );
+        ZYNQ7_PS_AXI_PORTS(ZYNQ7_PS_INIT_AXI_PORT)
+#undef ZYNQ7_PS_INIT_AXI_PORT
+
+#define ZYNQ7_PS_ATTACH_DDR_PORT(PORT, port, member, bridge, KIND, INDEX) \
+        if (ddr_model && member) {                                        \
+            attach_ddr_port(KIND, INDEX, port##_aclk,                     \
+                            port##_awvalid, port##_awready,               \
+                            port##_awqos, port##_arvalid,                 \
+                            port##_arready, port##_arqos);                \
         }
+        ZYNQ7_PS_AXI_PORTS(ZYNQ7_PS_ATTACH_DDR_PORT)
+#undef ZYNQ7_PS_ATTACH_DDR_PORT
 
-        // S AXI HP1
-        //////////////
-        if (S_AXI_HP1_ENABLE_G > 0) {
-            axi2tlm_hp1 = new axi2tlm_bridge<S_AXI_HP1_ADDR_WIDTH_G,
-                                             S_AXI_HP1_DATA_WIDTH_G,
-                                             S_AXI_HP1_ID_WIDTH_G,
-                                             S_AXI_HP1_AXLEN_WIDTH_G,
-                                             S_AXI_HP1_AXLOCK_WIDTH_G,
-                                             S_AXI_HP1_AWUSER_WIDTH_G,
-                                             S_AXI_HP1_ARUSER_WIDTH_G> ("axi2tlm_hp1");
-
-            zynq.s_axi_hp[1]->bind(axi2tlm_hp1->socket);
-
-            // Note : Commented signal assignations below are connected to dummy internally (in bridge) e.g., awuser
-
-            /* Clock and Reset */
-            /* sc_in<bool>                     */ axi2tlm_hp1->clk(     s_axi_hp1_aclk    );
-            /* sc_in<bool>                     */ axi2tlm_hp1->resetn(  s_axi_hp1_aresetn );
-
-            /* Write address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_hp1->awvalid( s_axi_hp1_awvalid );
-            /* sc_out<bool>                    */ axi2tlm_hp1->awready( s_axi_hp1_awready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_hp1->awaddr(  s_axi_hp1_awaddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp1->awprot(  s_axi_hp1_awprot  );
-            /* sc_in<AXISignal(AWUSER_WIDTH) > */ //axi2tlm_hp1->awuser(  s_axi_hp1_awuser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp1->awregion(s_axi_hp1_awregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp1->awqos(   s_axi_hp1_awqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp1->awcache( s_axi_hp1_awcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_hp1->awburst( s_axi_hp1_awburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp1->awsize(  s_axi_hp1_awsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_hp1->awlen(   s_axi_hp1_awlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_hp1->awid(    s_axi_hp1_awid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_hp1->awlock(  s_axi_hp1_awlock  );
-
-            /* Write data channel.  */
-            /* sc_in<AXISignal(ID_WIDTH) >     */ //axi2tlm_hp1->wid(     s_axi_hp1_wid     );
-            /* sc_in<bool>                     */ axi2tlm_hp1->wvalid(  s_axi_hp1_wvalid  );
-            /* sc_out<bool>                    */ axi2tlm_hp1->wready(  s_axi_hp1_wready  );
-            /* sc_in<sc_bv<DATA_WIDTH> >       */ axi2tlm_hp1->wdata(   s_axi_hp1_wdata   );
-            /* sc_in<sc_bv<DATA_WIDTH/8> >     */ axi2tlm_hp1->wstrb(   s_axi_hp1_wstrb   );
-            /* sc_in<AXISignal(WUSER_WIDTH) >  */ //axi2tlm_hp1->wuser(   s_axi_hp1_wuser   );
-            /* sc_in<bool>                     */ axi2tlm_hp1->wlast(   s_axi_hp1_wlast   );
-
-            /* Write response channel.  */
-            /* sc_out<bool>                    */ axi2tlm_hp1->bvalid(  s_axi_hp1_bvalid  );
-            /* sc_in<bool>                     */ axi2tlm_hp1->bready(  s_axi_hp1_bready  );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_hp1->bresp(   s_axi_hp1_bresp   );
-            /* sc_out<AXISignal(BUSER_WIDTH) > */ //axi2tlm_hp1->buser(   s_axi_hp1_buser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_hp1->bid(     s_axi_hp1_bid     );
-
-            /* Read address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_hp1->arvalid( s_axi_hp1_arvalid );
-            /* sc_out<bool>                    */ axi2tlm_hp1->arready( s_axi_hp1_arready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_hp1->araddr(  s_axi_hp1_araddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp1->arprot(  s_axi_hp1_arprot  );
-            /* sc_in<AXISignal(ARUSER_WIDTH) > */ //axi2tlm_hp1->aruser(  s_axi_hp1_aruser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp1->arregion(s_axi_hp1_arregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp1->arqos(   s_axi_hp1_arqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp1->arcache( s_axi_hp1_arcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_hp1->arburst( s_axi_hp1_arburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp1->arsize(  s_axi_hp1_arsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_hp1->arlen(   s_axi_hp1_arlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_hp1->arid(    s_axi_hp1_arid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_hp1->arlock(  s_axi_hp1_arlock  );
-
-            /* Read data channel.  */
-            /* sc_out<bool>                    */ axi2tlm_hp1->rvalid(  s_axi_hp1_rvalid  );
-            /* sc_in<bool>                     */ axi2tlm_hp1->rready(  s_axi_hp1_rready  );
-            /* sc_out<sc_bv<DATA_WIDTH> >      */ axi2tlm_hp1->rdata(   s_axi_hp1_rdata   );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_hp1->rresp(   s_axi_hp1_rresp   );
-            /* sc_out<AXISignal(RUSER_WIDTH) > */ //axi2tlm_hp1->ruser(   s_axi_hp1_ruser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_hp1->rid(     s_axi_hp1_rid     );
-            /* sc_out<bool>                    */ axi2tlm_hp1->rlast(   s_axi_hp1_rlast   );
-        }
+        // Traffic generators
+        create_traffic_gen(ZYNQ7_S_AXI_HP, 0, S_AXI_HP0_ENABLE_G > 0, S_AXI_HP0_TRAFFIC_G);
+        create_traffic_gen(ZYNQ7_S_AXI_HP, 1, S_AXI_HP1_ENABLE_G > 0, S_AXI_HP1_TRAFFIC_G);
+        create_traffic_gen(ZYNQ7_S_AXI_HP, 2, S_AXI_HP2_ENABLE_G > 0, S_AXI_HP2_TRAFFIC_G);
+        create_traffic_gen(ZYNQ7_S_AXI_HP, 3, S_AXI_HP3_ENABLE_G > 0, S_AXI_HP3_TRAFFIC_G);
 
-        // S AXI HP2
-        //////////////
-        if (S_AXI_HP2_ENABLE_G > 0) {
-            axi2tlm_hp2 = new axi2tlm_bridge<S_AXI_HP2_ADDR_WIDTH_G,
-                                             S_AXI_HP2_DATA_WIDTH_G,
-                                             S_AXI_HP2_ID_WIDTH_G,
-                                             S_AXI_HP2_AXLEN_WIDTH_G,
-                                             S_AXI_HP2_AXLOCK_WIDTH_G,
-                                             S_AXI_HP2_AWUSER_WIDTH_G,
-                                             S_AXI_HP2_ARUSER_WIDTH_G> ("axi2tlm_hp2");
-
-            zynq.s_axi_hp[2]->bind(axi2tlm_hp2->socket);
-
-            // Note : Commented signal assignations below are connected to dummy internally (in bridge) e.g., awuser
-
-            /* Clock and Reset */
-            /* sc_in<bool>                     */ axi2tlm_hp2->clk(     s_axi_hp2_aclk    );
-            /* sc_in<bool>                     */ axi2tlm_hp2->resetn(  s_axi_hp2_aresetn );
-
-            /* Write address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_hp2->awvalid( s_axi_hp2_awvalid );
-            /* sc_out<bool>                    */ axi2tlm_hp2->awready( s_axi_hp2_awready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_hp2->awaddr(  s_axi_hp2_awaddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp2->awprot(  s_axi_hp2_awprot  );
-            /* sc_in<AXISignal(AWUSER_WIDTH) > */ //axi2tlm_hp2->awuser(  s_axi_hp2_awuser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp2->awregion(s_axi_hp2_awregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp2->awqos(   s_axi_hp2_awqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp2->awcache( s_axi_hp2_awcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_hp2->awburst( s_axi_hp2_awburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp2->awsize(  s_axi_hp2_awsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_hp2->awlen(   s_axi_hp2_awlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_hp2->awid(    s_axi_hp2_awid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_hp2->awlock(  s_axi_hp2_awlock  );
-
-            /* Write data channel.  */
-            /* sc_in<AXISignal(ID_WIDTH) >     */ //axi2tlm_hp2->wid(     s_axi_hp2_wid     );
-            /* sc_in<bool>                     */ axi2tlm_hp2->wvalid(  s_axi_hp2_wvalid  );
-            /* sc_out<bool>                    */ axi2tlm_hp2->wready(  s_axi_hp2_wready  );
-            /* sc_in<sc_bv<DATA_WIDTH> >       */ axi2tlm_hp2->wdata(   s_axi_hp2_wdata   );
-            /* sc_in<sc_bv<DATA_WIDTH/8> >     */ axi2tlm_hp2->wstrb(   s_axi_hp2_wstrb   );
-            /* sc_in<AXISignal(WUSER_WIDTH) >  */ //axi2tlm_hp2->wuser(   s_axi_hp2_wuser   );
-            /* sc_in<bool>                     */ axi2tlm_hp2->wlast(   s_axi_hp2_wlast   );
-
-            /* Write response channel.  */
-            /* sc_out<bool>                    */ axi2tlm_hp2->bvalid(  s_axi_hp2_bvalid  );
-            /* sc_in<bool>                     */ axi2tlm_hp2->bready(  s_axi_hp2_bready  );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_hp2->bresp(   s_axi_hp2_bresp   );
-            /* sc_out<AXISignal(BUSER_WIDTH) > */ //axi2tlm_hp2->buser(   s_axi_hp2_buser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_hp2->bid(     s_axi_hp2_bid     );
-
-            /* Read address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_hp2->arvalid( s_axi_hp2_arvalid );
-            /* sc_out<bool>                    */ axi2tlm_hp2->arready( s_axi_hp2_arready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_hp2->araddr(  s_axi_hp2_araddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp2->arprot(  s_axi_hp2_arprot  );
-            /* sc_in<AXISignal(ARUSER_WIDTH) > */ //axi2tlm_hp2->aruser(  s_axi_hp2_aruser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp2->arregion(s_axi_hp2_arregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp2->arqos(   s_axi_hp2_arqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp2->arcache( s_axi_hp2_arcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_hp2->arburst( s_axi_hp2_arburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp2->arsize(  s_axi_hp2_arsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_hp2->arlen(   s_axi_hp2_arlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_hp2->arid(    s_axi_hp2_arid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_hp2->arlock(  s_axi_hp2_arlock  );
-
-            /* Read data channel.  */
-            /* sc_out<bool>                    */ axi2tlm_hp2->rvalid(  s_axi_hp2_rvalid  );
-            /* sc_in<bool>                     */ axi2tlm_hp2->rready(  s_axi_hp2_rready  );
-            /* sc_out<sc_bv<DATA_WIDTH> >      */ axi2tlm_hp2->rdata(   s_axi_hp2_rdata   );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_hp2->rresp(   s_axi_hp2_rresp   );
-            /* sc_out<AXISignal(RUSER_WIDTH) > */ //axi2tlm_hp2->ruser(   s_axi_hp2_ruser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_hp2->rid(     s_axi_hp2_rid     );
-            /* sc_out<bool>                    */ axi2tlm_hp2->rlast(   s_axi_hp2_rlast   );
+        // Fast-forward
+        /////////////////
+        if (FAST_FORWARD_G > 0) {
+            fast_forward = new zynq7_fast_forward("fast_forward",
+                                                  scaled_time(QEMU_SYNC_QUANTUM_G),
+                                                  scaled_time(FAST_FORWARD_BUDGET_IN_NS_G),
+                                                  FAST_FORWARD_IDLE_QUANTA_G);
+            for (size_t i = 0; i < port_monitors.size(); ++i) {
+                fast_forward->watch(port_monitors[i]);
+            }
         }
 
-        // S AXI HP3
-        //////////////
-        if (S_AXI_HP3_ENABLE_G > 0) {
-            axi2tlm_hp3 = new axi2tlm_bridge<S_AXI_HP3_ADDR_WIDTH_G,
-                                             S_AXI_HP3_DATA_WIDTH_G,
-                                             S_AXI_HP3_ID_WIDTH_G,
-                                             S_AXI_HP3_AXLEN_WIDTH_G,
-                                             S_AXI_HP3_AXLOCK_WIDTH_G,
-                                             S_AXI_HP3_AWUSER_WIDTH_G,
-                                             S_AXI_HP3_ARUSER_WIDTH_G> ("axi2tlm_hp3");
-
-            zynq.s_axi_hp[3]->bind(axi2tlm_hp3->socket);
-
-            // Note : Commented signal assignations below are connected to dummy internally (in bridge) e.g., awuser
-
-            /* Clock and Reset */
-            /* sc_in<bool>                     */ axi2tlm_hp3->clk(     s_axi_hp3_aclk    );
-            /* sc_in<bool>                     */ axi2tlm_hp3->resetn(  s_axi_hp3_aresetn );
-
-            /* Write address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_hp3->awvalid( s_axi_hp3_awvalid );
-            /* sc_out<bool>                    */ axi2tlm_hp3->awready( s_axi_hp3_awready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_hp3->awaddr(  s_axi_hp3_awaddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp3->awprot(  s_axi_hp3_awprot  );
-            /* sc_in<AXISignal(AWUSER_WIDTH) > */ //axi2tlm_hp3->awuser(  s_axi_hp3_awuser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp3->awregion(s_axi_hp3_awregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp3->awqos(   s_axi_hp3_awqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp3->awcache( s_axi_hp3_awcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_hp3->awburst( s_axi_hp3_awburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp3->awsize(  s_axi_hp3_awsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_hp3->awlen(   s_axi_hp3_awlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_hp3->awid(    s_axi_hp3_awid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_hp3->awlock(  s_axi_hp3_awlock  );
-
-            /* Write data channel.  */
-            /* sc_in<AXISignal(ID_WIDTH) >     */ //axi2tlm_hp3->wid(     s_axi_hp3_wid     );
-            /* sc_in<bool>                     */ axi2tlm_hp3->wvalid(  s_axi_hp3_wvalid  );
-            /* sc_out<bool>                    */ axi2tlm_hp3->wready(  s_axi_hp3_wready  );
-            /* sc_in<sc_bv<DATA_WIDTH> >       */ axi2tlm_hp3->wdata(   s_axi_hp3_wdata   );
-            /* sc_in<sc_bv<DATA_WIDTH/8> >     */ axi2tlm_hp3->wstrb(   s_axi_hp3_wstrb   );
-            /* sc_in<AXISignal(WUSER_WIDTH) >  */ //axi2tlm_hp3->wuser(   s_axi_hp3_wuser   );
-            /* sc_in<bool>                     */ axi2tlm_hp3->wlast(   s_axi_hp3_wlast   );
-
-            /* Write response channel.  */
-            /* sc_out<bool>                    */ axi2tlm_hp3->bvalid(  s_axi_hp3_bvalid  );
-            /* sc_in<bool>                     */ axi2tlm_hp3->bready(  s_axi_hp3_bready  );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_hp3->bresp(   s_axi_hp3_bresp   );
-            /* sc_out<AXISignal(BUSER_WIDTH) > */ //axi2tlm_hp3->buser(   s_axi_hp3_buser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_hp3->bid(     s_axi_hp3_bid     );
-
-            /* Read address channel.  */
-            /* sc_in<bool>                     */ axi2tlm_hp3->arvalid( s_axi_hp3_arvalid );
-            /* sc_out<bool>                    */ axi2tlm_hp3->arready( s_axi_hp3_arready );
-            /* sc_in<sc_bv<ADDR_WIDTH> >       */ axi2tlm_hp3->araddr(  s_axi_hp3_araddr  );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp3->arprot(  s_axi_hp3_arprot  );
-            /* sc_in<AXISignal(ARUSER_WIDTH) > */ //axi2tlm_hp3->aruser(  s_axi_hp3_aruser  );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp3->arregion(s_axi_hp3_arregion);
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp3->arqos(   s_axi_hp3_arqos   );
-            /* sc_in<sc_bv<4> >                */ axi2tlm_hp3->arcache( s_axi_hp3_arcache );
-            /* sc_in<sc_bv<2> >                */ axi2tlm_hp3->arburst( s_axi_hp3_arburst );
-            /* sc_in<sc_bv<3> >                */ axi2tlm_hp3->arsize(  s_axi_hp3_arsize  );
-            /* sc_in<AXISignal(AxLEN_WIDTH) >  */ axi2tlm_hp3->arlen(   s_axi_hp3_arlen   );
-            /* sc_in<AXISignal(ID_WIDTH) >     */ axi2tlm_hp3->arid(    s_axi_hp3_arid    );
-            /* sc_in<AXISignal(AxLOCK_WIDTH) > */ axi2tlm_hp3->arlock(  s_axi_hp3_arlock  );
-
-            /* Read data channel.  */
-            /* sc_out<bool>                    */ axi2tlm_hp3->rvalid(  s_axi_hp3_rvalid  );
-            /* sc_in<bool>                     */ axi2tlm_hp3->rready(  s_axi_hp3_rready  );
-            /* sc_out<sc_bv<DATA_WIDTH> >      */ axi2tlm_hp3->rdata(   s_axi_hp3_rdata   );
-            /* sc_out<sc_bv<2> >               */ axi2tlm_hp3->rresp(   s_axi_hp3_rresp   );
-            /* sc_out<AXISignal(RUSER_WIDTH) > */ //axi2tlm_hp3->ruser(   s_axi_hp3_ruser   );
-            /* sc_out<AXISignal(ID_WIDTH) >    */ axi2tlm_hp3->rid(     s_axi_hp3_rid     );
-            /* sc_out<bool>                    */ axi2tlm_hp3->rlast(   s_axi_hp3_rlast   );
+        // Timeline
+        /////////////
+        if (!TIMELINE_FILE_G.empty()) {
+            timeline = new zynq7_timeline("timeline", TIMELINE_FILE_G);
+            for (size_t i = 0; i < port_monitors.size(); ++i) {
+                timeline->watch(port_monitors[i]);
+            }
+            if (rp_link) {
+                rp_link->set_sync_observer(timeline);
+            }
         }
 
         ////////////
         // Clocks //
         ////////////
 
-        // FCLK_CLK0
+        // Negative periods mean unused (tied to 0)
         assert(FCLK_CLK0_PERIOD_IN_NS_G > 0); // This clock is mandatory (arbitrary choice)
-        fclk_clk0_gen = new sc_clock("fclk_clk0_gen", sc_time(FCLK_CLK0_PERIOD_IN_NS_G, SC_NS));
-        SC_METHOD(fclk_clk0_assign);
-        sensitive << fclk_clk0_gen->signal();
-        dont_initialize();
-
-        // FCLK_CLK1
+        fclk_gen = new zynq7_fclk_gen("fclk_gen");
+        fclk_gen->fclk[0](fclk_clk0);
+        fclk_gen->fclk[1](fclk_clk1);
+        fclk_gen->fclk[2](fclk_clk2);
+        fclk_gen->fclk[3](fclk_clk3);
+        fclk_gen->set_period(0, scaled_time(FCLK_CLK0_PERIOD_IN_NS_G));
         if (FCLK_CLK1_PERIOD_IN_NS_G > 0) {
-            fclk_clk1_gen = new sc_clock("fclk_clk1_gen", sc_time(FCLK_CLK1_PERIOD_IN_NS_G, SC_NS));
-            SC_METHOD(fclk_clk1_assign);
-            sensitive << fclk_clk1_gen->signal();
-            dont_initialize();
-        } else {
-            fclk_clk1.write(false);
+            fclk_gen->set_period(1, scaled_time(FCLK_CLK1_PERIOD_IN_NS_G));
         }
-        // FCLK_CLK2
         if (FCLK_CLK2_PERIOD_IN_NS_G > 0) {
-            fclk_clk2_gen = new sc_clock("fclk_clk2_gen", sc_time(FCLK_CLK2_PERIOD_IN_NS_G, SC_NS));
-            SC_METHOD(fclk_clk2_assign);
-            sensitive << fclk_clk2_gen->signal();
-            dont_initialize();
-        } else {
-            fclk_clk2.write(false);
+            fclk_gen->set_period(2, scaled_time(FCLK_CLK2_PERIOD_IN_NS_G));
         }
-        // FCLK_CLK3
         if (FCLK_CLK3_PERIOD_IN_NS_G > 0) {
-            fclk_clk3_gen = new sc_clock("fclk_clk3_gen", sc_time(FCLK_CLK3_PERIOD_IN_NS_G, SC_NS));
-            SC_METHOD(fclk_clk3_assign);
-            sensitive << fclk_clk3_gen->signal();
+            fclk_gen->set_period(3, scaled_time(FCLK_CLK3_PERIOD_IN_NS_G));
+        }
+
+        // The counters see the clocks and the ports in the order of the port table
+        if (counters) {
+            int slot = 0;
+            counters->set_fclk_gen(fclk_gen);
+#define ZYNQ7_PS_COUNT_AXI_PORT(PORT, port, member, bridge, KIND, INDEX) \
+            counters->set_port(slot++, find_port_monitor(zynq7_axi_port_name(KIND, INDEX)));
+            ZYNQ7_PS_AXI_PORTS(ZYNQ7_PS_COUNT_AXI_PORT)
+#undef ZYNQ7_PS_COUNT_AXI_PORT
+        }
+
+        // SLCR shadow, reached by QEMU through its own remote port device
+        if (SLCR_SHADOW_DEV_ID_G >= 0) {
+            slcr_shadow = new zynq7_slcr_shadow("slcr_shadow", fclk_gen, TIME_SCALE_G);
+            slcr_rp = new remoteport_tlm_memory_master("slcr_rp");
+            slcr_rp->sk.bind(slcr_shadow->socket);
+            zynq.register_dev(SLCR_SHADOW_DEV_ID_G, slcr_rp);
+        }
+
+        // PL resets
+        SC_METHOD(gen_fclk_resets);
+        sensitive << rst;
+        for (size_t i = 0; i < 4 && i < zynq.ps2pl_rst.size(); ++i) {
+            sensitive << zynq.ps2pl_rst[i];
+        }
+        if (slcr_shadow) {
+            for (int i = 0; i < 4; ++i) {
+                sensitive << slcr_shadow->fpga_rst[i];
+            }
+        }
+
+        if (fast_forward) {
+            SC_METHOD(fast_forward_update);
+            sensitive << fast_forward->state_event();
             dont_initialize();
-        } else {
-            fclk_clk3.write(false);
         }
 
         //////////
@@ -1849,8 +1951,58 @@ public:
         zynq.tie_off();
 
         SC_THREAD(pull_reset);
+
+        //////////
+        // Exit //
+        //////////
+
+        // Stops the simulation, the status is handed to the batch script (see zynq7_exit.h)
+        guest_exit = new zynq7_exit("guest_exit");
+        for (size_t i = 0; i < axi_checkers.size(); ++i) {
+            axi_checkers[i]->set_exit(guest_exit);
+        }
+        if (!addr_decoders.empty()) {
+            SC_METHOD(guest_exit_request);
+            for (size_t i = 0; i < addr_decoders.size(); ++i) {
+                sensitive << addr_decoders[i]->exit_event();
+            }
+            dont_initialize();
+        }
+        if (!addr_decoders.empty()) {
+            SC_METHOD(guest_marker);
+            for (size_t i = 0; i < addr_decoders.size(); ++i) {
+                sensitive << addr_decoders[i]->marker_event();
+            }
+            dont_initialize();
+        }
+    }
+
+protected:
+    void end_of_elaboration(void)
+    {
+        bool several = qemu_sockets().size() > 1;
+        // Each QEMU is serviced while the others compute instead of the
+        // simulation blocking on one socket
+        if (several) {
+            zynq.wait_peer = zynq7_peer_poller::wait_readable;
+            zynq7_peer_poller::add_peer();
+        }
+        // The fast-forward changes the global quantum
+        if (several && fast_forward) {
+            cerr << name() << " : fast-forward is not supported with several instances" << endl;
+            for(;;);
+        }
+    }
+
+    void end_of_simulation(void)
+    {
+        if (rp_link) {
+            rp_link->print_summary(cout);
+        }
     }
 
 private:
     tlm_utils::tlm_quantumkeeper m_qk;
 };
+
+#endif /* __ZYNQ7_PS_H__ */
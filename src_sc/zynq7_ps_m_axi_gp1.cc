@@ -0,0 +1,48 @@
+/*
+ * M AXI GP1 port for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Only the bridge for this port is created in this translation unit
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_ps.h"
+
+// M AXI GP1 : PS (QEMU) is the master, transactions are driven on the PL through a TLM to AXI bridge
+void zynq7_ps::init_m_axi_gp1(void)
+{
+    // AXI4-Lite slaves : single beat bridge, idle between the accesses (no gate)
+    if (M_AXI_GP1_LITE_G > 0) {
+        axi_lite_gp1 = create_axi_port<m_axi_gp1_port_t, m_axi_gp1_port_t::lite_bridge_t>("axi_lite_gp1");
+        ZYNQ7_PS_BIND_AXI(axi_lite_gp1, m_axi_gp1);
+        ZYNQ7_PS_CHECK_AXI(m_axi_gp1);
+        return;
+    }
+
+    tlm2axi_gp1 = create_axi_port<m_axi_gp1_port_t>("tlm2axi_gp1");
+
+    // Note : Some signals (e.g., awuser, wid) are connected to dummy internally (in bridge)
+    ZYNQ7_PS_BIND_AXI(tlm2axi_gp1, m_axi_gp1);
+    ZYNQ7_PS_CHECK_AXI(m_axi_gp1);
+    ZYNQ7_PS_GATE_AXI(tlm2axi_gp1, m_axi_gp1);
+}
@@ -0,0 +1,59 @@
+/*
+ * Precompiled header for Zynq Cosim
+ *
+ * Everything that is heavy to parse and does not depend on the port widths
+ * (SystemC, TLM, the Zynq remote-port model and the bridges) is gathered here
+ * so it can be precompiled once and shared by all the zynq7_ps translation
+ * units. It must be the first include of every one of these units.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_PS_PCH_H__
+#define __ZYNQ7_PS_PCH_H__
+
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+
+// C/C++ includes
+#include <inttypes.h>
+#include <stdio.h>
+#include <signal.h>
+#include <unistd.h>
+#include <assert.h>
+
+// System C includes
+#include "systemc.h"
+// System C TLM includes
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+// Xilinx Zynq
+// https://github.com/Xilinx/libsystemctlm-soc in zynq (moved to soc/xilinx in future revisions)
+#include "xilinx-zynq.h"
+
+// Xilinx Bridges (BFMs)
+// https://github.com/Xilinx/libsystemctlm-soc in tlm-bridges
+#include "tlm2axi-bridge.h"
+#include "axi2tlm-bridge.h"
+
+#endif /* __ZYNQ7_PS_PCH_H__ */
@@ -0,0 +1,246 @@
+/*
+ * AXI port descriptors for Zynq Cosim
+ *
+ * Every AXI port of the PS is described at compile time by its kind, its
+ * index and its widths. The descriptor selects the bridge that is used for
+ * the port and the port table below lists all the ports so the code that is
+ * the same for every port (bridge creation, socket and signal binding, port
+ * services) only has to be written once.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_PS_PORTS_H__
+#define __ZYNQ7_PS_PORTS_H__
+
+#include <string>
+#include <sstream>
+#include <type_traits>
+
+#include "zynq7_axi_lite_bridge.h"
+
+// Kinds of AXI ports of the Zynq-7000 PS
+enum zynq7_axi_port_kind {
+    ZYNQ7_M_AXI_GP,  // General purpose, PS is the master
+    ZYNQ7_S_AXI_GP,  // General purpose, PL is the master
+    ZYNQ7_S_AXI_HP,  // High performance (AFI), PL is the master
+    ZYNQ7_S_AXI_ACP  // Accelerator coherency port, PL is the master
+};
+
+// Name of the port as in the Zynq documentation, e.g., S_AXI_HP2
+inline std::string zynq7_axi_port_name(zynq7_axi_port_kind kind, int index)
+{
+    static const char *names[] = {"M_AXI_GP", "S_AXI_GP", "S_AXI_HP", "S_AXI_ACP"};
+    std::ostringstream oss;
+    oss << names[kind];
+    if (kind != ZYNQ7_S_AXI_ACP) {
+        oss << index;
+    }
+    return oss.str();
+}
+
+// Bridge selection, the PL is driven through a TLM to AXI bridge when the PS
+// is the master and through an AXI to TLM bridge otherwise
+template <bool PS_IS_MASTER, int ADDR_WIDTH, int DATA_WIDTH, int ID_WIDTH,
+          int AXLEN_WIDTH, int AXLOCK_WIDTH, int AWUSER_WIDTH, int ARUSER_WIDTH>
+struct zynq7_axi_bridge_select {
+    typedef tlm2axi_bridge<ADDR_WIDTH, DATA_WIDTH, ID_WIDTH, AXLEN_WIDTH,
+                           AXLOCK_WIDTH, AWUSER_WIDTH, ARUSER_WIDTH> type;
+};
+
+template <int ADDR_WIDTH, int DATA_WIDTH, int ID_WIDTH,
+          int AXLEN_WIDTH, int AXLOCK_WIDTH, int AWUSER_WIDTH, int ARUSER_WIDTH>
+struct zynq7_axi_bridge_select<false, ADDR_WIDTH, DATA_WIDTH, ID_WIDTH,
+                               AXLEN_WIDTH, AXLOCK_WIDTH, AWUSER_WIDTH, ARUSER_WIDTH> {
+    typedef axi2tlm_bridge<ADDR_WIDTH, DATA_WIDTH, ID_WIDTH, AXLEN_WIDTH,
+                           AXLOCK_WIDTH, AWUSER_WIDTH, ARUSER_WIDTH> type;
+};
+
+// Compile time descriptor of an AXI port
+template <zynq7_axi_port_kind KIND, int INDEX,
+          int ADDR_WIDTH, int DATA_WIDTH, int ID_WIDTH, int AXLEN_WIDTH,
+          int AXLOCK_WIDTH, int AWUSER_WIDTH, int ARUSER_WIDTH>
+struct zynq7_axi_port {
+    static const zynq7_axi_port_kind kind = KIND;
+    static const int index                = INDEX;
+    static const bool ps_is_master        = (KIND == ZYNQ7_M_AXI_GP);
+
+    static const int addr_width   = ADDR_WIDTH;
+    static const int data_width   = DATA_WIDTH;
+    static const int id_width     = ID_WIDTH;
+    static const int axlen_width  = AXLEN_WIDTH;
+    static const int axlock_width = AXLOCK_WIDTH;
+    static const int awuser_width = AWUSER_WIDTH;
+    static const int aruser_width = ARUSER_WIDTH;
+
+    typedef typename zynq7_axi_bridge_select<ps_is_master, ADDR_WIDTH, DATA_WIDTH,
+                                             ID_WIDTH, AXLEN_WIDTH, AXLOCK_WIDTH,
+                                             AWUSER_WIDTH, ARUSER_WIDTH>::type bridge_t;
+    // AXI4-Lite bridge, only when the PS is the master (see zynq7_axi_lite_bridge.h)
+    typedef zynq7_axi_lite_bridge<ADDR_WIDTH, DATA_WIDTH, ID_WIDTH, AXLEN_WIDTH,
+                                  AXLOCK_WIDTH> lite_bridge_t;
+
+    // Tag for dispatching on the direction of the port
+    typedef std::integral_constant<bool, ps_is_master> master_tag;
+
+    static std::string name() { return zynq7_axi_port_name(KIND, INDEX); }
+};
+
+// Port table
+///////////////
+// X(PORT, port, bridge member, bridge template, kind, index)
+// PORT is the prefix of the generics (PORT_ENABLE_G, PORT_*_WIDTH_G) and port
+// is the prefix of the signals (port_awvalid, ...)
+#define ZYNQ7_PS_AXI_PORTS(X)                                                      \
+    X(M_AXI_GP0, m_axi_gp0, tlm2axi_gp0, tlm2axi_bridge, ZYNQ7_M_AXI_GP,  0)      \
+    X(M_AXI_GP1, m_axi_gp1, tlm2axi_gp1, tlm2axi_bridge, ZYNQ7_M_AXI_GP,  1)      \
+    X(S_AXI_GP0, s_axi_gp0, axi2tlm_gp0, axi2tlm_bridge, ZYNQ7_S_AXI_GP,  0)      \
+    X(S_AXI_GP1, s_axi_gp1, axi2tlm_gp1, axi2tlm_bridge, ZYNQ7_S_AXI_GP,  1)      \
+    X(S_AXI_HP0, s_axi_hp0, axi2tlm_hp0, axi2tlm_bridge, ZYNQ7_S_AXI_HP,  0)      \
+    X(S_AXI_HP1, s_axi_hp1, axi2tlm_hp1, axi2tlm_bridge, ZYNQ7_S_AXI_HP,  1)      \
+    X(S_AXI_HP2, s_axi_hp2, axi2tlm_hp2, axi2tlm_bridge, ZYNQ7_S_AXI_HP,  2)      \
+    X(S_AXI_HP3, s_axi_hp3, axi2tlm_hp3, axi2tlm_bridge, ZYNQ7_S_AXI_HP,  3)      \
+    X(S_AXI_ACP, s_axi_acp, axi2tlm_acp, axi2tlm_bridge, ZYNQ7_S_AXI_ACP, 0)
+
+// Descriptor of a port of the table, the widths come from the generics (constants)
+#define ZYNQ7_PS_AXI_PORT_DESC(PORT, KIND, INDEX)                                  \
+    zynq7_axi_port<KIND, INDEX,                                                    \
+                   PORT##_ADDR_WIDTH_G, PORT##_DATA_WIDTH_G, PORT##_ID_WIDTH_G,    \
+                   PORT##_AXLEN_WIDTH_G, PORT##_AXLOCK_WIDTH_G,                    \
+                   PORT##_AWUSER_WIDTH_G, PORT##_ARUSER_WIDTH_G>
+
+// Signal binding
+///////////////////
+// Commented signals (e.g., awuser, wid) are connected to dummies internally in
+// the bridges
+
+// The signal names are the same for both directions, only the direction
+// of the ports differs (and this is handled by the ports themselves)
+#define ZYNQ7_PS_BIND_AXI(BRIDGE, port)                                          \
+    do {                                                                           \
+        /* Clock and Reset */                                                      \
+        BRIDGE->clk(      port##_aclk     );                                       \
+        BRIDGE->resetn(   port##_aresetn  );                                       \
+        /* Write address channel */                                                \
+        BRIDGE->awvalid(  port##_awvalid  );                                       \
+        BRIDGE->awready(  port##_awready  );                                       \
+        BRIDGE->awaddr(   port##_awaddr   );                                       \
+        BRIDGE->awprot(   port##_awprot   );                                       \
+        BRIDGE->awregion( port##_awregion );                                       \
+        BRIDGE->awqos(    port##_awqos    );                                       \
+        BRIDGE->awcache(  port##_awcache  );                                       \
+        BRIDGE->awburst(  port##_awburst  );                                       \
+        BRIDGE->awsize(   port##_awsize   );                                       \
+        BRIDGE->awlen(    port##_awlen    );                                       \
+        BRIDGE->awid(     port##_awid     );                                       \
+        BRIDGE->awlock(   port##_awlock   );                                       \
+        /* Write data channel */                                                   \
+        BRIDGE->wvalid(   port##_wvalid   );                                       \
+        BRIDGE->wready(   port##_wready   );                                       \
+        BRIDGE->wdata(    port##_wdata    );                                       \
+        BRIDGE->wstrb(    port##_wstrb    );                                       \
+        BRIDGE->wlast(    port##_wlast    );                                       \
+        /* Write response channel */                                               \
+        BRIDGE->bvalid(   port##_bvalid   );                                       \
+        BRIDGE->bready(   port##_bready   );                                       \
+        BRIDGE->bresp(    port##_bresp    );                                       \
+        BRIDGE->bid(      port##_bid      );                                       \
+        /* Read address channel */                                                 \
+        BRIDGE->arvalid(  port##_arvalid  );                                       \
+        BRIDGE->arready(  port##_arready  );                                       \
+        BRIDGE->araddr(   port##_araddr   );                                       \
+        BRIDGE->arprot(   port##_arprot   );                                       \
+        BRIDGE->arregion( port##_arregion );                                       \
+        BRIDGE->arqos(    port##_arqos    );                                       \
+        BRIDGE->arcache(  port##_arcache  );                                       \
+        BRIDGE->arburst(  port##_arburst  );                                       \
+        BRIDGE->arsize(   port##_arsize   );                                       \
+        BRIDGE->arlen(    port##_arlen    );                                       \
+        BRIDGE->arid(     port##_arid     );                                       \
+        BRIDGE->arlock(   port##_arlock   );                                       \
+        /* Read data channel */                                                    \
+        BRIDGE->rvalid(   port##_rvalid   );                                       \
+        BRIDGE->rready(   port##_rready   );                                       \
+        BRIDGE->rdata(    port##_rdata    );                                       \
+        BRIDGE->rresp(    port##_rresp    );                                       \
+        BRIDGE->rid(      port##_rid      );                                       \
+        BRIDGE->rlast(    port##_rlast    );                                       \
+    } while (0)
+
+// Protocol checker of a port (see zynq7_axi_checker.h), only the handshake,
+// ID, length and last signals are watched
+#define ZYNQ7_PS_CHECK_AXI(port)                                                   \
+    do {                                                                           \
+        zynq7_axi_checker<port##_port_t> *checker =                                \
+            create_axi_checker<port##_port_t>(#port "_checker");                   \
+        if (!checker) {                                                            \
+            break;                                                                 \
+        }                                                                          \
+        checker->clk(     port##_aclk     );                                       \
+        checker->resetn(  port##_aresetn  );                                       \
+        checker->awvalid( port##_awvalid  );                                       \
+        checker->awready( port##_awready  );                                       \
+        checker->awaddr(  port##_awaddr   );                                       \
+        checker->awlen(   port##_awlen    );                                       \
+        checker->awid(    port##_awid     );                                       \
+        checker->wvalid(  port##_wvalid   );                                       \
+        checker->wready(  port##_wready   );                                       \
+        checker->wlast(   port##_wlast    );                                       \
+        checker->bvalid(  port##_bvalid   );                                       \
+        checker->bready(  port##_bready   );                                       \
+        checker->bid(     port##_bid      );                                       \
+        checker->arvalid( port##_arvalid  );                                       \
+        checker->arready( port##_arready  );                                       \
+        checker->araddr(  port##_araddr   );                                       \
+        checker->arlen(   port##_arlen    );                                       \
+        checker->arid(    port##_arid     );                                       \
+        checker->rvalid(  port##_rvalid   );                                       \
+        checker->rready(  port##_rready   );                                       \
+        checker->rlast(   port##_rlast    );                                       \
+        checker->rid(     port##_rid      );                                       \
+    } while (0)
+
+// Gate of the bridge of a port (see zynq7_bridge_gate.h), only the VALID
+// signals and the reset are watched while the bridge is suspended, the
+// handshakes are counted while it runs
+#define ZYNQ7_PS_GATE_AXI(bridge, port)                                            \
+    do {                                                                           \
+        zynq7_bridge_gate *gate =                                                  \
+            create_bridge_gate<port##_port_t>(bridge, #port "_gate");              \
+        if (!gate) {                                                               \
+            break;                                                                 \
+        }                                                                          \
+        gate->clk(     port##_aclk     );                                          \
+        gate->resetn(  port##_aresetn  );                                          \
+        gate->awvalid( port##_awvalid  );                                          \
+        gate->awready( port##_awready  );                                          \
+        gate->wvalid(  port##_wvalid   );                                          \
+        gate->bvalid(  port##_bvalid   );                                          \
+        gate->bready(  port##_bready   );                                          \
+        gate->arvalid( port##_arvalid  );                                          \
+        gate->arready( port##_arready  );                                          \
+        gate->rvalid(  port##_rvalid   );                                          \
+        gate->rready(  port##_rready   );                                          \
+        gate->rlast(   port##_rlast    );                                          \
+    } while (0)
+
+#endif /* __ZYNQ7_PS_PORTS_H__ */
@@ -0,0 +1,40 @@
+/*
+ * S AXI GP1 port for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Only the bridge for this port is created in this translation unit
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_ps.h"
+
+// S AXI GP1 : PL is the master, AXI transactions are forwarded to the PS (QEMU) through an AXI to TLM bridge
+void zynq7_ps::init_s_axi_gp1(void)
+{
+    axi2tlm_gp1 = create_axi_port<s_axi_gp1_port_t>("axi2tlm_gp1");
+
+    // Note : Some signals (e.g., awuser, wid) are connected to dummy internally (in bridge)
+    ZYNQ7_PS_BIND_AXI(axi2tlm_gp1, s_axi_gp1);
+    ZYNQ7_PS_CHECK_AXI(s_axi_gp1);
+    ZYNQ7_PS_GATE_AXI(axi2tlm_gp1, s_axi_gp1);
+}
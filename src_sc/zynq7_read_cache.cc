@@ -0,0 +1,199 @@
+/*
+ * Read cache for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_read_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <iostream>
+#include <sstream>
+
+using namespace sc_core;
+using namespace std;
+
+bool zynq7_read_cache::parse(const string &descr, vector<range> &ranges, string &error)
+{
+    istringstream iss(descr);
+    string item;
+
+    while (getline(iss, item, ',')) {
+        size_t pos = item.find(':');
+        if (pos == string::npos) {
+            error = "missing size for " + item;
+            return false;
+        }
+        string base = item.substr(0, pos);
+        string size = item.substr(pos + 1);
+        char *base_end;
+        char *size_end;
+        range r;
+        r.base = strtoull(base.c_str(), &base_end, 0);
+        r.size = strtoull(size.c_str(), &size_end, 0);
+        if (base.empty() || size.empty() || *base_end || *size_end || (r.size == 0)) {
+            error = "invalid range " + item;
+            return false;
+        }
+        ranges.push_back(r);
+    }
+    return true;
+}
+
+zynq7_read_cache::zynq7_read_cache(sc_module_name name, const string &port_name,
+                                   const vector<range> &ranges, const sc_time &lifetime) :
+    sc_module(name),
+    tgt_socket("tgt_socket"),
+    init_socket("init_socket"),
+    m_port_name(port_name),
+    m_ranges(ranges),
+    m_entries(ranges.size()),
+    m_lifetime(lifetime),
+    m_hits(0),
+    m_misses(0),
+    m_invalidations(0)
+{
+    tgt_socket.register_b_transport(this, &zynq7_read_cache::b_transport);
+    tgt_socket.register_transport_dbg(this, &zynq7_read_cache::transport_dbg);
+    tgt_socket.register_get_direct_mem_ptr(this, &zynq7_read_cache::get_direct_mem_ptr);
+    init_socket.register_invalidate_direct_mem_ptr(this, &zynq7_read_cache::invalidate_direct_mem_ptr);
+}
+
+int zynq7_read_cache::find_range(const tlm::tlm_generic_payload &trans) const
+{
+    uint64_t addr = trans.get_address();
+    uint64_t len = trans.get_data_length();
+
+    for (size_t i = 0; i < m_ranges.size(); ++i) {
+        if ((addr >= m_ranges[i].base) && (addr + len <= m_ranges[i].base + m_ranges[i].size)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// A write drops the values of every range it touches, even partly
+void zynq7_read_cache::invalidate_overlapping(const tlm::tlm_generic_payload &trans)
+{
+    uint64_t addr = trans.get_address();
+    uint64_t len = trans.get_data_length();
+
+    for (size_t i = 0; i < m_ranges.size(); ++i) {
+        if ((addr < m_ranges[i].base + m_ranges[i].size) && (m_ranges[i].base < addr + len) &&
+            !m_entries[i].empty()) {
+            m_entries[i].clear();
+            m_invalidations++;
+        }
+    }
+}
+
+// Plain accesses only (no byte enables, no streaming)
+bool zynq7_read_cache::cacheable(const tlm::tlm_generic_payload &trans)
+{
+    return (trans.get_byte_enable_ptr() == NULL) &&
+           (trans.get_streaming_width() >= trans.get_data_length());
+}
+
+void zynq7_read_cache::invalidate(void)
+{
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (!m_entries[i].empty()) {
+            m_entries[i].clear();
+            m_invalidations++;
+        }
+    }
+}
+
+void zynq7_read_cache::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    if (!trans.is_read()) {
+        invalidate_overlapping(trans);
+        init_socket->b_transport(trans, delay);
+        return;
+    }
+
+    int r = find_range(trans);
+    if (r < 0) {
+        init_socket->b_transport(trans, delay);
+        return;
+    }
+
+    entries_t &entries = m_entries[r];
+
+    std::pair<uint64_t, unsigned int> key(trans.get_address(), trans.get_data_length());
+    entries_t::iterator it = entries.find(key);
+    if ((it != entries.end()) && (m_lifetime != SC_ZERO_TIME) &&
+        (sc_time_stamp() + delay - it->second.filled >= m_lifetime)) {
+        entries.erase(it);
+        it = entries.end();
+    }
+
+    if ((it != entries.end()) && cacheable(trans)) {
+        memcpy(trans.get_data_ptr(), &it->second.data[0], trans.get_data_length());
+        trans.set_response_status(tlm::TLM_OK_RESPONSE);
+        m_hits++;
+        return;
+    }
+
+    init_socket->b_transport(trans, delay);
+    m_misses++;
+    if (trans.is_response_ok() && cacheable(trans)) {
+        entry &e = entries[key];
+        e.data.assign(trans.get_data_ptr(), trans.get_data_ptr() + trans.get_data_length());
+        e.filled = sc_time_stamp() + delay;
+    }
+}
+
+// Debug writes also drop the values, debug reads always go to the PL
+unsigned int zynq7_read_cache::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+    if (trans.is_write()) {
+        invalidate_overlapping(trans);
+    }
+    return init_socket->transport_dbg(trans);
+}
+
+bool zynq7_read_cache::get_direct_mem_ptr(tlm::tlm_generic_payload &trans, tlm::tlm_dmi &dmi_data)
+{
+    return init_socket->get_direct_mem_ptr(trans, dmi_data);
+}
+
+void zynq7_read_cache::invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range)
+{
+    tgt_socket->invalidate_direct_mem_ptr(start_range, end_range);
+}
+
+void zynq7_read_cache::print_summary(ostream &os) const
+{
+    os << m_port_name << " read cache : " << m_hits << " hits, " << m_misses << " misses, "
+       << m_invalidations << " invalidations" << endl;
+}
+
+void zynq7_read_cache::end_of_simulation(void)
+{
+    if (m_hits || m_misses) {
+        print_summary(cout);
+    }
+}
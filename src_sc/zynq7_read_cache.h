@@ -0,0 +1,107 @@
+/*
+ * Read cache for Zynq Cosim
+ *
+ * Placed between the PS and the bridge of a master port (M_AXI_GP), it
+ * answers the repeated reads of address ranges declared idempotent (e.g.,
+ * status registers polled by a driver) without going through the HDL
+ * simulation. A cached value is dropped on any write to its range, on any
+ * change of the PL interrupts (invalidate()) and after a lifetime (optional).
+ * Only the registers that the PL does not change behind the back of the PS
+ * (or for which a stale value for the lifetime is harmless) may be declared.
+ *
+ * The ranges are given by a string, a comma separated list of base:size
+ * e.g., "0x43c00000:0x10,0x43c10000:0x4"
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_READ_CACHE_H__
+#define __ZYNQ7_READ_CACHE_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class zynq7_read_cache : public sc_core::sc_module
+{
+public:
+    struct range {
+        uint64_t base;
+        uint64_t size;
+    };
+
+    // Parses a list of ranges (see above), returns false and sets error if
+    // it is malformed
+    static bool parse(const std::string &descr, std::vector<range> &ranges, std::string &error);
+
+    tlm_utils::simple_target_socket<zynq7_read_cache>    tgt_socket;
+    tlm_utils::simple_initiator_socket<zynq7_read_cache> init_socket;
+
+    // A zero lifetime means the values are kept until invalidated
+    zynq7_read_cache(sc_core::sc_module_name name, const std::string &port_name,
+                     const std::vector<range> &ranges, const sc_core::sc_time &lifetime);
+
+    // Drops all the cached values
+    void invalidate(void);
+
+    // Statistics
+    ///////////////
+    uint64_t hits(void) const { return m_hits; }
+    uint64_t misses(void) const { return m_misses; }
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    struct entry {
+        std::vector<unsigned char> data;
+        sc_core::sc_time filled;
+    };
+    // Cached values of a range by address and length
+    typedef std::map<std::pair<uint64_t, unsigned int>, entry> entries_t;
+
+    void b_transport(tlm::tlm_generic_payload &trans, sc_core::sc_time &delay);
+    unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans, tlm::tlm_dmi &dmi_data);
+    void invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range);
+
+    // Index of the range of an access, -1 when it is not (entirely) in a range
+    int find_range(const tlm::tlm_generic_payload &trans) const;
+    // Drops the values of every range an access touches (even partly)
+    void invalidate_overlapping(const tlm::tlm_generic_payload &trans);
+    static bool cacheable(const tlm::tlm_generic_payload &trans);
+
+    std::string m_port_name;
+    std::vector<range> m_ranges;
+    std::vector<entries_t> m_entries;
+    sc_core::sc_time m_lifetime;
+
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_invalidations;
+};
+
+#endif /* __ZYNQ7_READ_CACHE_H__ */
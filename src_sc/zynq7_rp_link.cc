@@ -0,0 +1,500 @@
+/*
+ * Remote port link for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_rp_link.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <endian.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+// Remote port packets (see libremote-port/remote-port-proto.h), all fields
+// are big endian. The header is followed by the payload (len bytes), for the
+// commands below the payload starts with a 64-bit timestamp
+#define RP_HDR_SIZE          20
+#define RP_CMD_READ          3
+#define RP_CMD_WRITE         4
+#define RP_CMD_INTERRUPT     5
+#define RP_CMD_SYNC          6
+#define RP_CMD_ATS_REQ       7
+#define RP_CMD_ATS_INV       8
+#define RP_PKT_FLAGS_RESPONSE (1 << 1)
+#define RP_PKT_FLAGS_POSTED   (1 << 2)
+
+static bool read_full(int fd, void *buf, size_t len)
+{
+    uint8_t *p = (uint8_t *) buf;
+    while (len) {
+        ssize_t r = read(fd, p, len);
+        if (r <= 0) {
+            return false;
+        }
+        p += r;
+        len -= r;
+    }
+    return true;
+}
+
+static bool write_full(int fd, const void *buf, size_t len)
+{
+    const uint8_t *p = (const uint8_t *) buf;
+    while (len) {
+        ssize_t r = write(fd, p, len);
+        if (r <= 0) {
+            return false;
+        }
+        p += r;
+        len -= r;
+    }
+    return true;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Something to read without blocking
+static bool readable(int fd)
+{
+    struct pollfd pfd = {fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0;
+}
+
+static int unix_socket(const string &path, struct sockaddr_un &addr)
+{
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+zynq7_rp_link::zynq7_rp_link(const string &qemu_descr, uint64_t time_scale,
+                             unsigned int connect_timeout_ms, const string &qemu_command,
+                             unsigned int batch_bytes) :
+    m_tcp(false),
+    m_time_scale(time_scale),
+    m_connect_timeout_ms(connect_timeout_ms),
+    m_qemu_pid(-1),
+    m_batch_bytes(batch_bytes),
+    m_listen_fd(-1),
+    m_hdl_fd(-1),
+    m_qemu_fd(-1),
+    m_rtt_count(0),
+    m_rtt_total(0),
+    m_rtt_max(0),
+    m_connected_at(0),
+    m_sync_observer(NULL),
+    m_sync_answered(false),
+    m_sync_time(0),
+    m_sync_answered_at(0)
+{
+    struct sockaddr_un addr;
+    ostringstream oss;
+
+    if (qemu_descr.compare(0, 5, "unix:") == 0) {
+        m_qemu_path = qemu_descr.substr(5);
+        // Private socket for the Zynq model, next to the one of QEMU
+        oss << m_qemu_path << ".link." << getpid();
+    } else if ((qemu_descr.compare(0, 4, "tcp:") == 0) && (qemu_descr.rfind(':') > 4)) {
+        size_t colon = qemu_descr.rfind(':');
+        m_tcp = true;
+        m_qemu_host = qemu_descr.substr(4, colon - 4);
+        m_qemu_port = qemu_descr.substr(colon + 1);
+        oss << "/tmp/zynq7_rp_link." << m_qemu_host << "." << m_qemu_port << "." << getpid();
+    } else {
+        cerr << "Remote port link : unix:path or tcp:host:port expected (" << qemu_descr << ")" << endl;
+        for(;;);
+    }
+    m_local_path = oss.str();
+    m_local_descr = "unix:" + m_local_path;
+
+    // Listen before the model is created so it can connect right away (the
+    // connection is pending until it is accepted by the connect thread)
+    unlink(m_local_path.c_str());
+    m_listen_fd = unix_socket(m_local_path, addr);
+    if ((m_listen_fd < 0) ||
+        (bind(m_listen_fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) ||
+        (listen(m_listen_fd, 1) < 0)) {
+        perror(m_local_path.c_str());
+        for(;;);
+    }
+
+    m_to_qemu.link = this;
+    m_to_qemu.name = "to QEMU";
+    m_to_qemu.src = &m_hdl_fd;
+    m_to_qemu.dst = &m_qemu_fd;
+    m_to_qemu.to_hdl = false;
+    m_to_qemu.packets = 0;
+    m_to_qemu.bytes = 0;
+    m_to_qemu.writes = 0;
+
+    m_from_qemu.link = this;
+    m_from_qemu.name = "from QEMU";
+    m_from_qemu.src = &m_qemu_fd;
+    m_from_qemu.dst = &m_hdl_fd;
+    m_from_qemu.to_hdl = true;
+    m_from_qemu.packets = 0;
+    m_from_qemu.bytes = 0;
+    m_from_qemu.writes = 0;
+    pthread_mutex_init(&m_rtt_lock, NULL);
+
+    if (!qemu_command.empty()) {
+        spawn(qemu_command);
+    }
+    pthread_create(&m_connect_thread, NULL, connect_main, this);
+}
+
+zynq7_rp_link::~zynq7_rp_link()
+{
+    unlink(m_local_path.c_str());
+}
+
+// Process groups of the commands launched by the links (one per instance)
+static vector<pid_t> qemu_groups;
+
+static void terminate_qemu(void)
+{
+    for (size_t i = 0; i < qemu_groups.size(); ++i) {
+        kill(-qemu_groups[i], SIGTERM);
+    }
+}
+
+void zynq7_rp_link::spawn(const string &command)
+{
+    m_qemu_pid = fork();
+    if (m_qemu_pid < 0) {
+        perror("Remote port link : fork()");
+        for(;;);
+    }
+    if (m_qemu_pid == 0) {
+        // Own process group, terminated when the simulator exits (or dies)
+        setpgid(0, 0);
+        prctl(PR_SET_PDEATHSIG, SIGTERM);
+        execl("/bin/sh", "sh", "-c", command.c_str(), (char *) NULL);
+        perror("/bin/sh");
+        _exit(127);
+    }
+    setpgid(m_qemu_pid, m_qemu_pid);
+    if (qemu_groups.empty()) {
+        atexit(terminate_qemu);
+    }
+    qemu_groups.push_back(m_qemu_pid);
+    cout << "Remote port link : QEMU launched (pid " << m_qemu_pid << ") : " << command << endl;
+}
+
+// False once QEMU launched by the link has exited
+bool zynq7_rp_link::qemu_running(void)
+{
+    int status;
+
+    if ((m_qemu_pid < 0) || (waitpid(m_qemu_pid, &status, WNOHANG) != m_qemu_pid)) {
+        return true;
+    }
+    cerr << "Remote port link : QEMU exited before listening (status " << status << ")" << endl;
+    m_qemu_pid = -1;
+    return false;
+}
+
+// Returns the connected socket or -1 (errno set)
+int zynq7_rp_link::connect_once(void)
+{
+    int fd;
+    int err;
+
+    if (!m_tcp) {
+        struct sockaddr_un addr;
+        fd = unix_socket(m_qemu_path, addr);
+        if ((fd < 0) || (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) == 0)) {
+            return fd;
+        }
+        err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+
+    struct addrinfo hints;
+    struct addrinfo *res;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    int r = getaddrinfo(m_qemu_host.c_str(), m_qemu_port.c_str(), &hints, &res);
+    if (r) {
+        cerr << "Remote port link : " << m_qemu_host << " : " << gai_strerror(r) << endl;
+        errno = EINVAL;
+        return -1;
+    }
+    fd = -1;
+    err = ECONNREFUSED;
+    for (struct addrinfo *ai = res; ai && (fd < 0); ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if ((fd >= 0) && (connect(fd, ai->ai_addr, ai->ai_addrlen) < 0)) {
+            err = errno;
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(res);
+    if (fd < 0) {
+        errno = err;
+        return -1;
+    }
+    // The packets are small and latency bound
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+bool zynq7_rp_link::connect_qemu(void)
+{
+    unsigned int waited = 0;
+    unsigned int backoff = 10;
+
+    for (;;) {
+        m_qemu_fd = connect_once();
+        if (m_qemu_fd >= 0) {
+            break;
+        }
+        int err = errno;
+
+        // Not listening yet (no socket or no server behind it)
+        bool not_yet = (err == ENOENT) || (err == ECONNREFUSED);
+        if (!not_yet || (waited >= m_connect_timeout_ms) || !qemu_running()) {
+            errno = err;
+            perror(m_tcp ? (m_qemu_host + ":" + m_qemu_port).c_str() : m_qemu_path.c_str());
+            return false;
+        }
+        usleep(backoff * 1000);
+        waited += backoff;
+        backoff = min(backoff * 2, 1000u);
+    }
+
+    if (waited) {
+        cout << "Remote port link : connected to QEMU after " << waited << " ms" << endl;
+    }
+    m_connected_at = wall_seconds();
+    return true;
+}
+
+void *zynq7_rp_link::connect_main(void *arg)
+{
+    zynq7_rp_link *link = (zynq7_rp_link *) arg;
+
+    link->m_hdl_fd = accept(link->m_listen_fd, NULL, NULL);
+    if (link->m_hdl_fd < 0) {
+        perror("Remote port link : accept()");
+        return NULL;
+    }
+    close(link->m_listen_fd);
+    unlink(link->m_local_path.c_str());
+
+    // The packets of the model are held by its socket until then
+    if (!link->connect_qemu()) {
+        close(link->m_hdl_fd);
+        return NULL;
+    }
+
+    pthread_create(&link->m_to_qemu.thread, NULL, relay_main, &link->m_to_qemu);
+    pthread_create(&link->m_from_qemu.thread, NULL, relay_main, &link->m_from_qemu);
+    return NULL;
+}
+
+void *zynq7_rp_link::relay_main(void *arg)
+{
+    relay *r = (relay *) arg;
+
+    while (r->link->forward_packet(*r)) {
+        r->packets++;
+    }
+    r->link->flush(*r);
+
+    cerr << "Remote port link : connection closed (" << r->name << ")" << endl;
+    shutdown(*r->dst, SHUT_RDWR);
+    return NULL;
+}
+
+uint64_t zynq7_rp_link::rescale(uint64_t timestamp, bool to_hdl) const
+{
+    return to_hdl ? timestamp * m_time_scale : timestamp / m_time_scale;
+}
+
+bool zynq7_rp_link::forward_packet(relay &r)
+{
+    uint32_t hdr[RP_HDR_SIZE / 4];
+
+    if (!read_full(*r.src, hdr, RP_HDR_SIZE)) {
+        return false;
+    }
+    uint32_t cmd = be32toh(hdr[0]);
+    uint32_t len = be32toh(hdr[1]);
+
+    // Appended to the batch
+    size_t start = r.out.size();
+    r.out.resize(start + RP_HDR_SIZE + len);
+    uint8_t *pkt = &r.out[start];
+    memcpy(pkt, hdr, RP_HDR_SIZE);
+    if (len && !read_full(*r.src, &pkt[RP_HDR_SIZE], len)) {
+        r.out.resize(start);
+        return false;
+    }
+    round_trip(pkt, len, r.to_hdl);
+
+    switch (cmd) {
+    case RP_CMD_READ:
+    case RP_CMD_WRITE:
+    case RP_CMD_INTERRUPT:
+    case RP_CMD_SYNC:
+    case RP_CMD_ATS_REQ:
+    case RP_CMD_ATS_INV:
+        if (len >= sizeof(uint64_t)) {
+            uint64_t ts;
+            memcpy(&ts, &pkt[RP_HDR_SIZE], sizeof(ts));
+            ts = htobe64(rescale(be64toh(ts), r.to_hdl));
+            memcpy(&pkt[RP_HDR_SIZE], &ts, sizeof(ts));
+        }
+        break;
+    default:
+        break;
+    }
+
+    // Sent when nothing more is ready (never held waiting for the next packet)
+    if ((r.out.size() < m_batch_bytes) && readable(*r.src)) {
+        return true;
+    }
+    return flush(r);
+}
+
+bool zynq7_rp_link::flush(relay &r)
+{
+    if (r.out.empty()) {
+        return true;
+    }
+    bool ok = write_full(*r.dst, &r.out[0], r.out.size());
+    r.bytes += r.out.size();
+    r.writes++;
+    r.out.clear();
+    return ok;
+}
+
+// Requests of the model matched with the responses of QEMU and sync
+// requests of QEMU with the answers of the model, called before the
+// timestamp is rescaled
+void zynq7_rp_link::round_trip(const uint8_t *pkt, uint32_t len, bool to_hdl)
+{
+    uint32_t hdr[RP_HDR_SIZE / 4];
+    memcpy(hdr, pkt, RP_HDR_SIZE);
+    uint32_t cmd = be32toh(hdr[0]);
+    uint32_t id = be32toh(hdr[2]);
+    uint32_t flags = be32toh(hdr[3]);
+    bool response = flags & RP_PKT_FLAGS_RESPONSE;
+    double now = wall_seconds();
+    bool waited = false;
+    uint64_t sync_time = 0;
+    double sync_start = 0;
+
+    pthread_mutex_lock(&m_rtt_lock);
+    if (to_hdl) {
+        // The model waited for QEMU since its last answer to a sync
+        if (m_sync_answered) {
+            m_sync_answered = false;
+            waited = true;
+            sync_time = m_sync_time;
+            sync_start = m_sync_answered_at;
+        }
+        if (response) {
+            map<uint32_t, double>::iterator it = m_rtt_pending.find(id);
+            if (it != m_rtt_pending.end()) {
+                double rtt = now - it->second;
+                m_rtt_count++;
+                m_rtt_total += rtt;
+                m_rtt_max = max(m_rtt_max, rtt);
+                m_rtt_pending.erase(it);
+            }
+        } else if ((cmd == RP_CMD_SYNC) && (len >= sizeof(uint64_t))) {
+            uint64_t ts;
+            memcpy(&ts, &pkt[RP_HDR_SIZE], sizeof(ts));
+            m_sync_pending[id] = rescale(be64toh(ts), true);
+        }
+    } else if (!response && !(flags & RP_PKT_FLAGS_POSTED)) {
+        m_rtt_pending[id] = now;
+    } else if (response && (cmd == RP_CMD_SYNC)) {
+        map<uint32_t, uint64_t>::iterator it = m_sync_pending.find(id);
+        if (it != m_sync_pending.end()) {
+            m_sync_answered = true;
+            m_sync_time = it->second;
+            m_sync_answered_at = now;
+            m_sync_pending.erase(it);
+        }
+    }
+    pthread_mutex_unlock(&m_rtt_lock);
+
+    if (waited && m_sync_observer) {
+        m_sync_observer->qemu_sync(sync_time, sync_start, now);
+    }
+}
+
+void zynq7_rp_link::print_summary(ostream &os)
+{
+    double seconds = m_connected_at ? wall_seconds() - m_connected_at : 0;
+    const relay *relays[] = {&m_to_qemu, &m_from_qemu};
+
+    for (int i = 0; i < 2; ++i) {
+        const relay &r = *relays[i];
+        os << "Remote port link " << r.name << " : " << r.packets << " packets, " << r.bytes
+           << " bytes in " << r.writes << " writes";
+        if (seconds > 0) {
+            os << " (" << r.bytes / seconds / 1e6 << " MB/s)";
+        }
+        os << endl;
+    }
+    pthread_mutex_lock(&m_rtt_lock);
+    if (m_rtt_count) {
+        os << "Remote port link round trip : " << m_rtt_count << " requests, average "
+           << m_rtt_total / m_rtt_count * 1e6 << " us, max " << m_rtt_max * 1e6 << " us" << endl;
+    }
+    pthread_mutex_unlock(&m_rtt_lock);
+}
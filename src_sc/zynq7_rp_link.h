@@ -0,0 +1,159 @@
+/*
+ * Remote port link for Zynq Cosim
+ *
+ * Relay between QEMU and the remote port of the Zynq model. The model
+ * connects to a private socket created by the link and the link connects to
+ * QEMU, the packets are forwarded in both directions by two threads.
+ *
+ * The relay rescales the timestamps of the packets so the simulation can run
+ * on a different time base than QEMU : HDL time = QEMU time x scale.
+ *
+ * The connection to QEMU is made in the background, the model connects to
+ * the link right away and the elaboration of the HDL proceeds while QEMU
+ * starts. The simulation itself does not : the remote port of the model
+ * waits for the hello of QEMU at time 0, so the reset of the HDL only runs
+ * once QEMU is connected. With a timeout, the connection is retried (backoff
+ * from 10 ms to 1 s) until QEMU listens. The link can also launch QEMU
+ * itself (shell command line), it is terminated with the simulator.
+ *
+ * QEMU may run on another host (tcp:host:port), Nagle is then disabled on
+ * the connection. The packets can be batched : while more packets are ready
+ * on one side they are gathered (up to a number of bytes) and written at
+ * once, a packet is never held while waiting for the next one. The link
+ * reports the traffic and the round trip time of the requests to QEMU. The
+ * syncs can be reported to an observer (e.g., a timeline, see
+ * zynq7_timeline.h) : QEMU sends a sync request at the end of its quantum,
+ * the model answers it once its time reaches the timestamp and then waits
+ * for QEMU to run the next quantum. The wait is the host time from the
+ * answer (matched by packet ID) to the next packet of QEMU.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_RP_LINK_H__
+#define __ZYNQ7_RP_LINK_H__
+
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Told about each sync of the model with QEMU, from the thread of the link
+class zynq7_rp_sync_observer
+{
+public:
+    virtual ~zynq7_rp_sync_observer() {}
+
+    // time_ns : time of the sync (HDL time), wall_start : answer of the model,
+    // wall_end : next packet of QEMU (CLOCK_MONOTONIC, in seconds)
+    virtual void qemu_sync(uint64_t time_ns, double wall_start, double wall_end) = 0;
+};
+
+class zynq7_rp_link
+{
+public:
+    // qemu_descr is the remote port descriptor of QEMU (unix:/path or tcp:host:port), the
+    // connection is retried for up to connect_timeout_ms (0 : a single attempt), qemu_command
+    // is launched first when not empty. Batches of up to batch_bytes (0 : no batching)
+    zynq7_rp_link(const std::string &qemu_descr, uint64_t time_scale,
+                  unsigned int connect_timeout_ms = 0, const std::string &qemu_command = "",
+                  unsigned int batch_bytes = 0);
+    ~zynq7_rp_link();
+
+    // Descriptor the Zynq model should connect to
+    const char *descr(void) const { return m_local_descr.c_str(); }
+
+    // Set before the simulation starts
+    void set_sync_observer(zynq7_rp_sync_observer *observer) { m_sync_observer = observer; }
+
+    // Packet statistics
+    uint64_t packets_to_qemu(void) const { return m_to_qemu.packets; }
+    uint64_t packets_from_qemu(void) const { return m_from_qemu.packets; }
+
+    void print_summary(std::ostream &os);
+
+private:
+    // One direction of the link
+    struct relay {
+        zynq7_rp_link *link;
+        const char *name;
+        int *src;
+        int *dst;
+        bool to_hdl; // Timestamps are multiplied toward the HDL and divided toward QEMU
+        uint64_t packets;
+        uint64_t bytes;
+        uint64_t writes;
+        std::vector<uint8_t> out; // Batch
+        pthread_t thread;
+    };
+
+    void spawn(const std::string &command);
+    bool qemu_running(void);
+    int connect_once(void);
+    bool connect_qemu(void);
+    static void *connect_main(void *arg);
+    static void *relay_main(void *arg);
+    bool forward_packet(relay &r);
+    bool flush(relay &r);
+    void round_trip(const uint8_t *pkt, uint32_t len, bool to_hdl);
+    uint64_t rescale(uint64_t timestamp, bool to_hdl) const;
+
+    std::string m_qemu_path;  // unix
+    std::string m_qemu_host;  // tcp
+    std::string m_qemu_port;
+    bool m_tcp;
+    std::string m_local_path;
+    std::string m_local_descr;
+    uint64_t m_time_scale;
+    unsigned int m_connect_timeout_ms;
+    pid_t m_qemu_pid; // -1 when not launched by the link
+    unsigned int m_batch_bytes;
+
+    int m_listen_fd;
+    int m_hdl_fd;
+    int m_qemu_fd;
+
+    pthread_t m_connect_thread;
+    relay m_to_qemu;
+    relay m_from_qemu;
+
+    // Requests to QEMU waiting for their response (by ID, sent in seconds)
+    pthread_mutex_t m_rtt_lock;
+    std::map<uint32_t, double> m_rtt_pending;
+    uint64_t m_rtt_count;
+    double m_rtt_total;
+    double m_rtt_max;
+    double m_connected_at;
+    zynq7_rp_sync_observer *m_sync_observer;
+    // Sync requests of QEMU waiting for the answer of the model (by ID, HDL
+    // time), then the answered one until the next packet of QEMU
+    std::map<uint32_t, uint64_t> m_sync_pending;
+    bool m_sync_answered;
+    uint64_t m_sync_time;
+    double m_sync_answered_at;
+};
+
+#endif /* __ZYNQ7_RP_LINK_H__ */
@@ -0,0 +1,70 @@
+/*
+ * AXI over shared memory for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_ps_ports.h"
+#include "zynq7_shm_axi.h"
+
+#include <iostream>
+
+using namespace sc_core;
+using namespace sc_dt;
+using namespace std;
+
+SC_MODULE_EXPORT(zynq7_shm_slave);
+SC_MODULE_EXPORT(zynq7_shm_master);
+
+static sc_time shm_quantum(const char *name, const string &path, int quantum_in_ns)
+{
+    if (path.empty() || (quantum_in_ns <= 0)) {
+        cerr << name << " : PATH_G and a positive QUANTUM_IN_NS_G are required" << endl;
+        for(;;);
+    }
+    return sc_time(quantum_in_ns, SC_NS);
+}
+
+zynq7_shm_slave::zynq7_shm_slave(sc_module_name name) :
+    sc_module(name),
+    SC_INIT_GENERIC_STRING(PATH_G),
+    SC_INIT_GENERIC_INT(QUANTUM_IN_NS_G)
+{
+    m_shm = new zynq7_shm_axi_slave<ZYNQ7_SHM_AXI_ADDR_WIDTH, ZYNQ7_SHM_AXI_DATA_WIDTH, ZYNQ7_SHM_AXI_ID_WIDTH,
+                                    ZYNQ7_SHM_AXI_AXLEN_WIDTH, ZYNQ7_SHM_AXI_AXLOCK_WIDTH>(
+        "shm", PATH_G, shm_quantum(this->name(), PATH_G, QUANTUM_IN_NS_G));
+
+    ZYNQ7_PS_BIND_AXI((&m_shm->bridge), s_axi);
+}
+
+zynq7_shm_master::zynq7_shm_master(sc_module_name name) :
+    sc_module(name),
+    SC_INIT_GENERIC_STRING(PATH_G),
+    SC_INIT_GENERIC_INT(QUANTUM_IN_NS_G)
+{
+    m_shm = new zynq7_shm_axi_master<ZYNQ7_SHM_AXI_ADDR_WIDTH, ZYNQ7_SHM_AXI_DATA_WIDTH, ZYNQ7_SHM_AXI_ID_WIDTH,
+                                     ZYNQ7_SHM_AXI_AXLEN_WIDTH, ZYNQ7_SHM_AXI_AXLOCK_WIDTH>(
+        "shm", PATH_G, shm_quantum(this->name(), PATH_G, QUANTUM_IN_NS_G));
+
+    ZYNQ7_PS_BIND_AXI((&m_shm->bridge), m_axi);
+}
@@ -0,0 +1,254 @@
+/*
+ * AXI over shared memory for Zynq Cosim
+ *
+ * Pair of modules carrying an AXI interface between two simulator processes
+ * (see zynq7_shm_link.h), e.g., to split a large PL into partitions on
+ * separate cores with zynq7_ps in one of them :
+ * - zynq7_shm_axi_slave : AXI slave pins (an AXI to TLM bridge) for a master
+ *   of this partition, the transactions go to the peer
+ * - zynq7_shm_axi_master : AXI master pins (a TLM to AXI bridge) driving a
+ *   slave of this partition with the transactions of the peer
+ * Both ends use the same widths and path. The pins are the ones of the
+ * bridge (member bridge), e.g., bound with
+ * ZYNQ7_PS_BIND_AXI((&shm->bridge), port).
+ *
+ * zynq7_shm_slave and zynq7_shm_master wrap them as entities exported to the
+ * HDL simulator (see src_vhdl/zynq7_shm_axi_wrapper.vhd), with the path and
+ * the quantum as generics. As for the AXI ports of zynq7_ps, their widths
+ * are compilation constants (__SHM_AXI_ADDR_WIDTH__, __SHM_AXI_DATA_WIDTH__,
+ * __SHM_AXI_ID_WIDTH__, __SHM_AXI_AXLEN_WIDTH__ and __SHM_AXI_AXLOCK_WIDTH__,
+ * the ones of an S_AXI_HP port by default).
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_SHM_AXI_H__
+#define __ZYNQ7_SHM_AXI_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_shm_link.h"
+
+#include <string>
+
+template <int ADDR_WIDTH, int DATA_WIDTH, int ID_WIDTH, int AXLEN_WIDTH = 8,
+          int AXLOCK_WIDTH = 1, int AWUSER_WIDTH = 2, int ARUSER_WIDTH = 2>
+class zynq7_shm_axi_slave : public sc_core::sc_module
+{
+public:
+    axi2tlm_bridge<ADDR_WIDTH, DATA_WIDTH, ID_WIDTH, AXLEN_WIDTH,
+                   AXLOCK_WIDTH, AWUSER_WIDTH, ARUSER_WIDTH> bridge;
+    zynq7_shm_initiator link;
+
+    zynq7_shm_axi_slave(sc_core::sc_module_name name, const std::string &path,
+                        const sc_core::sc_time &quantum) :
+        sc_module(name),
+        bridge("bridge"),
+        link("link", path, quantum)
+    {
+        bridge.socket.bind(link.tgt_socket);
+    }
+};
+
+template <int ADDR_WIDTH, int DATA_WIDTH, int ID_WIDTH, int AXLEN_WIDTH = 8,
+          int AXLOCK_WIDTH = 1, int AWUSER_WIDTH = 2, int ARUSER_WIDTH = 2>
+class zynq7_shm_axi_master : public sc_core::sc_module
+{
+public:
+    tlm2axi_bridge<ADDR_WIDTH, DATA_WIDTH, ID_WIDTH, AXLEN_WIDTH,
+                   AXLOCK_WIDTH, AWUSER_WIDTH, ARUSER_WIDTH> bridge;
+    zynq7_shm_target link;
+
+    zynq7_shm_axi_master(sc_core::sc_module_name name, const std::string &path,
+                         const sc_core::sc_time &quantum) :
+        sc_module(name),
+        bridge("bridge"),
+        link("link", path, quantum)
+    {
+        link.init_socket.bind(bridge.tgt_socket);
+    }
+};
+
+#ifdef __SHM_AXI_ADDR_WIDTH__
+static const int ZYNQ7_SHM_AXI_ADDR_WIDTH = __SHM_AXI_ADDR_WIDTH__;
+#else
+static const int ZYNQ7_SHM_AXI_ADDR_WIDTH = 32;
+#endif
+#ifdef __SHM_AXI_DATA_WIDTH__
+static const int ZYNQ7_SHM_AXI_DATA_WIDTH = __SHM_AXI_DATA_WIDTH__;
+#else
+static const int ZYNQ7_SHM_AXI_DATA_WIDTH = 64;
+#endif
+#ifdef __SHM_AXI_ID_WIDTH__
+static const int ZYNQ7_SHM_AXI_ID_WIDTH = __SHM_AXI_ID_WIDTH__;
+#else
+static const int ZYNQ7_SHM_AXI_ID_WIDTH = 6;
+#endif
+#ifdef __SHM_AXI_AXLEN_WIDTH__
+static const int ZYNQ7_SHM_AXI_AXLEN_WIDTH = __SHM_AXI_AXLEN_WIDTH__;
+#else
+static const int ZYNQ7_SHM_AXI_AXLEN_WIDTH = 4;
+#endif
+#ifdef __SHM_AXI_AXLOCK_WIDTH__
+static const int ZYNQ7_SHM_AXI_AXLOCK_WIDTH = __SHM_AXI_AXLOCK_WIDTH__;
+#else
+static const int ZYNQ7_SHM_AXI_AXLOCK_WIDTH = 2;
+#endif
+
+// AXI slave pins exported to the HDL simulator, the transactions of the
+// master driving them go to the peer
+SC_MODULE(zynq7_shm_slave)
+{
+public:
+    // Shared file of the link, same on both ends (e.g., /dev/shm/zynq7_link0)
+    SC_GENERIC_STRING(PATH_G, "");
+    // Synchronization quantum, same on both ends
+    SC_GENERIC_INT(QUANTUM_IN_NS_G, 1000);
+
+    sc_in<bool>                                     s_axi_aclk;
+    sc_in<bool>                                     s_axi_aresetn;
+
+    /* Write address channel.  */
+    sc_in<bool>                                     s_axi_awvalid;
+    sc_out<bool>                                    s_axi_awready;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_ADDR_WIDTH> >         s_axi_awaddr;
+    sc_in<sc_bv<3> >                                s_axi_awprot;
+    sc_in<sc_bv<4> >                                s_axi_awregion;
+    sc_in<sc_bv<4> >                                s_axi_awqos;
+    sc_in<sc_bv<4> >                                s_axi_awcache;
+    sc_in<sc_bv<2> >                                s_axi_awburst;
+    sc_in<sc_bv<3> >                                s_axi_awsize;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_AXLEN_WIDTH> >        s_axi_awlen;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_ID_WIDTH> >           s_axi_awid;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_AXLOCK_WIDTH> >       s_axi_awlock;
+
+    /* Write data channel.  */
+    sc_in<bool>                                     s_axi_wvalid;
+    sc_out<bool>                                    s_axi_wready;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_DATA_WIDTH> >         s_axi_wdata;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_DATA_WIDTH/8> >       s_axi_wstrb;
+    sc_in<bool>                                     s_axi_wlast;
+
+    /* Write response channel.  */
+    sc_out<bool>                                    s_axi_bvalid;
+    sc_in<bool>                                     s_axi_bready;
+    sc_out<sc_bv<2> >                               s_axi_bresp;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_ID_WIDTH> >          s_axi_bid;
+
+    /* Read address channel.  */
+    sc_in<bool>                                     s_axi_arvalid;
+    sc_out<bool>                                    s_axi_arready;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_ADDR_WIDTH> >         s_axi_araddr;
+    sc_in<sc_bv<3> >                                s_axi_arprot;
+    sc_in<sc_bv<4> >                                s_axi_arregion;
+    sc_in<sc_bv<4> >                                s_axi_arqos;
+    sc_in<sc_bv<4> >                                s_axi_arcache;
+    sc_in<sc_bv<2> >                                s_axi_arburst;
+    sc_in<sc_bv<3> >                                s_axi_arsize;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_AXLEN_WIDTH> >        s_axi_arlen;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_ID_WIDTH> >           s_axi_arid;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_AXLOCK_WIDTH> >       s_axi_arlock;
+
+    /* Read data channel.  */
+    sc_out<bool>                                    s_axi_rvalid;
+    sc_in<bool>                                     s_axi_rready;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_DATA_WIDTH> >        s_axi_rdata;
+    sc_out<sc_bv<2> >                               s_axi_rresp;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_ID_WIDTH> >          s_axi_rid;
+    sc_out<bool>                                    s_axi_rlast;
+
+    zynq7_shm_slave(sc_module_name name);
+
+private:
+    zynq7_shm_axi_slave<ZYNQ7_SHM_AXI_ADDR_WIDTH, ZYNQ7_SHM_AXI_DATA_WIDTH, ZYNQ7_SHM_AXI_ID_WIDTH,
+                        ZYNQ7_SHM_AXI_AXLEN_WIDTH, ZYNQ7_SHM_AXI_AXLOCK_WIDTH> *m_shm;
+};
+
+// AXI master pins exported to the HDL simulator, they drive the slave with
+// the transactions of the peer
+SC_MODULE(zynq7_shm_master)
+{
+public:
+    // Shared file of the link, same on both ends (e.g., /dev/shm/zynq7_link0)
+    SC_GENERIC_STRING(PATH_G, "");
+    // Synchronization quantum, same on both ends
+    SC_GENERIC_INT(QUANTUM_IN_NS_G, 1000);
+
+    sc_in<bool>                                     m_axi_aclk;
+    sc_in<bool>                                     m_axi_aresetn;
+
+    /* Write address channel.  */
+    sc_out<bool>                                    m_axi_awvalid;
+    sc_in<bool>                                     m_axi_awready;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_ADDR_WIDTH> >        m_axi_awaddr;
+    sc_out<sc_bv<3> >                               m_axi_awprot;
+    sc_out<sc_bv<4> >                               m_axi_awregion;
+    sc_out<sc_bv<4> >                               m_axi_awqos;
+    sc_out<sc_bv<4> >                               m_axi_awcache;
+    sc_out<sc_bv<2> >                               m_axi_awburst;
+    sc_out<sc_bv<3> >                               m_axi_awsize;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_AXLEN_WIDTH> >       m_axi_awlen;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_ID_WIDTH> >          m_axi_awid;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_AXLOCK_WIDTH> >      m_axi_awlock;
+
+    /* Write data channel.  */
+    sc_out<bool>                                    m_axi_wvalid;
+    sc_in<bool>                                     m_axi_wready;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_DATA_WIDTH> >        m_axi_wdata;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_DATA_WIDTH/8> >      m_axi_wstrb;
+    sc_out<bool>                                    m_axi_wlast;
+
+    /* Write response channel.  */
+    sc_in<bool>                                     m_axi_bvalid;
+    sc_out<bool>                                    m_axi_bready;
+    sc_in<sc_bv<2> >                                m_axi_bresp;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_ID_WIDTH> >           m_axi_bid;
+
+    /* Read address channel.  */
+    sc_out<bool>                                    m_axi_arvalid;
+    sc_in<bool>                                     m_axi_arready;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_ADDR_WIDTH> >        m_axi_araddr;
+    sc_out<sc_bv<3> >                               m_axi_arprot;
+    sc_out<sc_bv<4> >                               m_axi_arregion;
+    sc_out<sc_bv<4> >                               m_axi_arqos;
+    sc_out<sc_bv<4> >                               m_axi_arcache;
+    sc_out<sc_bv<2> >                               m_axi_arburst;
+    sc_out<sc_bv<3> >                               m_axi_arsize;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_AXLEN_WIDTH> >       m_axi_arlen;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_ID_WIDTH> >          m_axi_arid;
+    sc_out<sc_bv<ZYNQ7_SHM_AXI_AXLOCK_WIDTH> >      m_axi_arlock;
+
+    /* Read data channel.  */
+    sc_in<bool>                                     m_axi_rvalid;
+    sc_out<bool>                                    m_axi_rready;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_DATA_WIDTH> >         m_axi_rdata;
+    sc_in<sc_bv<2> >                                m_axi_rresp;
+    sc_in<sc_bv<ZYNQ7_SHM_AXI_ID_WIDTH> >           m_axi_rid;
+    sc_in<bool>                                     m_axi_rlast;
+
+    zynq7_shm_master(sc_module_name name);
+
+private:
+    zynq7_shm_axi_master<ZYNQ7_SHM_AXI_ADDR_WIDTH, ZYNQ7_SHM_AXI_DATA_WIDTH, ZYNQ7_SHM_AXI_ID_WIDTH,
+                         ZYNQ7_SHM_AXI_AXLEN_WIDTH, ZYNQ7_SHM_AXI_AXLOCK_WIDTH> *m_shm;
+};
+
+#endif /* __ZYNQ7_SHM_AXI_H__ */
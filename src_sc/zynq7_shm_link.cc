@@ -0,0 +1,305 @@
+/*
+ * Shared memory link for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_shm_link.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include <iostream>
+
+using namespace sc_core;
+using namespace std;
+
+// The fields written by the peer are read with acquire, the own ones are
+// written with release so the slot is visible before the time or the state
+#define SHM_LOAD(field)         __atomic_load_n(&(field), __ATOMIC_ACQUIRE)
+#define SHM_STORE(field, value) __atomic_store_n(&(field), (value), __ATOMIC_RELEASE)
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+zynq7_shm_link::zynq7_shm_link(sc_module_name name, const string &path, side s,
+                               const sc_time &quantum) :
+    sc_module(name),
+    m_area(NULL),
+    m_transactions(0),
+    m_path(path),
+    m_side(s),
+    m_peer(s == INITIATOR ? TARGET : INITIATOR),
+    m_quantum(quantum),
+    m_wait_seconds(0)
+{
+    assert(m_quantum > SC_ZERO_TIME);
+
+    // Created by the first side, zero-filled
+    int fd = open(m_path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        perror(m_path.c_str());
+        for(;;);
+    }
+    struct stat st;
+    if ((fstat(fd, &st) < 0) ||
+        (((size_t) st.st_size < sizeof(area)) && (ftruncate(fd, sizeof(area)) < 0))) {
+        perror(m_path.c_str());
+        for(;;);
+    }
+    void *data = mmap(NULL, sizeof(area), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror("mmap");
+        for(;;);
+    }
+    m_area = (area *) data;
+
+    // Forget a peer left by a crashed process
+    pid_t peer_pid = SHM_LOAD(m_area->pid[m_peer]);
+    if (peer_pid && (kill(peer_pid, 0) < 0) && (errno == ESRCH)) {
+        SHM_STORE(m_area->pid[m_peer], 0);
+    }
+    m_area->time[m_side] = 0;
+    m_area->closed[m_side] = 0;
+    if (m_side == INITIATOR) {
+        for (unsigned int i = 0; i < SLOTS; ++i) {
+            m_area->s[i].state = FREE;
+        }
+    }
+    SHM_STORE(m_area->pid[m_side], (uint32_t) getpid());
+
+    SC_THREAD(sync_thread);
+}
+
+zynq7_shm_link::~zynq7_shm_link()
+{
+    munmap(m_area, sizeof(area));
+}
+
+zynq7_shm_link::slot_state zynq7_shm_link::state(unsigned int i) const
+{
+    return (slot_state) SHM_LOAD(m_area->s[i].state);
+}
+
+void zynq7_shm_link::set_state(unsigned int i, slot_state s)
+{
+    SHM_STORE(m_area->s[i].state, (uint32_t) s);
+}
+
+bool zynq7_shm_link::wait_peer(uint64_t time)
+{
+    double start = wall_seconds();
+    unsigned int spins = 0;
+
+    for (;;) {
+        pid_t pid = SHM_LOAD(m_area->pid[m_peer]);
+        if (pid) {
+            if (SHM_LOAD(m_area->closed[m_peer])) {
+                break;
+            }
+            if (SHM_LOAD(m_area->time[m_peer]) >= time) {
+                m_wait_seconds += wall_seconds() - start;
+                return true;
+            }
+        }
+        // Busy at first (the peer is usually close), then let it have the core
+        if (++spins > 1000) {
+            if (pid && (kill(pid, 0) < 0) && (errno == ESRCH)) {
+                break;
+            }
+            sched_yield();
+        }
+    }
+
+    m_wait_seconds += wall_seconds() - start;
+    cout << sc_time_stamp() << " " << name() << " : the peer ended its simulation" << endl;
+    return false;
+}
+
+// Advances in quanta, the peer reaches every boundary before this side goes
+// on. The slots written before the boundary by the peer are then visible
+void zynq7_shm_link::sync_thread(void)
+{
+    for (;;) {
+        wait(m_quantum);
+        uint64_t now = sc_time_stamp().value();
+        SHM_STORE(m_area->time[m_side], now);
+        if (!wait_peer(now)) {
+            sc_stop();
+            return;
+        }
+        poll();
+    }
+}
+
+void zynq7_shm_link::print_summary(ostream &os) const
+{
+    os << name() << " : " << m_transactions << " transactions, waited "
+       << m_wait_seconds << " s for the peer" << endl;
+}
+
+void zynq7_shm_link::end_of_simulation(void)
+{
+    SHM_STORE(m_area->closed[m_side], 1);
+    unlink(m_path.c_str());
+    print_summary(cout);
+}
+
+// Initiator side
+///////////////////
+
+zynq7_shm_initiator::zynq7_shm_initiator(sc_module_name name, const string &path,
+                                         const sc_time &quantum) :
+    zynq7_shm_link(name, path, INITIATOR, quantum),
+    tgt_socket("tgt_socket")
+{
+    tgt_socket.register_b_transport(this, &zynq7_shm_initiator::b_transport);
+}
+
+// A response is taken on the first boundary at or after its completion
+void zynq7_shm_initiator::poll(void)
+{
+    for (unsigned int i = 0; i < SLOTS; ++i) {
+        if ((state(i) == RESPONSE) && (m_area->s[i].time <= sc_time_stamp().value())) {
+            m_response_event[i].notify();
+        }
+    }
+}
+
+void zynq7_shm_initiator::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    unsigned int len = trans.get_data_length();
+    unsigned int be_len = trans.get_byte_enable_ptr() ? trans.get_byte_enable_length() : 0;
+
+    if ((len > MAX_DATA) || (be_len > MAX_DATA)) {
+        cerr << name() << " : transaction of " << len << " bytes, larger than " << MAX_DATA << endl;
+        trans.set_response_status(tlm::TLM_GENERIC_ERROR_RESPONSE);
+        return;
+    }
+
+    // The slot is filled without yielding, the other initiators see it taken
+    unsigned int i = 0;
+    for (;;) {
+        while ((i < SLOTS) && (state(i) != FREE)) {
+            ++i;
+        }
+        if (i < SLOTS) {
+            break;
+        }
+        wait(m_free_event);
+        i = 0;
+    }
+
+    slot &s = m_area->s[i];
+    s.command = trans.get_command();
+    s.address = trans.get_address();
+    s.length = len;
+    s.be_length = be_len;
+    s.streaming_width = trans.get_streaming_width();
+    s.time = (sc_time_stamp() + delay).value();
+    if (trans.is_write()) {
+        memcpy(s.data, trans.get_data_ptr(), len);
+    }
+    if (be_len) {
+        memcpy(s.be, trans.get_byte_enable_ptr(), be_len);
+    }
+    set_state(i, REQUEST);
+
+    wait(m_response_event[i]);
+
+    if (trans.is_read()) {
+        memcpy(trans.get_data_ptr(), s.data, len);
+    }
+    trans.set_response_status((tlm::tlm_response_status) s.response);
+    delay = SC_ZERO_TIME;
+    set_state(i, FREE);
+    m_transactions++;
+
+    m_free_event.notify();
+}
+
+// Target side
+////////////////
+
+zynq7_shm_target::zynq7_shm_target(sc_module_name name, const string &path,
+                                   const sc_time &quantum) :
+    zynq7_shm_link(name, path, TARGET, quantum),
+    init_socket("init_socket")
+{
+    for (unsigned int i = 0; i < SLOTS; ++i) {
+        m_serving[i] = false;
+        sc_spawn(sc_bind(&zynq7_shm_target::serve_thread, this, i));
+    }
+}
+
+// A request is taken on the first boundary at or after its issue
+void zynq7_shm_target::poll(void)
+{
+    for (unsigned int i = 0; i < SLOTS; ++i) {
+        if (!m_serving[i] && (state(i) == REQUEST) && (m_area->s[i].time <= sc_time_stamp().value())) {
+            m_serving[i] = true;
+            m_request_event[i].notify();
+        }
+    }
+}
+
+void zynq7_shm_target::serve_thread(unsigned int i)
+{
+    slot &s = m_area->s[i];
+    tlm::tlm_generic_payload trans;
+
+    for (;;) {
+        wait(m_request_event[i]);
+
+        sc_time delay = SC_ZERO_TIME;
+        trans.set_command((tlm::tlm_command) s.command);
+        trans.set_address(s.address);
+        trans.set_data_ptr(s.data);
+        trans.set_data_length(s.length);
+        trans.set_byte_enable_ptr(s.be_length ? s.be : NULL);
+        trans.set_byte_enable_length(s.be_length);
+        trans.set_streaming_width(s.streaming_width);
+        trans.set_dmi_allowed(false);
+        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+
+        init_socket->b_transport(trans, delay);
+        wait(delay);
+
+        s.response = trans.get_response_status();
+        s.time = sc_time_stamp().value();
+        set_state(i, RESPONSE);
+        m_serving[i] = false;
+        m_transactions++;
+    }
+}
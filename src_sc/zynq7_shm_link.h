@@ -0,0 +1,168 @@
+/*
+ * Shared memory link for Zynq Cosim
+ *
+ * Carries the transactions of a TLM socket between two simulator processes
+ * (e.g., partitions of a large PL on separate cores) through a shared file
+ * mapped by both (e.g., /dev/shm/zynq7_link0). The initiator side has a
+ * target socket (e.g., behind an AXI to TLM bridge), the target side issues
+ * the transactions on its initiator socket (e.g., to a TLM to AXI bridge),
+ * see zynq7_shm_axi.h for the AXI pair.
+ *
+ * The time is synchronized conservatively : both processes advance in
+ * quanta and wait for each other on every boundary (the process ahead spins
+ * until the other one reaches it). A transaction crosses the link on the
+ * boundaries, the link adds up to a quantum of latency in each direction,
+ * a larger quantum means less synchronization but a higher latency. Both
+ * processes must have the same time resolution and quantum.
+ *
+ * The shared area is a ring of SLOTS transactions, as many can be in flight
+ * (e.g., the outstanding transactions of the AXI bridges), the others wait
+ * for a free slot. At most MAX_DATA bytes per transaction, no DMI nor debug
+ * transport. When one process ends its simulation, the other
+ * one stops (a peer that crashed is detected and forgotten on the next run).
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_SHM_LINK_H__
+#define __ZYNQ7_SHM_LINK_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <ostream>
+#include <string>
+
+// Synchronization and shared area, common to both sides
+class zynq7_shm_link : public sc_core::sc_module
+{
+public:
+    // Largest transaction (a 256 beat burst of 128 bits)
+    static const unsigned int MAX_DATA = 4096;
+    // Transactions in flight
+    static const unsigned int SLOTS = 16;
+
+    enum side {
+        INITIATOR,
+        TARGET
+    };
+
+    SC_HAS_PROCESS(zynq7_shm_link);
+
+    zynq7_shm_link(sc_core::sc_module_name name, const std::string &path, side s,
+                   const sc_core::sc_time &quantum);
+    ~zynq7_shm_link();
+
+    // Statistics
+    ///////////////
+    uint64_t transactions(void) const { return m_transactions; }
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    enum slot_state {
+        FREE,
+        REQUEST,
+        RESPONSE
+    };
+
+    // A transaction in flight, written by the initiator then by the target
+    struct slot {
+        uint32_t state;
+        uint32_t command;
+        uint64_t address;
+        uint32_t length;
+        uint32_t be_length;
+        uint32_t streaming_width;
+        int32_t response;
+        uint64_t time; // Request : issue time, response : completion time
+        unsigned char data[MAX_DATA];
+        unsigned char be[MAX_DATA];
+    };
+
+    // Mapped by both processes, each side only writes its own fields (and
+    // the slots it owns)
+    struct area {
+        uint64_t time[2];  // Last boundary reached
+        uint32_t pid[2];   // 0 until attached
+        uint32_t closed[2];
+        slot s[SLOTS];
+    };
+
+    // Called after each synchronization, with the slots possibly updated by the peer
+    virtual void poll(void) = 0;
+
+    slot_state state(unsigned int i) const;
+    void set_state(unsigned int i, slot_state s);
+
+    void end_of_simulation(void);
+
+    area *m_area;
+    uint64_t m_transactions;
+
+private:
+    void sync_thread(void);
+    // Spins until the peer reaches the time, false if it ended
+    bool wait_peer(uint64_t time);
+
+    std::string m_path;
+    side m_side;
+    side m_peer;
+    sc_core::sc_time m_quantum;
+    double m_wait_seconds;
+};
+
+// Receives the transactions of this process and forwards them to the peer
+class zynq7_shm_initiator : public zynq7_shm_link
+{
+public:
+    tlm_utils::simple_target_socket<zynq7_shm_initiator> tgt_socket;
+
+    zynq7_shm_initiator(sc_core::sc_module_name name, const std::string &path,
+                        const sc_core::sc_time &quantum);
+
+private:
+    void b_transport(tlm::tlm_generic_payload &trans, sc_core::sc_time &delay);
+    void poll(void);
+
+    sc_core::sc_event m_response_event[SLOTS];
+    sc_core::sc_event m_free_event;
+};
+
+// Issues the transactions of the peer in this process
+class zynq7_shm_target : public zynq7_shm_link
+{
+public:
+    tlm_utils::simple_initiator_socket<zynq7_shm_target> init_socket;
+
+    zynq7_shm_target(sc_core::sc_module_name name, const std::string &path,
+                     const sc_core::sc_time &quantum);
+
+private:
+    // One per slot, the transactions of the peer are issued concurrently
+    void serve_thread(unsigned int i);
+    void poll(void);
+
+    sc_core::sc_event m_request_event[SLOTS];
+    bool m_serving[SLOTS];
+};
+
+#endif /* __ZYNQ7_SHM_LINK_H__ */
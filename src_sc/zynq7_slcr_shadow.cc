@@ -0,0 +1,120 @@
+/*
+ * SLCR clock and reset shadow for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_slcr_shadow.h"
+
+#include <string.h>
+
+using namespace sc_core;
+using namespace std;
+
+zynq7_slcr_shadow::zynq7_slcr_shadow(sc_module_name name, zynq7_fclk_gen *fclk_gen,
+                                     double time_scale,
+                                     double io_pll_mhz,
+                                     double arm_pll_mhz,
+                                     double ddr_pll_mhz) :
+    sc_module(name),
+    socket("socket"),
+    fpga_rst("fpga_rst", zynq7_fclk_gen::NR_FCLKS),
+    m_fclk_gen(fclk_gen),
+    m_time_scale(time_scale),
+    // Resets are released (the FSBL already ran when the simulation starts)
+    m_rst_ctrl(0)
+{
+    // SRCSEL : 0x -> IO PLL, 10 -> ARM PLL, 11 -> DDR PLL
+    m_pll_mhz[0] = io_pll_mhz;
+    m_pll_mhz[1] = io_pll_mhz;
+    m_pll_mhz[2] = arm_pll_mhz;
+    m_pll_mhz[3] = ddr_pll_mhz;
+
+    for (int i = 0; i < zynq7_fclk_gen::NR_FCLKS; ++i) {
+        m_clk_ctrl[i] = 0x00101800; // Reset value
+    }
+
+    socket.register_b_transport(this, &zynq7_slcr_shadow::b_transport);
+}
+
+void zynq7_slcr_shadow::write_clk_ctrl(int n, uint32_t value)
+{
+    uint32_t srcsel = (value >> 4) & 0x3;
+    uint32_t div0 = (value >> 8) & 0x3f;
+    uint32_t div1 = (value >> 20) & 0x3f;
+
+    m_clk_ctrl[n] = value;
+
+    // A null divisor is not valid, consider it as 1
+    div0 = div0 ? div0 : 1;
+    div1 = div1 ? div1 : 1;
+
+    double period_ns = 1000.0 * div0 * div1 / m_pll_mhz[srcsel];
+    cout << name() << " : FCLK_CLK" << n << " set to " << 1000.0 / period_ns << " MHz" << endl;
+    m_fclk_gen->set_period(n, sc_time(period_ns * m_time_scale, SC_NS));
+}
+
+void zynq7_slcr_shadow::write_rst_ctrl(uint32_t value)
+{
+    m_rst_ctrl = value;
+    for (int i = 0; i < zynq7_fclk_gen::NR_FCLKS; ++i) {
+        fpga_rst[i].write((value >> i) & 1);
+    }
+}
+
+void zynq7_slcr_shadow::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    uint64_t addr = trans.get_address() & (SIZE - 1);
+    unsigned char *data = trans.get_data_ptr();
+    uint32_t value = 0;
+    uint32_t *reg = NULL;
+
+    if (trans.get_data_length() != sizeof(uint32_t) || (addr & 3)) {
+        trans.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+        return;
+    }
+
+    if ((addr >= FPGA0_CLK_CTRL) &&
+        (addr < FPGA0_CLK_CTRL + zynq7_fclk_gen::NR_FCLKS * FPGA_CLK_CTRL_STRIDE) &&
+        ((addr - FPGA0_CLK_CTRL) % FPGA_CLK_CTRL_STRIDE == 0)) {
+        reg = &m_clk_ctrl[(addr - FPGA0_CLK_CTRL) / FPGA_CLK_CTRL_STRIDE];
+    } else if (addr == FPGA_RST_CTRL) {
+        reg = &m_rst_ctrl;
+    }
+
+    if (trans.get_command() == tlm::TLM_READ_COMMAND) {
+        // Other registers read as zero
+        value = reg ? *reg : 0;
+        memcpy(data, &value, sizeof(value));
+    } else if (trans.get_command() == tlm::TLM_WRITE_COMMAND) {
+        // Other registers are ignored (they are handled by QEMU)
+        memcpy(&value, data, sizeof(value));
+        if (addr == FPGA_RST_CTRL) {
+            write_rst_ctrl(value);
+        } else if (reg) {
+            write_clk_ctrl((addr - FPGA0_CLK_CTRL) / FPGA_CLK_CTRL_STRIDE, value);
+        }
+    }
+
+    trans.set_response_status(tlm::TLM_OK_RESPONSE);
+}
@@ -0,0 +1,80 @@
+/*
+ * SLCR clock and reset shadow for Zynq Cosim
+ *
+ * The SLCR is modeled inside QEMU and its accesses are not visible from the
+ * simulation, the writes of an unmodified guest to FPGAn_CLK_CTRL do not
+ * reach it (FPGA_RST_CTRL does, QEMU forwards the PL resets on its wires).
+ * This device has the layout of the SLCR for the PL clock and reset
+ * registers (FPGAn_CLK_CTRL at 0x170 + n * 0x10 and FPGA_RST_CTRL at 0x240,
+ * offsets from the SLCR base) and is reached through a remote port memory
+ * master. It requires :
+ * - a QEMU hardware device tree that maps the window (remote port device)
+ * - a guest (firmware or clock driver) modified to write the same values to
+ *   this window as to the SLCR
+ * The FCLK periods and the FCLK_RESETn_N outputs of the simulation then
+ * follow the guest at run time.
+ *
+ * FCLKn = PLL / (DIVISOR0 * DIVISOR1), the PLL is selected by SRCSEL.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_SLCR_SHADOW_H__
+#define __ZYNQ7_SLCR_SHADOW_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_fclk_gen.h"
+
+class zynq7_slcr_shadow : public sc_core::sc_module
+{
+public:
+    static const uint32_t FPGA0_CLK_CTRL = 0x170;
+    static const uint32_t FPGA_CLK_CTRL_STRIDE = 0x10;
+    static const uint32_t FPGA_RST_CTRL = 0x240;
+    static const uint32_t SIZE = 0x1000;
+
+    tlm_utils::simple_target_socket<zynq7_slcr_shadow> socket;
+
+    // Resets of the PL (FPGA_RST_CTRL bits, active high)
+    sc_core::sc_vector<sc_core::sc_signal<bool> > fpga_rst;
+
+    // time_scale : HDL time = real time x time_scale
+    zynq7_slcr_shadow(sc_core::sc_module_name name, zynq7_fclk_gen *fclk_gen,
+                      double time_scale,
+                      double io_pll_mhz = 1000.0,
+                      double arm_pll_mhz = 1333.333,
+                      double ddr_pll_mhz = 1066.667);
+
+private:
+    void b_transport(tlm::tlm_generic_payload &trans, sc_core::sc_time &delay);
+    void write_clk_ctrl(int n, uint32_t value);
+    void write_rst_ctrl(uint32_t value);
+
+    zynq7_fclk_gen *m_fclk_gen;
+    double m_time_scale;
+    double m_pll_mhz[4]; // Indexed by SRCSEL
+
+    uint32_t m_clk_ctrl[zynq7_fclk_gen::NR_FCLKS];
+    uint32_t m_rst_ctrl;
+};
+
+#endif /* __ZYNQ7_SLCR_SHADOW_H__ */
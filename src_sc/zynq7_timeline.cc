@@ -0,0 +1,252 @@
+/*
+ * Timeline for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_timeline.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace sc_core;
+using namespace std;
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+zynq7_timeline::zynq7_timeline(sc_module_name name, const string &file) :
+    sc_module(name),
+    m_file(file),
+    m_os(file.c_str()),
+    m_first(true),
+    m_closed(false),
+    m_origin(wall_seconds()),
+    m_transactions(0),
+    m_irq_edges(0),
+    m_syncs(0),
+    m_sync_wait(0)
+{
+    if (!m_os) {
+        perror(m_file.c_str());
+        for(;;);
+    }
+    pthread_mutex_init(&m_lock, NULL);
+    for (int n = 0; n < 4; ++n) {
+        m_reset[n] = false;
+    }
+
+    // Timestamps in us, with a ns resolution
+    m_os << fixed << setprecision(3) << "[" << endl;
+    event(SIMULATED, 0, "process_name", "M", 0, -1, "\"name\":\"simulated time\"");
+    event(HOST, 0, "process_name", "M", 0, -1, "\"name\":\"host time\"");
+    thread_name(IRQ_THREAD, "IRQ_F2P");
+    thread_name(RESET_THREAD, "FCLK_RESET");
+    thread_name(QEMU_THREAD, "QEMU sync");
+    thread_name(MARKER_THREAD, "guest markers");
+}
+
+zynq7_timeline::~zynq7_timeline()
+{
+    pthread_mutex_destroy(&m_lock);
+}
+
+double zynq7_timeline::sim_us(const sc_time &t) const
+{
+    return t / sc_time(1, SC_US);
+}
+
+double zynq7_timeline::host_us(double wall) const
+{
+    return (wall - m_origin) * 1e6;
+}
+
+double zynq7_timeline::host_now_us(void) const
+{
+    return host_us(wall_seconds());
+}
+
+void zynq7_timeline::thread_name(int tid, const string &name)
+{
+    event(SIMULATED, tid, "thread_name", "M", 0, -1, "\"name\":\"" + name + "\"");
+    event(HOST, tid, "thread_name", "M", 0, -1, "\"name\":\"" + name + "\"");
+}
+
+void zynq7_timeline::event(process pid, int tid, const string &name, const char *ph,
+                           double ts, double dur, const string &args)
+{
+    if (m_closed) {
+        return;
+    }
+    m_os << (m_first ? "" : ",\n") << "{\"name\":\"" << name << "\",\"ph\":\"" << ph
+         << "\",\"pid\":" << pid << ",\"tid\":" << tid << ",\"ts\":" << ts;
+    if (dur >= 0) {
+        m_os << ",\"dur\":" << dur;
+    } else if (ph[0] == 'i') {
+        m_os << ",\"s\":\"t\"";
+    }
+    m_os << ",\"args\":{" << args << "}}";
+    m_first = false;
+}
+
+void zynq7_timeline::watch(zynq7_port_monitor *port)
+{
+    int tid = m_threads.size() + 1;
+    m_threads[port] = tid;
+    thread_name(tid, port->port_name());
+    port->add_observer(this);
+}
+
+void zynq7_timeline::transaction_begin(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                                       sc_time &delay)
+{
+    pending p = {sim_us(sc_time_stamp() + delay), host_now_us()};
+    m_pending[&trans] = p;
+}
+
+void zynq7_timeline::transaction_end(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                                     sc_time &delay)
+{
+    map<const tlm::tlm_generic_payload *, pending>::iterator it = m_pending.find(&trans);
+    if (it == m_pending.end()) {
+        return;
+    }
+    pending p = it->second;
+    m_pending.erase(it);
+    double sim_end = sim_us(sc_time_stamp() + delay);
+    double host_end = host_now_us();
+    int tid = m_threads[&port];
+    m_transactions++;
+
+    ostringstream args;
+    args << fixed << setprecision(3) << "\"address\":\"0x" << hex << trans.get_address() << dec
+         << "\",\"length\":" << trans.get_data_length()
+         << (trans.is_response_error() ? ",\"error\":true" : "");
+    string name = trans.is_read() ? "RD" : "WR";
+    ostringstream sim_args, host_args;
+    sim_args << fixed << setprecision(3) << args.str() << ",\"host_us\":" << p.host_us;
+    host_args << fixed << setprecision(3) << args.str() << ",\"sim_us\":" << p.sim_us;
+
+    pthread_mutex_lock(&m_lock);
+    event(SIMULATED, tid, name, "X", p.sim_us, sim_end - p.sim_us, sim_args.str());
+    event(HOST, tid, name, "X", p.host_us, host_end - p.host_us, host_args.str());
+    pthread_mutex_unlock(&m_lock);
+}
+
+void zynq7_timeline::irq(int n, bool level)
+{
+    double sim = sim_us(sc_time_stamp());
+    double host = host_now_us();
+    ostringstream name, sim_args, host_args;
+    name << "IRQ_F2P[" << n << "] " << (level ? "rise" : "fall");
+    sim_args << fixed << setprecision(3) << "\"host_us\":" << host;
+    host_args << fixed << setprecision(3) << "\"sim_us\":" << sim;
+    m_irq_edges++;
+
+    pthread_mutex_lock(&m_lock);
+    event(SIMULATED, IRQ_THREAD, name.str(), "i", sim, -1, sim_args.str());
+    event(HOST, IRQ_THREAD, name.str(), "i", host, -1, host_args.str());
+    pthread_mutex_unlock(&m_lock);
+}
+
+void zynq7_timeline::marker(uint32_t value)
+{
+    double sim = sim_us(sc_time_stamp());
+    double host = host_now_us();
+    ostringstream name, sim_args, host_args;
+    name << "guest marker 0x" << hex << value;
+    sim_args << fixed << setprecision(3) << "\"host_us\":" << host;
+    host_args << fixed << setprecision(3) << "\"sim_us\":" << sim;
+
+    pthread_mutex_lock(&m_lock);
+    event(SIMULATED, MARKER_THREAD, name.str(), "i", sim, -1, sim_args.str());
+    event(HOST, MARKER_THREAD, name.str(), "i", host, -1, host_args.str());
+    pthread_mutex_unlock(&m_lock);
+}
+
+// A reset is a span from its assertion to its release
+void zynq7_timeline::reset(int n, bool asserted)
+{
+    if (m_reset[n] == asserted) {
+        return;
+    }
+    m_reset[n] = asserted;
+
+    double sim = sim_us(sc_time_stamp());
+    double host = host_now_us();
+    ostringstream name, sim_args, host_args;
+    name << "FCLK_RESET" << n;
+    sim_args << fixed << setprecision(3) << "\"host_us\":" << host;
+    host_args << fixed << setprecision(3) << "\"sim_us\":" << sim;
+    const char *ph = asserted ? "B" : "E";
+
+    pthread_mutex_lock(&m_lock);
+    event(SIMULATED, RESET_THREAD, name.str(), ph, sim, -1, sim_args.str());
+    event(HOST, RESET_THREAD, name.str(), ph, host, -1, host_args.str());
+    pthread_mutex_unlock(&m_lock);
+}
+
+// The model is blocked from its answer to the sync until QEMU ran its next
+// quantum, it takes no simulated time
+void zynq7_timeline::qemu_sync(uint64_t time_ns, double wall_start, double wall_end)
+{
+    double sim = time_ns / 1e3;
+    double host = host_us(wall_start);
+    double wait = (wall_end - wall_start) * 1e6;
+    ostringstream sim_args, host_args;
+    sim_args << fixed << setprecision(3) << "\"host_us\":" << host << ",\"wait_us\":" << wait;
+    host_args << fixed << setprecision(3) << "\"sim_us\":" << sim;
+
+    pthread_mutex_lock(&m_lock);
+    m_syncs++;
+    m_sync_wait += wall_end - wall_start;
+    event(SIMULATED, QEMU_THREAD, "sync", "i", sim, -1, sim_args.str());
+    event(HOST, QEMU_THREAD, "sync", "X", host, wait, host_args.str());
+    pthread_mutex_unlock(&m_lock);
+}
+
+void zynq7_timeline::print_summary(ostream &os) const
+{
+    os << name() << " : " << m_transactions << " transactions, " << m_irq_edges
+       << " IRQ edges, " << m_syncs << " QEMU syncs (waited " << m_sync_wait
+       << " s) written to " << m_file << endl;
+}
+
+// The link may still report syncs, they are dropped
+void zynq7_timeline::end_of_simulation(void)
+{
+    pthread_mutex_lock(&m_lock);
+    m_os << "\n]" << endl;
+    m_os.close();
+    m_closed = true;
+    pthread_mutex_unlock(&m_lock);
+    print_summary(cout);
+}
@@ -0,0 +1,134 @@
+/*
+ * Timeline for Zynq Cosim
+ *
+ * Writes the activity of the simulation to a file in the Chrome trace event
+ * format (JSON), to be opened in chrome://tracing or ui.perfetto.dev :
+ * - the transactions of the observed ports (PS accesses on the M_AXI_GP
+ *   ports, PL masters on the S_AXI ports), with their address and length
+ * - the edges of the IRQ_F2P bits
+ * - the FCLK_RESETn resets of the PL
+ * - the markers written by the guest (see zynq7_addr_decoder.h)
+ * - the syncs with QEMU and how long the simulator waited for them (through
+ *   the remote port link, see zynq7_rp_link.h)
+ * Every event appears twice : in a "simulated time" process on the time of
+ * the simulation and in a "host time" process on the wall-clock time since
+ * the start, each one carries the other timestamp in its arguments. The
+ * time spent in both can then be compared on the same file.
+ *
+ * The events are written as they come, a file cut short by a simulator that
+ * did not end its simulation lacks the closing bracket, which the viewers
+ * accept.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_TIMELINE_H__
+#define __ZYNQ7_TIMELINE_H__
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_port_monitor.h"
+#include "zynq7_rp_link.h"
+
+#include <pthread.h>
+
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <string>
+
+class zynq7_timeline : public sc_core::sc_module, public zynq7_port_observer,
+                       public zynq7_rp_sync_observer
+{
+public:
+    zynq7_timeline(sc_core::sc_module_name name, const std::string &file);
+    ~zynq7_timeline();
+
+    // Observe the transactions of a port
+    void watch(zynq7_port_monitor *port);
+
+    // Edge of an IRQ_F2P bit
+    void irq(int n, bool level);
+    // Value of FCLK_RESETn (the changes are recorded)
+    void reset(int n, bool asserted);
+    // Marker written by the guest
+    void marker(uint32_t value);
+
+    // zynq7_port_observer
+    void transaction_begin(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                           sc_core::sc_time &delay);
+    void transaction_end(zynq7_port_monitor &port, tlm::tlm_generic_payload &trans,
+                         sc_core::sc_time &delay);
+
+    // zynq7_rp_sync_observer (thread of the link)
+    void qemu_sync(uint64_t time_ns, double wall_start, double wall_end);
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    enum process {
+        SIMULATED = 1,
+        HOST
+    };
+    // Threads other than the ports (numbered from 1)
+    enum thread {
+        IRQ_THREAD = 100,
+        RESET_THREAD,
+        QEMU_THREAD,
+        MARKER_THREAD
+    };
+
+    struct pending {
+        double sim_us;
+        double host_us;
+    };
+
+    double sim_us(const sc_core::sc_time &t) const;
+    double host_us(double wall) const;
+    double host_now_us(void) const;
+    // Names a thread in both processes
+    void thread_name(int tid, const std::string &name);
+    // One event of a process, the caller holds the lock. dur < 0 : instant
+    // event, args is the content of the arguments object
+    void event(process pid, int tid, const std::string &name, const char *ph,
+               double ts, double dur, const std::string &args);
+
+    std::string m_file;
+    std::ofstream m_os;
+    bool m_first;
+    bool m_closed;
+    double m_origin;
+    pthread_mutex_t m_lock;
+
+    std::map<const zynq7_port_monitor *, int> m_threads;
+    std::map<const tlm::tlm_generic_payload *, pending> m_pending;
+    bool m_reset[4];
+
+    uint64_t m_transactions;
+    uint64_t m_irq_edges;
+    uint64_t m_syncs;
+    double m_sync_wait;
+};
+
+#endif /* __ZYNQ7_TIMELINE_H__ */
@@ -0,0 +1,258 @@
+/*
+ * Traffic generator for Zynq Cosim
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "zynq7_ps_pch.h"
+#include "zynq7_traffic_gen.h"
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace sc_core;
+using namespace std;
+
+zynq7_traffic_gen::config::config() :
+    addr_pattern(SEQUENTIAL),
+    addr(0),
+    size(0x100000),
+    stride(0),
+    burst_bytes(64),
+    outstanding(1),
+    rate_mbps(0),
+    write_percent(50),
+    count(0),
+    start(SC_ZERO_TIME),
+    seed(1)
+{
+}
+
+bool zynq7_traffic_gen::parse(const string &descr, config &cfg, string &error)
+{
+    istringstream iss(descr);
+    string item;
+
+    while (getline(iss, item, ',')) {
+        size_t pos = item.find('=');
+        if (pos == string::npos) {
+            error = "missing value for " + item;
+            return false;
+        }
+        string key = item.substr(0, pos);
+        string value = item.substr(pos + 1);
+        char *end;
+        uint64_t number = strtoull(value.c_str(), &end, 0);
+        bool is_number = !value.empty() && (*end == '\0');
+
+        if (key == "pattern") {
+            if (value == "seq") {
+                cfg.addr_pattern = SEQUENTIAL;
+            } else if (value == "stride") {
+                cfg.addr_pattern = STRIDED;
+            } else if (value == "random") {
+                cfg.addr_pattern = RANDOM;
+            } else {
+                error = "unknown pattern " + value;
+                return false;
+            }
+            continue;
+        }
+        if (!is_number) {
+            error = "invalid value for " + key;
+            return false;
+        }
+        if (key == "addr") {
+            cfg.addr = number;
+        } else if (key == "size") {
+            cfg.size = number;
+        } else if (key == "stride") {
+            cfg.stride = number;
+        } else if (key == "burst") {
+            cfg.burst_bytes = number;
+        } else if (key == "outstanding") {
+            cfg.outstanding = number;
+        } else if (key == "rate") {
+            cfg.rate_mbps = number;
+        } else if (key == "write") {
+            cfg.write_percent = number;
+        } else if (key == "count") {
+            cfg.count = number;
+        } else if (key == "start") {
+            cfg.start = sc_time((double) number, SC_NS);
+        } else if (key == "seed") {
+            cfg.seed = number;
+        } else {
+            error = "unknown key " + key;
+            return false;
+        }
+    }
+
+    if (cfg.stride == 0) {
+        cfg.stride = cfg.burst_bytes;
+    }
+    if ((cfg.burst_bytes == 0) || (cfg.outstanding == 0) || (cfg.size < cfg.burst_bytes) ||
+        (cfg.write_percent > 100)) {
+        error = "invalid burst, outstanding, size or write percentage";
+        return false;
+    }
+    return true;
+}
+
+zynq7_traffic_gen::zynq7_traffic_gen(sc_module_name name, const string &port_name,
+                                     const config &cfg) :
+    sc_module(name),
+    socket("socket"),
+    m_port_name(port_name),
+    m_cfg(cfg),
+    m_interval(SC_ZERO_TIME),
+    m_next_issue(SC_ZERO_TIME),
+    m_issued(0),
+    m_random(cfg.seed ? cfg.seed : 1),
+    m_transactions(0),
+    m_bytes(0),
+    m_errors(0),
+    m_has_issued(false),
+    m_first_issue(SC_ZERO_TIME),
+    m_last_end(SC_ZERO_TIME),
+    m_min_latency(SC_ZERO_TIME),
+    m_max_latency(SC_ZERO_TIME),
+    m_total_latency(SC_ZERO_TIME)
+{
+    // MB/s to time between two transactions
+    if (m_cfg.rate_mbps > 0) {
+        m_interval = sc_time(m_cfg.burst_bytes / m_cfg.rate_mbps, SC_US);
+    }
+
+    for (unsigned int i = 0; i < m_cfg.outstanding; ++i) {
+        sc_spawn(sc_bind(&zynq7_traffic_gen::worker, this));
+    }
+}
+
+// xorshift32, reproducible for a given seed
+uint32_t zynq7_traffic_gen::next_random(void)
+{
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    return m_random;
+}
+
+uint64_t zynq7_traffic_gen::next_address(void)
+{
+    uint64_t slots = m_cfg.size / m_cfg.burst_bytes;
+
+    switch (m_cfg.addr_pattern) {
+    case RANDOM:
+        return m_cfg.addr + (next_random() % slots) * m_cfg.burst_bytes;
+    case STRIDED:
+        return m_cfg.addr + (m_issued * m_cfg.stride) % (slots * m_cfg.burst_bytes);
+    case SEQUENTIAL:
+    default:
+        return m_cfg.addr + (m_issued % slots) * m_cfg.burst_bytes;
+    }
+}
+
+void zynq7_traffic_gen::worker(void)
+{
+    tlm::tlm_generic_payload trans;
+    vector<unsigned char> data(m_cfg.burst_bytes);
+
+    if (m_cfg.start > SC_ZERO_TIME) {
+        wait(m_cfg.start);
+    }
+
+    while ((m_cfg.count == 0) || (m_issued < m_cfg.count)) {
+        // Issue slot (rate limit), shared by the workers
+        sc_time now = sc_time_stamp();
+        sc_time slot = (m_next_issue > now) ? m_next_issue : now;
+        m_next_issue = slot + m_interval;
+
+        uint64_t addr = next_address();
+        bool write = (next_random() % 100) < m_cfg.write_percent;
+        m_issued++;
+        if (slot > now) {
+            wait(slot - now);
+        }
+
+        sc_time delay = SC_ZERO_TIME;
+        sc_time issue = sc_time_stamp();
+        if (!m_has_issued) {
+            m_first_issue = issue;
+            m_has_issued = true;
+        }
+
+        trans.set_command(write ? tlm::TLM_WRITE_COMMAND : tlm::TLM_READ_COMMAND);
+        trans.set_address(addr);
+        trans.set_data_ptr(&data[0]);
+        trans.set_data_length(m_cfg.burst_bytes);
+        trans.set_streaming_width(m_cfg.burst_bytes);
+        trans.set_byte_enable_ptr(NULL);
+        trans.set_dmi_allowed(false);
+        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+
+        socket->b_transport(trans, delay);
+        wait(delay);
+
+        sc_time latency = sc_time_stamp() - issue;
+        if ((m_transactions == 0) || (latency < m_min_latency)) {
+            m_min_latency = latency;
+        }
+        if (latency > m_max_latency) {
+            m_max_latency = latency;
+        }
+        m_total_latency += latency;
+        m_last_end = sc_time_stamp();
+        m_transactions++;
+        m_bytes += m_cfg.burst_bytes;
+        if (trans.is_response_error()) {
+            m_errors++;
+        }
+    }
+}
+
+double zynq7_traffic_gen::bandwidth(void) const
+{
+    double seconds = (m_last_end - m_first_issue).to_seconds();
+    return (seconds > 0) ? m_bytes / seconds : 0;
+}
+
+sc_time zynq7_traffic_gen::avg_latency(void) const
+{
+    return m_transactions ? m_total_latency / (double) m_transactions : SC_ZERO_TIME;
+}
+
+void zynq7_traffic_gen::print_summary(ostream &os) const
+{
+    os << m_port_name << " traffic generator : "
+       << m_transactions << " transactions (" << m_bytes << " bytes), "
+       << m_errors << " errors, " << bandwidth() / 1e6 << " MB/s, latency min "
+       << m_min_latency << " avg " << avg_latency() << " max " << m_max_latency << endl;
+}
+
+void zynq7_traffic_gen::end_of_simulation(void)
+{
+    print_summary(cout);
+}
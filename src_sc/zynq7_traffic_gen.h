@@ -0,0 +1,129 @@
+/*
+ * Traffic generator for Zynq Cosim
+ *
+ * Synthetic AXI master attached in place of a PL master on an S_AXI port
+ * (e.g., S_AXI_HP0). It issues bursts following a sequential, strided or
+ * random address pattern, with a number of transactions in flight and an
+ * optional rate limit, and reports the achieved bandwidth and latency. It
+ * stresses the PS memory path and the remote port link without any RTL.
+ *
+ * The generator is configured by a string, a comma separated list of
+ * key=value (all optional) :
+ *   pattern=seq|stride|random   address pattern (seq)
+ *   addr=A,size=S               window of the accesses (0x0, 0x100000)
+ *   stride=N                    bytes between two accesses (stride pattern)
+ *   burst=N                     bytes per transaction (64)
+ *   outstanding=N               transactions in flight (1)
+ *   rate=N                      MB/s, 0 means as fast as possible (0)
+ *   write=N                     percentage of writes (50)
+ *   count=N                     number of transactions, 0 means endless (0)
+ *   start=N                     start time in ns (0)
+ *   seed=N                      seed of the random pattern (1)
+ * e.g., "pattern=random,burst=128,outstanding=4,rate=400"
+ * The start time and the rate are converted to the simulation time base by
+ * zynq7_ps (TIME_SCALE_G), the bandwidth and latencies reported are the ones
+ * of the simulation.
+ *
+ * Copyright (c) 2020 REDS
+ * Written by Rick Wertenbroek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ZYNQ7_TRAFFIC_GEN_H__
+#define __ZYNQ7_TRAFFIC_GEN_H__
+
+#include "zynq7_ps_pch.h"
+
+#include <string>
+
+class zynq7_traffic_gen : public sc_core::sc_module
+{
+public:
+    enum pattern {
+        SEQUENTIAL,
+        STRIDED,
+        RANDOM
+    };
+
+    struct config {
+        pattern addr_pattern;
+        uint64_t addr;
+        uint64_t size;
+        uint64_t stride;
+        unsigned int burst_bytes;
+        unsigned int outstanding;
+        double rate_mbps;
+        unsigned int write_percent;
+        uint64_t count;
+        sc_core::sc_time start;
+        uint32_t seed;
+
+        config();
+    };
+
+    // Parses a configuration string (see above), returns false and sets
+    // error if it is malformed
+    static bool parse(const std::string &descr, config &cfg, std::string &error);
+
+    tlm_utils::simple_initiator_socket<zynq7_traffic_gen> socket;
+
+    zynq7_traffic_gen(sc_core::sc_module_name name, const std::string &port_name,
+                      const config &cfg);
+
+    // Statistics
+    ///////////////
+    uint64_t transactions(void) const { return m_transactions; }
+    uint64_t bytes(void) const { return m_bytes; }
+    uint64_t errors(void) const { return m_errors; }
+    // Bytes per second of simulated time, from the first issue to the last completion
+    double bandwidth(void) const;
+    const sc_core::sc_time &min_latency(void) const { return m_min_latency; }
+    const sc_core::sc_time &max_latency(void) const { return m_max_latency; }
+    sc_core::sc_time avg_latency(void) const;
+
+    void print_summary(std::ostream &os) const;
+
+protected:
+    void end_of_simulation(void);
+
+private:
+    void worker(void);
+    uint64_t next_address(void);
+    uint32_t next_random(void);
+
+    std::string m_port_name;
+    config m_cfg;
+    sc_core::sc_time m_interval; // Between two issues (rate limit)
+    sc_core::sc_time m_next_issue;
+    uint64_t m_issued;
+    uint32_t m_random;
+
+    uint64_t m_transactions;
+    uint64_t m_bytes;
+    uint64_t m_errors;
+    bool m_has_issued;
+    sc_core::sc_time m_first_issue;
+    sc_core::sc_time m_last_end;
+    sc_core::sc_time m_min_latency;
+    sc_core::sc_time m_max_latency;
+    sc_core::sc_time m_total_latency;
+};
+
+#endif /* __ZYNQ7_TRAFFIC_GEN_H__ */
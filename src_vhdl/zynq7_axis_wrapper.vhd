@@ -0,0 +1,131 @@
+-------------------------------------------------------------------------------
+--
+-- Copyright (c) 2020 REDS, Rick Wertenbroek <rick.wertenbroek@heig-vd.ch>
+-- All rights reserved.
+--
+-- Redistribution and use in source and binary forms, with or without
+-- modification, are permitted provided that the following conditions are met:
+--
+-- 1. Redistributions of source code must retain the above copyright notice,
+-- this list of conditions and the following disclaimer.
+--
+-- 2. Redistributions in binary form must reproduce the above copyright notice,
+-- this list of conditions and the following disclaimer in the documentation
+-- and/or other materials provided with the distribution.
+--
+-- 3. Neither the name of the copyright holder nor the names of its
+-- contributors may be used to endorse or promote products derived from this
+-- software without specific prior written permission.
+--
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+-- POSSIBILITY OF SUCH DAMAGE.
+--
+-- File         : zynq7_axis_wrapper.vhd
+-- Description  : Wrappers for the AXI-Stream source and sink (SystemC
+--                entities, see src_sc/zynq7_axis.h), they feed and drain the
+--                AXI-Stream interfaces of the PL from host files.
+--
+-- Author       : Rick Wertenbroek
+-- Date         : 16.04.20
+-- Version      : 0.0
+--
+-- VHDL std     : 2008
+-- Dependencies :
+-------------------------------------------------------------------------------
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+entity zynq7_axis_source_wrapper is
+    generic(
+        FILE_G            : string  := "";
+        PACKET_IN_BEATS_G : integer := 0;
+        --
+        -- If this generic changes value, __AXIS_TDATA_WIDTH__ must be given
+        -- accordingly to the compilation of the SystemC files
+        --
+        TDATA_WIDTH_G     : integer := 64
+        );
+    port(
+        aclk          : in  std_logic;
+        aresetn       : in  std_logic;
+        m_axis_tvalid : out std_logic;
+        m_axis_tready : in  std_logic := '1';
+        m_axis_tdata  : out std_logic_vector(TDATA_WIDTH_G-1 downto 0);
+        m_axis_tkeep  : out std_logic_vector(TDATA_WIDTH_G/8-1 downto 0);
+        m_axis_tlast  : out std_logic
+        );
+end entity zynq7_axis_source_wrapper;
+
+architecture struct of zynq7_axis_source_wrapper is
+
+begin
+
+    -- This entity is a SystemC entity
+    zynq7_axis_source_inst : entity work.zynq7_axis_source
+        generic map (
+            FILE_G            => FILE_G,
+            PACKET_IN_BEATS_G => PACKET_IN_BEATS_G)
+        port map (
+            aclk          => aclk,
+            aresetn       => aresetn,
+            m_axis_tvalid => m_axis_tvalid,
+            m_axis_tready => m_axis_tready,
+            m_axis_tdata  => m_axis_tdata,
+            m_axis_tkeep  => m_axis_tkeep,
+            m_axis_tlast  => m_axis_tlast);
+
+end architecture struct;
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+entity zynq7_axis_sink_wrapper is
+    generic(
+        FILE_G            : string  := "";
+        --
+        -- If this generic changes value, __AXIS_TDATA_WIDTH__ must be given
+        -- accordingly to the compilation of the SystemC files
+        --
+        TDATA_WIDTH_G     : integer := 64
+        );
+    port(
+        aclk          : in  std_logic;
+        aresetn       : in  std_logic;
+        s_axis_tvalid : in  std_logic;
+        s_axis_tready : out std_logic;
+        s_axis_tdata  : in  std_logic_vector(TDATA_WIDTH_G-1 downto 0);
+        s_axis_tkeep  : in  std_logic_vector(TDATA_WIDTH_G/8-1 downto 0) := (others => '1');
+        s_axis_tlast  : in  std_logic := '0'
+        );
+end entity zynq7_axis_sink_wrapper;
+
+architecture struct of zynq7_axis_sink_wrapper is
+
+begin
+
+    -- This entity is a SystemC entity
+    zynq7_axis_sink_inst : entity work.zynq7_axis_sink
+        generic map (
+            FILE_G => FILE_G)
+        port map (
+            aclk          => aclk,
+            aresetn       => aresetn,
+            s_axis_tvalid => s_axis_tvalid,
+            s_axis_tready => s_axis_tready,
+            s_axis_tdata  => s_axis_tdata,
+            s_axis_tkeep  => s_axis_tkeep,
+            s_axis_tlast  => s_axis_tlast);
+
+end architecture struct;
@@ -51,10 +51,42 @@ entity zynq7_ps_wrapper is
     generic(
         QEMU_PATH_TO_SOCKET_G    : string  := "unix:/opt/pkg/projects/zynq_project/qemu-tmp/qemu-rport-_cosim@0";
         QEMU_SYNC_QUANTUM_G      : integer := 10000;
+        QEMU_CONNECT_TIMEOUT_IN_MS_G : integer := 0;
+        QEMU_COMMAND_G           : string  := "";
+        QEMU_LINK_BATCH_IN_BYTES_G : integer := 0;
+        TIME_SCALE_G             : integer := 1;
+        FAST_FORWARD_G           : integer := 0;
+        FAST_FORWARD_BUDGET_IN_NS_G : integer := 10000000;
+        FAST_FORWARD_IDLE_QUANTA_G : integer := 10;
         FCLK_CLK0_PERIOD_IN_NS_G : integer := 10000;
         FCLK_CLK1_PERIOD_IN_NS_G : integer := -1;
         FCLK_CLK2_PERIOD_IN_NS_G : integer := -1;
         FCLK_CLK3_PERIOD_IN_NS_G : integer := -1;
+        SLCR_SHADOW_DEV_ID_G     : integer := -1;
+        AXI_PORT_TRACE_G         : integer := 0;
+        TIMELINE_FILE_G          : string  := "";
+        AXI_CHECKER_G            : integer := 0;
+        AXI_WATCHDOG_IN_CYCLES_G : integer := 1000000;
+        AXI_CAPTURE_DEPTH_G      : integer := 0;
+        AXI_CAPTURE_FILE_G       : string  := "axi_capture";
+        AXI_CAPTURE_TRIGGER_ADDRESS_G : string  := "";
+        AXI_CAPTURE_TRIGGER_IRQ_G : integer := 0;
+        AXI_BRIDGE_IDLE_CYCLES_G : integer := 0;
+        S_AXI_HP0_TRAFFIC_G      : string  := "";
+        S_AXI_HP1_TRAFFIC_G      : string  := "";
+        S_AXI_HP2_TRAFFIC_G      : string  := "";
+        S_AXI_HP3_TRAFFIC_G      : string  := "";
+        DDR_MODEL_G              : integer := 0;
+        DDR_BANDWIDTH_IN_MBPS_G  : integer := 4264;
+        DDR_LATENCY_IN_NS_G      : integer := 80;
+        DDR_GP_LATENCY_IN_NS_G   : integer := 40;
+        M_AXI_GP0_READ_CACHE_G   : string  := "";
+        M_AXI_GP1_READ_CACHE_G   : string  := "";
+        READ_CACHE_LIFETIME_IN_CYCLES_G : integer := 0;
+        M_AXI_GP0_ADDR_MAP_G     : string  := "";
+        M_AXI_GP1_ADDR_MAP_G     : string  := "";
+        M_AXI_GP0_LITE_G         : integer := 0;
+        M_AXI_GP1_LITE_G         : integer := 0;
         M_AXI_GP0_ENABLE_G       : integer := 0;
         M_AXI_GP1_ENABLE_G       : integer := 0;
         S_AXI_GP0_ENABLE_G       : integer := 0;
@@ -63,6 +95,7 @@ entity zynq7_ps_wrapper is
         S_AXI_HP1_ENABLE_G       : integer := 0;
         S_AXI_HP2_ENABLE_G       : integer := 0;
         S_AXI_HP3_ENABLE_G       : integer := 0;
+        S_AXI_ACP_ENABLE_G       : integer := 0;
         --
         -- If the generics below change values, the constants in zynq_ps.h must
         -- be changed accordingly (because SystemC (C++) templates cannot take
@@ -114,7 +147,13 @@ entity zynq7_ps_wrapper is
         S_AXI_HP3_DATA_WIDTH_G   : integer := 64;
         S_AXI_HP3_ID_WIDTH_G     : integer := 6;
         S_AXI_HP3_AXLEN_WIDTH_G  : integer := 4;
-        S_AXI_HP3_AXLOCK_WIDTH_G : integer := 2
+        S_AXI_HP3_AXLOCK_WIDTH_G : integer := 2;
+        --
+        S_AXI_ACP_ADDR_WIDTH_G   : integer := 32;
+        S_AXI_ACP_DATA_WIDTH_G   : integer := 64;
+        S_AXI_ACP_ID_WIDTH_G     : integer := 3;
+        S_AXI_ACP_AXLEN_WIDTH_G  : integer := 4;
+        S_AXI_ACP_AXLOCK_WIDTH_G : integer := 2
         );
 
     port(
@@ -451,10 +490,56 @@ entity zynq7_ps_wrapper is
         s_axi_hp3_rresp   : out std_logic_vector(1 downto 0);
         s_axi_hp3_rid     : out std_logic_vector(S_AXI_HP3_ID_WIDTH_G-1 downto 0);
         s_axi_hp3_rlast   : out std_logic;
+        -- S AXI ACP
+        s_axi_acp_aclk    : in  std_logic := '0';
+        s_axi_acp_aresetn : in  std_logic := '0';
+        s_axi_acp_awvalid : in  std_logic := '0';
+        s_axi_acp_awready : out std_logic;
+        s_axi_acp_awaddr  : in  std_logic_vector(S_AXI_ACP_ADDR_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_acp_awprot  : in  std_logic_vector(2 downto 0) := (others => '0');
+        s_axi_acp_awqos   : in  std_logic_vector(3 downto 0) := (others => '0');
+        s_axi_acp_awcache : in  std_logic_vector(3 downto 0) := (others => '0');
+        s_axi_acp_awburst : in  std_logic_vector(1 downto 0) := (others => '0');
+        s_axi_acp_awsize  : in  std_logic_vector(2 downto 0) := (others => '0');
+        s_axi_acp_awlen   : in  std_logic_vector(S_AXI_ACP_AXLEN_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_acp_awid    : in  std_logic_vector(S_AXI_ACP_ID_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_acp_awlock  : in  std_logic_vector(S_AXI_ACP_AXLOCK_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_acp_wid     : in  std_logic_vector(S_AXI_ACP_ID_WIDTH_G-1 downto 0) := (others => '0');  -- Unconnected and unused
+        s_axi_acp_wvalid  : in  std_logic := '0';
+        s_axi_acp_wready  : out std_logic;
+        s_axi_acp_wdata   : in  std_logic_vector(S_AXI_ACP_DATA_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_acp_wstrb   : in  std_logic_vector(S_AXI_ACP_DATA_WIDTH_G/8-1 downto 0) := (others => '0');
+        s_axi_acp_wlast   : in  std_logic := '0';
+        s_axi_acp_bvalid  : out std_logic;
+        s_axi_acp_bready  : in  std_logic := '0';
+        s_axi_acp_bresp   : out std_logic_vector(1 downto 0);
+        s_axi_acp_bid     : out std_logic_vector(S_AXI_ACP_ID_WIDTH_G-1 downto 0);
+        s_axi_acp_arvalid : in  std_logic := '0';
+        s_axi_acp_arready : out std_logic;
+        s_axi_acp_araddr  : in  std_logic_vector(S_AXI_ACP_ADDR_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_acp_arprot  : in  std_logic_vector(2 downto 0) := (others => '0');
+        s_axi_acp_arqos   : in  std_logic_vector(3 downto 0) := (others => '0');
+        s_axi_acp_arcache : in  std_logic_vector(3 downto 0) := (others => '0');
+        s_axi_acp_arburst : in  std_logic_vector(1 downto 0) := (others => '0');
+        s_axi_acp_arsize  : in  std_logic_vector(2 downto 0) := (others => '0');
+        s_axi_acp_arlen   : in  std_logic_vector(S_AXI_ACP_AXLEN_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_acp_arid    : in  std_logic_vector(S_AXI_ACP_ID_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_acp_arlock  : in  std_logic_vector(S_AXI_ACP_AXLOCK_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_acp_rvalid  : out std_logic;
+        s_axi_acp_rready  : in  std_logic := '0';
+        s_axi_acp_rdata   : out std_logic_vector(S_AXI_ACP_DATA_WIDTH_G-1 downto 0);
+        s_axi_acp_rresp   : out std_logic_vector(1 downto 0);
+        s_axi_acp_rid     : out std_logic_vector(S_AXI_ACP_ID_WIDTH_G-1 downto 0);
+        s_axi_acp_rlast   : out std_logic;
         -- IRQs
         irq_f2p           : in  std_logic_vector(15 downto 0) := (others => '0');
         -- Reset
-        rst_o             : out std_logic
+        rst_o             : out std_logic;
+        -- PL resets (FPGA_RST_CTRL)
+        fclk_reset0_n     : out std_logic;
+        fclk_reset1_n     : out std_logic;
+        fclk_reset2_n     : out std_logic;
+        fclk_reset3_n     : out std_logic
         );
 end entity zynq7_ps_wrapper;
 
@@ -467,10 +552,42 @@ begin
         generic map (
             QEMU_PATH_TO_SOCKET_G    => QEMU_PATH_TO_SOCKET_G,
             QEMU_SYNC_QUANTUM_G      => QEMU_SYNC_QUANTUM_G,
+            QEMU_CONNECT_TIMEOUT_IN_MS_G => QEMU_CONNECT_TIMEOUT_IN_MS_G,
+            QEMU_COMMAND_G           => QEMU_COMMAND_G,
+            QEMU_LINK_BATCH_IN_BYTES_G => QEMU_LINK_BATCH_IN_BYTES_G,
+            TIME_SCALE_G             => TIME_SCALE_G,
+            FAST_FORWARD_G           => FAST_FORWARD_G,
+            FAST_FORWARD_BUDGET_IN_NS_G => FAST_FORWARD_BUDGET_IN_NS_G,
+            FAST_FORWARD_IDLE_QUANTA_G => FAST_FORWARD_IDLE_QUANTA_G,
             FCLK_CLK0_PERIOD_IN_NS_G => FCLK_CLK0_PERIOD_IN_NS_G,
             FCLK_CLK1_PERIOD_IN_NS_G => FCLK_CLK1_PERIOD_IN_NS_G,
             FCLK_CLK2_PERIOD_IN_NS_G => FCLK_CLK2_PERIOD_IN_NS_G,
             FCLK_CLK3_PERIOD_IN_NS_G => FCLK_CLK3_PERIOD_IN_NS_G,
+            SLCR_SHADOW_DEV_ID_G     => SLCR_SHADOW_DEV_ID_G,
+            AXI_PORT_TRACE_G         => AXI_PORT_TRACE_G,
+            TIMELINE_FILE_G          => TIMELINE_FILE_G,
+            AXI_CHECKER_G            => AXI_CHECKER_G,
+            AXI_WATCHDOG_IN_CYCLES_G => AXI_WATCHDOG_IN_CYCLES_G,
+            AXI_CAPTURE_DEPTH_G      => AXI_CAPTURE_DEPTH_G,
+            AXI_CAPTURE_FILE_G       => AXI_CAPTURE_FILE_G,
+            AXI_CAPTURE_TRIGGER_ADDRESS_G => AXI_CAPTURE_TRIGGER_ADDRESS_G,
+            AXI_CAPTURE_TRIGGER_IRQ_G => AXI_CAPTURE_TRIGGER_IRQ_G,
+            AXI_BRIDGE_IDLE_CYCLES_G => AXI_BRIDGE_IDLE_CYCLES_G,
+            S_AXI_HP0_TRAFFIC_G      => S_AXI_HP0_TRAFFIC_G,
+            S_AXI_HP1_TRAFFIC_G      => S_AXI_HP1_TRAFFIC_G,
+            S_AXI_HP2_TRAFFIC_G      => S_AXI_HP2_TRAFFIC_G,
+            S_AXI_HP3_TRAFFIC_G      => S_AXI_HP3_TRAFFIC_G,
+            DDR_MODEL_G              => DDR_MODEL_G,
+            DDR_BANDWIDTH_IN_MBPS_G  => DDR_BANDWIDTH_IN_MBPS_G,
+            DDR_LATENCY_IN_NS_G      => DDR_LATENCY_IN_NS_G,
+            DDR_GP_LATENCY_IN_NS_G   => DDR_GP_LATENCY_IN_NS_G,
+            M_AXI_GP0_READ_CACHE_G   => M_AXI_GP0_READ_CACHE_G,
+            M_AXI_GP1_READ_CACHE_G   => M_AXI_GP1_READ_CACHE_G,
+            READ_CACHE_LIFETIME_IN_CYCLES_G => READ_CACHE_LIFETIME_IN_CYCLES_G,
+            M_AXI_GP0_ADDR_MAP_G     => M_AXI_GP0_ADDR_MAP_G,
+            M_AXI_GP1_ADDR_MAP_G     => M_AXI_GP1_ADDR_MAP_G,
+            M_AXI_GP0_LITE_G         => M_AXI_GP0_LITE_G,
+            M_AXI_GP1_LITE_G         => M_AXI_GP1_LITE_G,
             M_AXI_GP0_ENABLE_G       => M_AXI_GP0_ENABLE_G,
             M_AXI_GP1_ENABLE_G       => M_AXI_GP1_ENABLE_G,
             S_AXI_GP0_ENABLE_G       => S_AXI_GP0_ENABLE_G,
@@ -478,7 +595,8 @@ begin
             S_AXI_HP0_ENABLE_G       => S_AXI_HP0_ENABLE_G,
             S_AXI_HP1_ENABLE_G       => S_AXI_HP1_ENABLE_G,
             S_AXI_HP2_ENABLE_G       => S_AXI_HP2_ENABLE_G,
-            S_AXI_HP3_ENABLE_G       => S_AXI_HP3_ENABLE_G)
+            S_AXI_HP3_ENABLE_G       => S_AXI_HP3_ENABLE_G,
+            S_AXI_ACP_ENABLE_G       => S_AXI_ACP_ENABLE_G)
         port map (
             -- Clocks
             fclk_clk0          => fclk_clk0,
@@ -825,10 +943,57 @@ begin
             s_axi_hp3_rresp    => s_axi_hp3_rresp,
             s_axi_hp3_rid      => s_axi_hp3_rid,
             s_axi_hp3_rlast    => s_axi_hp3_rlast,
+            -- S AXI ACP
+            s_axi_acp_aclk     => s_axi_acp_aclk,
+            s_axi_acp_aresetn  => s_axi_acp_aresetn,
+            s_axi_acp_awvalid  => s_axi_acp_awvalid,
+            s_axi_acp_awready  => s_axi_acp_awready,
+            s_axi_acp_awaddr   => s_axi_acp_awaddr,
+            s_axi_acp_awprot   => s_axi_acp_awprot,
+            s_axi_acp_awregion => (others => '0'),
+            s_axi_acp_awqos    => s_axi_acp_awqos,
+            s_axi_acp_awcache  => s_axi_acp_awcache,
+            s_axi_acp_awburst  => s_axi_acp_awburst,
+            s_axi_acp_awsize   => s_axi_acp_awsize,
+            s_axi_acp_awlen    => s_axi_acp_awlen,
+            s_axi_acp_awid     => s_axi_acp_awid,
+            s_axi_acp_awlock   => s_axi_acp_awlock,
+            -- s_axi_acp_wid => s_axi_acp_wid, -- Only in AXI3 on BFM (axi2tlm-bridge)
+            s_axi_acp_wvalid   => s_axi_acp_wvalid,
+            s_axi_acp_wready   => s_axi_acp_wready,
+            s_axi_acp_wdata    => s_axi_acp_wdata,
+            s_axi_acp_wstrb    => s_axi_acp_wstrb,
+            s_axi_acp_wlast    => s_axi_acp_wlast,
+            s_axi_acp_bvalid   => s_axi_acp_bvalid,
+            s_axi_acp_bready   => s_axi_acp_bready,
+            s_axi_acp_bresp    => s_axi_acp_bresp,
+            s_axi_acp_bid      => s_axi_acp_bid,
+            s_axi_acp_arvalid  => s_axi_acp_arvalid,
+            s_axi_acp_arready  => s_axi_acp_arready,
+            s_axi_acp_araddr   => s_axi_acp_araddr,
+            s_axi_acp_arprot   => s_axi_acp_arprot,
+            s_axi_acp_arregion => (others => '0'),
+            s_axi_acp_arqos    => s_axi_acp_arqos,
+            s_axi_acp_arcache  => s_axi_acp_arcache,
+            s_axi_acp_arburst  => s_axi_acp_arburst,
+            s_axi_acp_arsize   => s_axi_acp_arsize,
+            s_axi_acp_arlen    => s_axi_acp_arlen,
+            s_axi_acp_arid     => s_axi_acp_arid,
+            s_axi_acp_arlock   => s_axi_acp_arlock,
+            s_axi_acp_rvalid   => s_axi_acp_rvalid,
+            s_axi_acp_rready   => s_axi_acp_rready,
+            s_axi_acp_rdata    => s_axi_acp_rdata,
+            s_axi_acp_rresp    => s_axi_acp_rresp,
+            s_axi_acp_rid      => s_axi_acp_rid,
+            s_axi_acp_rlast    => s_axi_acp_rlast,
             -- IRQs
             irq_f2p            => irq_f2p,
             -- Resets
-            rst_o              => rst_o);
+            rst_o              => rst_o,
+            fclk_reset0_n      => fclk_reset0_n,
+            fclk_reset1_n      => fclk_reset1_n,
+            fclk_reset2_n      => fclk_reset2_n,
+            fclk_reset3_n      => fclk_reset3_n);
 
     assert irq_f2p'length <= 16 report "IRQ_F2P port cannot have more than 16 lines" severity warning;
 
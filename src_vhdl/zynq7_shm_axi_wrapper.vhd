@@ -0,0 +1,277 @@
+-------------------------------------------------------------------------------
+--
+-- Copyright (c) 2020 REDS, Rick Wertenbroek <rick.wertenbroek@heig-vd.ch>
+-- All rights reserved.
+--
+-- Redistribution and use in source and binary forms, with or without
+-- modification, are permitted provided that the following conditions are met:
+--
+-- 1. Redistributions of source code must retain the above copyright notice,
+-- this list of conditions and the following disclaimer.
+--
+-- 2. Redistributions in binary form must reproduce the above copyright notice,
+-- this list of conditions and the following disclaimer in the documentation
+-- and/or other materials provided with the distribution.
+--
+-- 3. Neither the name of the copyright holder nor the names of its
+-- contributors may be used to endorse or promote products derived from this
+-- software without specific prior written permission.
+--
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+-- POSSIBILITY OF SUCH DAMAGE.
+--
+-- File         : zynq7_shm_axi_wrapper.vhd
+-- Description  : Wrappers for the ends of an AXI shared memory link (SystemC
+--                entities, see src_sc/zynq7_shm_axi.h), they carry an AXI
+--                interface between two simulator processes.
+--
+-- Author       : Rick Wertenbroek
+-- Date         : 16.04.20
+-- Version      : 0.0
+--
+-- VHDL std     : 2008
+-- Dependencies :
+-------------------------------------------------------------------------------
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+entity zynq7_shm_slave_wrapper is
+    generic(
+        -- Shared file of the link and synchronization quantum, the same on
+        -- both ends
+        PATH_G          : string  := "";
+        QUANTUM_IN_NS_G : integer := 1000;
+        --
+        -- If these generics change value, the __SHM_AXI_*_WIDTH__ constants
+        -- must be given accordingly to the compilation of the SystemC files
+        --
+        ADDR_WIDTH_G    : integer := 32;
+        DATA_WIDTH_G    : integer := 64;
+        ID_WIDTH_G      : integer := 6;
+        AXLEN_WIDTH_G   : integer := 4;
+        AXLOCK_WIDTH_G  : integer := 2
+        );
+    port(
+        s_axi_aclk    : in  std_logic;
+        s_axi_aresetn : in  std_logic;
+        s_axi_awvalid : in  std_logic := '0';
+        s_axi_awready : out std_logic;
+        s_axi_awaddr  : in  std_logic_vector(ADDR_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_awprot  : in  std_logic_vector(2 downto 0) := (others => '0');
+        s_axi_awqos   : in  std_logic_vector(3 downto 0) := (others => '0');
+        s_axi_awcache : in  std_logic_vector(3 downto 0) := (others => '0');
+        s_axi_awburst : in  std_logic_vector(1 downto 0) := (others => '0');
+        s_axi_awsize  : in  std_logic_vector(2 downto 0) := (others => '0');
+        s_axi_awlen   : in  std_logic_vector(AXLEN_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_awid    : in  std_logic_vector(ID_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_awlock  : in  std_logic_vector(AXLOCK_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_wvalid  : in  std_logic := '0';
+        s_axi_wready  : out std_logic;
+        s_axi_wdata   : in  std_logic_vector(DATA_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_wstrb   : in  std_logic_vector(DATA_WIDTH_G/8-1 downto 0) := (others => '0');
+        s_axi_wlast   : in  std_logic := '0';
+        s_axi_bvalid  : out std_logic;
+        s_axi_bready  : in  std_logic := '0';
+        s_axi_bresp   : out std_logic_vector(1 downto 0);
+        s_axi_bid     : out std_logic_vector(ID_WIDTH_G-1 downto 0);
+        s_axi_arvalid : in  std_logic := '0';
+        s_axi_arready : out std_logic;
+        s_axi_araddr  : in  std_logic_vector(ADDR_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_arprot  : in  std_logic_vector(2 downto 0) := (others => '0');
+        s_axi_arqos   : in  std_logic_vector(3 downto 0) := (others => '0');
+        s_axi_arcache : in  std_logic_vector(3 downto 0) := (others => '0');
+        s_axi_arburst : in  std_logic_vector(1 downto 0) := (others => '0');
+        s_axi_arsize  : in  std_logic_vector(2 downto 0) := (others => '0');
+        s_axi_arlen   : in  std_logic_vector(AXLEN_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_arid    : in  std_logic_vector(ID_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_arlock  : in  std_logic_vector(AXLOCK_WIDTH_G-1 downto 0) := (others => '0');
+        s_axi_rvalid  : out std_logic;
+        s_axi_rready  : in  std_logic := '0';
+        s_axi_rdata   : out std_logic_vector(DATA_WIDTH_G-1 downto 0);
+        s_axi_rresp   : out std_logic_vector(1 downto 0);
+        s_axi_rid     : out std_logic_vector(ID_WIDTH_G-1 downto 0);
+        s_axi_rlast   : out std_logic
+        );
+end entity zynq7_shm_slave_wrapper;
+
+architecture struct of zynq7_shm_slave_wrapper is
+
+begin
+
+    -- This entity is a SystemC entity
+    zynq7_shm_slave_inst : entity work.zynq7_shm_slave
+        generic map (
+            PATH_G          => PATH_G,
+            QUANTUM_IN_NS_G => QUANTUM_IN_NS_G)
+        port map (
+            s_axi_aclk     => s_axi_aclk,
+            s_axi_aresetn  => s_axi_aresetn,
+            s_axi_awvalid  => s_axi_awvalid,
+            s_axi_awready  => s_axi_awready,
+            s_axi_awaddr   => s_axi_awaddr,
+            s_axi_awprot   => s_axi_awprot,
+            s_axi_awregion => (others => '0'),
+            s_axi_awqos    => s_axi_awqos,
+            s_axi_awcache  => s_axi_awcache,
+            s_axi_awburst  => s_axi_awburst,
+            s_axi_awsize   => s_axi_awsize,
+            s_axi_awlen    => s_axi_awlen,
+            s_axi_awid     => s_axi_awid,
+            s_axi_awlock   => s_axi_awlock,
+            s_axi_wvalid   => s_axi_wvalid,
+            s_axi_wready   => s_axi_wready,
+            s_axi_wdata    => s_axi_wdata,
+            s_axi_wstrb    => s_axi_wstrb,
+            s_axi_wlast    => s_axi_wlast,
+            s_axi_bvalid   => s_axi_bvalid,
+            s_axi_bready   => s_axi_bready,
+            s_axi_bresp    => s_axi_bresp,
+            s_axi_bid      => s_axi_bid,
+            s_axi_arvalid  => s_axi_arvalid,
+            s_axi_arready  => s_axi_arready,
+            s_axi_araddr   => s_axi_araddr,
+            s_axi_arprot   => s_axi_arprot,
+            s_axi_arregion => (others => '0'),
+            s_axi_arqos    => s_axi_arqos,
+            s_axi_arcache  => s_axi_arcache,
+            s_axi_arburst  => s_axi_arburst,
+            s_axi_arsize   => s_axi_arsize,
+            s_axi_arlen    => s_axi_arlen,
+            s_axi_arid     => s_axi_arid,
+            s_axi_arlock   => s_axi_arlock,
+            s_axi_rvalid   => s_axi_rvalid,
+            s_axi_rready   => s_axi_rready,
+            s_axi_rdata    => s_axi_rdata,
+            s_axi_rresp    => s_axi_rresp,
+            s_axi_rid      => s_axi_rid,
+            s_axi_rlast    => s_axi_rlast);
+
+end architecture struct;
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+entity zynq7_shm_master_wrapper is
+    generic(
+        -- Shared file of the link and synchronization quantum, the same on
+        -- both ends
+        PATH_G          : string  := "";
+        QUANTUM_IN_NS_G : integer := 1000;
+        --
+        -- If these generics change value, the __SHM_AXI_*_WIDTH__ constants
+        -- must be given accordingly to the compilation of the SystemC files
+        --
+        ADDR_WIDTH_G    : integer := 32;
+        DATA_WIDTH_G    : integer := 64;
+        ID_WIDTH_G      : integer := 6;
+        AXLEN_WIDTH_G   : integer := 4;
+        AXLOCK_WIDTH_G  : integer := 2
+        );
+    port(
+        m_axi_aclk    : in  std_logic;
+        m_axi_aresetn : in  std_logic;
+        m_axi_awvalid : out std_logic;
+        m_axi_awready : in  std_logic := '0';
+        m_axi_awaddr  : out std_logic_vector(ADDR_WIDTH_G-1 downto 0);
+        m_axi_awprot  : out std_logic_vector(2 downto 0);
+        m_axi_awqos   : out std_logic_vector(3 downto 0);
+        m_axi_awcache : out std_logic_vector(3 downto 0);
+        m_axi_awburst : out std_logic_vector(1 downto 0);
+        m_axi_awsize  : out std_logic_vector(2 downto 0);
+        m_axi_awlen   : out std_logic_vector(AXLEN_WIDTH_G-1 downto 0);
+        m_axi_awid    : out std_logic_vector(ID_WIDTH_G-1 downto 0);
+        m_axi_awlock  : out std_logic_vector(AXLOCK_WIDTH_G-1 downto 0);
+        m_axi_wvalid  : out std_logic;
+        m_axi_wready  : in  std_logic := '0';
+        m_axi_wdata   : out std_logic_vector(DATA_WIDTH_G-1 downto 0);
+        m_axi_wstrb   : out std_logic_vector(DATA_WIDTH_G/8-1 downto 0);
+        m_axi_wlast   : out std_logic;
+        m_axi_bvalid  : in  std_logic := '0';
+        m_axi_bready  : out std_logic;
+        m_axi_bresp   : in  std_logic_vector(1 downto 0) := (others => '0');
+        m_axi_bid     : in  std_logic_vector(ID_WIDTH_G-1 downto 0) := (others => '0');
+        m_axi_arvalid : out std_logic;
+        m_axi_arready : in  std_logic := '0';
+        m_axi_araddr  : out std_logic_vector(ADDR_WIDTH_G-1 downto 0);
+        m_axi_arprot  : out std_logic_vector(2 downto 0);
+        m_axi_arqos   : out std_logic_vector(3 downto 0);
+        m_axi_arcache : out std_logic_vector(3 downto 0);
+        m_axi_arburst : out std_logic_vector(1 downto 0);
+        m_axi_arsize  : out std_logic_vector(2 downto 0);
+        m_axi_arlen   : out std_logic_vector(AXLEN_WIDTH_G-1 downto 0);
+        m_axi_arid    : out std_logic_vector(ID_WIDTH_G-1 downto 0);
+        m_axi_arlock  : out std_logic_vector(AXLOCK_WIDTH_G-1 downto 0);
+        m_axi_rvalid  : in  std_logic := '0';
+        m_axi_rready  : out std_logic;
+        m_axi_rdata   : in  std_logic_vector(DATA_WIDTH_G-1 downto 0) := (others => '0');
+        m_axi_rresp   : in  std_logic_vector(1 downto 0) := (others => '0');
+        m_axi_rid     : in  std_logic_vector(ID_WIDTH_G-1 downto 0) := (others => '0');
+        m_axi_rlast   : in  std_logic := '0'
+        );
+end entity zynq7_shm_master_wrapper;
+
+architecture struct of zynq7_shm_master_wrapper is
+
+begin
+
+    -- This entity is a SystemC entity
+    zynq7_shm_master_inst : entity work.zynq7_shm_master
+        generic map (
+            PATH_G          => PATH_G,
+            QUANTUM_IN_NS_G => QUANTUM_IN_NS_G)
+        port map (
+            m_axi_aclk     => m_axi_aclk,
+            m_axi_aresetn  => m_axi_aresetn,
+            m_axi_awvalid  => m_axi_awvalid,
+            m_axi_awready  => m_axi_awready,
+            m_axi_awaddr   => m_axi_awaddr,
+            m_axi_awprot   => m_axi_awprot,
+            m_axi_awregion => open,
+            m_axi_awqos    => m_axi_awqos,
+            m_axi_awcache  => m_axi_awcache,
+            m_axi_awburst  => m_axi_awburst,
+            m_axi_awsize   => m_axi_awsize,
+            m_axi_awlen    => m_axi_awlen,
+            m_axi_awid     => m_axi_awid,
+            m_axi_awlock   => m_axi_awlock,
+            m_axi_wvalid   => m_axi_wvalid,
+            m_axi_wready   => m_axi_wready,
+            m_axi_wdata    => m_axi_wdata,
+            m_axi_wstrb    => m_axi_wstrb,
+            m_axi_wlast    => m_axi_wlast,
+            m_axi_bvalid   => m_axi_bvalid,
+            m_axi_bready   => m_axi_bready,
+            m_axi_bresp    => m_axi_bresp,
+            m_axi_bid      => m_axi_bid,
+            m_axi_arvalid  => m_axi_arvalid,
+            m_axi_arready  => m_axi_arready,
+            m_axi_araddr   => m_axi_araddr,
+            m_axi_arprot   => m_axi_arprot,
+            m_axi_arregion => open,
+            m_axi_arqos    => m_axi_arqos,
+            m_axi_arcache  => m_axi_arcache,
+            m_axi_arburst  => m_axi_arburst,
+            m_axi_arsize   => m_axi_arsize,
+            m_axi_arlen    => m_axi_arlen,
+            m_axi_arid     => m_axi_arid,
+            m_axi_arlock   => m_axi_arlock,
+            m_axi_rvalid   => m_axi_rvalid,
+            m_axi_rready   => m_axi_rready,
+            m_axi_rdata    => m_axi_rdata,
+            m_axi_rresp    => m_axi_rresp,
+            m_axi_rid      => m_axi_rid,
+            m_axi_rlast    => m_axi_rlast);
+
+end architecture struct;